@@ -5,10 +5,17 @@
  * characteristics, common operations, and best practices.
  */
 
-#include <iostream>  // For std::cout, std::endl, std::cin
-#include <string>    // For std::string class
-#include <cstring>   // For C-style string functions (strlen, strcpy, etc.)
-#include <limits>    // For std::numeric_limits (used with std::cin.ignore)
+#include <iostream>          // For std::cout, std::endl, std::cin
+#include <string>            // For std::string class
+#include <cstring>           // For C-style string functions (strlen, strcpy, etc.)
+#include <limits>            // For std::numeric_limits (used with std::cin.ignore)
+#include <chrono>            // For timing the string-building benchmark
+#include <random>            // For the random edit positions in the benchmark
+#include <vector>            // For the strcat destination buffer in the benchmark
+#include <algorithm>         // For std::count and std::reverse (kernel benchmark)
+#include <string_view>       // For the --benchmarks flag
+#include "string-builder.h"  // For StringBuilder and Rope (Section 7)
+#include "string-kernels.h"  // For the vectorized string kernels (Section 8)
 
 // =========================================================================
 // 1. Introduction: What are Strings in C++?
@@ -90,6 +97,8 @@ void demonstrate_strcat()
     char str_part2[] = " World!";
     std::strcat(str_part1, str_part2);
     std::cout << "2.2.3 Concatenated string: " << str_part1 << std::endl;  // Output: Hello World!
+    // strcat walks the whole destination to find its end on every call: appending n pieces this
+    // way is O(n^2). Section 7 shows the linear alternatives.
 }
 
 // Example 2.2.4: strcmp (string compare)
@@ -378,14 +387,233 @@ void demonstrate_raw_string_literals()
  * 6.6. **Understand Null Termination:**
  * -   Always remember that C-style strings are null-terminated. `std::string` handles this
  * internally.
+ *
+ * 6.7. **Build Long Strings with One Growing Buffer:**
+ * -   Repeated `strcat` or "allocate len1 + len2 + 1 and copy both" concatenation is quadratic.
+ * Append into one buffer that grows geometrically instead (Section 7).
+ */
+
+// =========================================================================
+// 7. Building Strings Incrementally: StringBuilder and Rope
+// =========================================================================
+
+/**
+ * **7. Building Strings Incrementally:**
+ * -   `StringBuilder` (string-builder.h) appends into one buffer whose capacity doubles,
+ * so n appended bytes cost O(n) overall, and it stays null-terminated so `c_str()` is free.
+ * -   `Rope` keeps a large document as a tree of shared chunks: inserting or erasing in
+ * the middle copies a few tree nodes instead of moving the rest of the text.
+ * `forEachChunk()` visits the text without copying it; `str()` flattens it on demand.
+ */
+
+// Example 7.1: StringBuilder
+void demonstrate_string_builder()
+{
+    StringBuilder sb;
+    sb << "Order #" << 1042 << ": " << 3 << " items, total " << 59.97 << ", paid " << true << '\n';
+    sb.append("Shipped to: ").append("Mumbai");
+    std::cout << "7.1 Built string: " << sb.c_str() << std::endl;
+    std::cout << "7.1 Length: " << sb.size() << ", capacity: " << sb.capacity() << std::endl;
+
+    // Appending a builder to itself: its view points into the buffer that grows
+    StringBuilder doubled;
+    doubled << "abc";
+    std::string expected = "abc";
+    for (int i = 0; i < 6; i++)
+    {
+        doubled.append(doubled.view());
+        expected += expected;
+    }
+    std::cout << "7.1 Self-append: " << doubled.size() << " chars, correct: "
+              << (doubled.view() == expected) << std::endl;
+}
+
+// Example 7.2: Rope edits, chunk iteration and lazy flattening
+void demonstrate_rope()
+{
+    Rope doc("The quick fox jumps over the dog.");
+    doc.insert(10, "brown ");
+    doc.insert(doc.str().find("dog"), "lazy ");
+    doc.erase(0, 4);  // Drop "The "
+    std::cout << "7.2 Rope text: " << doc.str() << std::endl;
+
+    Rope title = doc.substr(0, 15);  // Shares the chunks, no copy of the characters
+    std::cout << "7.2 Substring: " << title.str() << " (" << title.chunkCount() << " chunks)"
+              << std::endl;
+
+    size_t chunks = 0;
+    doc.forEachChunk([&chunks](std::string_view) { chunks++; });
+    std::cout << "7.2 Document: " << doc.size() << " chars in " << chunks << " chunks" << std::endl;
+}
+
+// Example 7.3: Chained strcat vs std::string vs StringBuilder, and middle edits in a large text
+void benchmark_string_building()
+{
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point start)
+    { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    const int pieces = 40000;
+    const char piece[] = "item-0042,";  // 10 characters
+    std::vector<char> buffer(pieces * 10 + 1, '\0');
+    auto start = Clock::now();
+    for (int i = 0; i < pieces; i++) std::strcat(buffer.data(), piece);
+    double strcat_ms = ms_since(start);
+
+    start = Clock::now();
+    std::string s;
+    for (int i = 0; i < pieces; i++) s += piece;
+    double string_ms = ms_since(start);
+
+    start = Clock::now();
+    StringBuilder sb;
+    for (int i = 0; i < pieces; i++) sb.append(piece);
+    double builder_ms = ms_since(start);
+    std::cout << "7.3 " << pieces << " appends: strcat " << strcat_ms << " ms, std::string "
+              << string_ms << " ms, StringBuilder " << builder_ms << " ms (same: "
+              << (sb.view() == buffer.data() && s == sb.view()) << ")" << std::endl;
+
+    // 2000 inserts and erases at random positions of a 32 MB document
+    const std::string text(32 << 20, 'x');
+    std::mt19937 rng(7);
+    std::vector<size_t> positions(2000);
+    for (auto& p : positions) p = rng() % text.size();
+
+    std::string flat = text;
+    start = Clock::now();
+    for (size_t p : positions)
+    {
+        flat.insert(p, "EDIT");
+        flat.erase(p / 2, 3);
+    }
+    double flat_ms = ms_since(start);
+
+    Rope rope(text);
+    start = Clock::now();
+    for (size_t p : positions)
+    {
+        rope.insert(p, "EDIT");
+        rope.erase(p / 2, 3);
+    }
+    double rope_ms = ms_since(start);
+    start = Clock::now();
+    bool same = rope.str() == flat;
+    std::cout << "7.3 2000 edits of 32 MB: std::string " << flat_ms << " ms, Rope " << rope_ms
+              << " ms (+" << ms_since(start) << " ms to flatten and compare, same: " << same
+              << ", depth " << rope.depth() << ")" << std::endl;
+}
+
+// =========================================================================
+// 8. Vectorized String Kernels
+// =========================================================================
+
+/**
+ * **8. Vectorized String Kernels:**
+ * -   The loops behind `strlen`, `strcmp` and `find` look at one character per step.
+ * `string-kernels.h` does the same work 16 (SSE2) or 32 (AVX2) bytes per instruction and
+ * picks the widest version the CPU supports at runtime.
+ * -   Substring search compares the first and the last character of the needle against a whole
+ * block of positions at once, and only checks the full needle where both match.
+ * -   The standard library (`std::strlen`, `std::memcmp`, `std::string_view::find`) is often
+ * vectorized already; the benchmark prints it next to each kernel set for comparison.
  */
 
+// Example 8.1: The kernels give the same answers as the character-by-character versions
+void demonstrate_string_kernels()
+{
+    const char text[] = "The quick brown fox jumps over the lazy dog.";
+    std::cout << "8.1 Kernels in use: " << string_kernels::bestKernels().name << std::endl;
+    std::cout << "8.1 length: " << string_kernels::length(text) << " (strlen "
+              << std::strlen(text) << ")" << std::endl;
+    std::cout << "8.1 find(\"fox\"): " << string_kernels::find(text, "fox") << std::endl;
+    std::cout << "8.1 count('o'): " << string_kernels::count(text, 'o') << std::endl;
+    std::cout << "8.1 compare(\"apple\", \"banana\"): "
+              << string_kernels::compare("apple", "banana") << ", equal(\"apple\", \"apple\"): "
+              << string_kernels::equal("apple", "apple") << std::endl;
+
+    char word[] = "Programming";
+    string_kernels::reverse(word, std::strlen(word));
+    std::cout << "8.1 reverse: " << word << std::endl;
+}
+
+// Example 8.2: GB/s of every kernel set on a 64 MB text, checked against the standard library
+void benchmark_string_kernels()
+{
+    using Clock = std::chrono::steady_clock;
+    const size_t n = size_t(64) << 20;
+    std::mt19937 rng(11);
+    std::string text(n, ' ');
+    for (char& c : text) c = static_cast<char>('a' + rng() % 26);
+    const std::string needle = "kernelsneedle";
+    text.replace(n - needle.size() - 1, needle.size(), needle);
+    std::string copy = text;
+    copy[n - 2] = '!';  // Differs only near the end, so the whole text is compared
+
+    // Best of three runs of f, in GB/s over the n bytes
+    auto rate = [n](auto&& f)
+    {
+        double best = 0;
+        for (int run = 0; run < 3; run++)
+        {
+            auto start = Clock::now();
+            f();
+            double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+            best = std::max(best, n / seconds / 1e9);
+        }
+        return best;
+    };
+    auto print = [](const char* name, double len, double cmp, double find, double count,
+                    double rev, bool ok)
+    {
+        std::cout << "8.2 " << name << ": length " << len << ", mismatch " << cmp << ", find "
+                  << find << ", count " << count << ", reverse " << rev << " GB/s"
+                  << (ok ? "" : "  MISMATCH") << std::endl;
+    };
+
+    const size_t expectedFind = text.find(needle);
+    const size_t expectedCount = static_cast<size_t>(std::count(text.begin(), text.end(), 'e'));
+    std::string reversed(text.rbegin(), text.rend());
+    size_t sink = 0;
+
+    std::string work = text;
+    print("std", rate([&] { sink += std::strlen(text.c_str()); }),
+          rate([&] { sink += std::memcmp(text.data(), copy.data(), n) != 0; }),
+          rate([&] { sink += std::string_view(text).find(needle); }),
+          rate([&] { sink += std::count(text.begin(), text.end(), 'e'); }),
+          rate([&] { std::reverse(work.begin(), work.end()); }), true);
+
+    string_kernels::Kernels all[4];
+    int count = string_kernels::availableKernels(all);
+    for (int k = 0; k < count; k++)
+    {
+        const string_kernels::Kernels& kernels = all[k];
+        bool ok = kernels.length(text.c_str()) == n &&
+                  kernels.mismatch(text.data(), copy.data(), n) == n - 2 &&
+                  kernels.find(text.data(), n, needle.data(), needle.size()) == expectedFind &&
+                  kernels.count(text.data(), n, 'e') == expectedCount;
+        work = text;
+        kernels.reverse(&work[0], n);
+        ok = ok && work == reversed;
+        print(kernels.name, rate([&] { sink += kernels.length(text.c_str()); }),
+              rate([&] { sink += kernels.mismatch(text.data(), copy.data(), n); }),
+              rate([&] { sink += kernels.find(text.data(), n, needle.data(), needle.size()); }),
+              rate([&] { sink += kernels.count(text.data(), n, 'e'); }),
+              rate([&] { kernels.reverse(&work[0], n); }), ok);
+    }
+    if (sink == 0) std::cout << std::endl;  // Keeps the timed calls from being optimized away
+}
+
 // =========================================================================
 // Main Function (Entry Point of the Program)
 // =========================================================================
 
-int main()
+// `--benchmarks` also runs the Section 7 and 8 benchmarks (32-64 MB buffers, a few seconds)
+int main(int argc, char** argv)
 {
+    bool benchmarks = false;
+    for (int i = 1; i < argc; i++)
+        if (std::string_view(argv[i]) == "--benchmarks") benchmarks = true;
+
     std::cout << "--- Section 2: C-style Strings ---" << std::endl;
     demonstrate_strlen();
     demonstrate_strcpy();
@@ -405,6 +633,15 @@ int main()
     std::cout << "\n--- Section 5: Raw String Literals ---" << std::endl;
     demonstrate_raw_string_literals();
 
+    std::cout << "\n--- Section 7: Building Strings ---" << std::endl;
+    demonstrate_string_builder();
+    demonstrate_rope();
+    if (benchmarks) benchmark_string_building();
+
+    std::cout << "\n--- Section 8: Vectorized String Kernels ---" << std::endl;
+    demonstrate_string_kernels();
+    if (benchmarks) benchmark_string_kernels();
+
     std::cout << "\n--- End of Tutorial ---" << std::endl;
 
     return 0;
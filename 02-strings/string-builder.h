@@ -0,0 +1,404 @@
+/**
+ * File: string-builder.h
+ * Description: Linear-time string building. StringBuilder appends into one
+ * geometrically growing buffer (no strcat rescans, no copy of everything per
+ * append as in q10 of 11-dsa-sheet/02-linked-list/assessment.cpp). Rope holds
+ * large, edited documents as a tree of shared chunks, so insertions, erasures
+ * and substrings copy almost nothing and the flat string is built only when
+ * asked for.
+ */
+
+#ifndef STRING_BUILDER_H
+#define STRING_BUILDER_H
+
+#include <algorithm>     // For std::max
+#include <charconv>      // For std::to_chars
+#include <cstddef>       // For std::size_t
+#include <cstring>       // For std::memcpy
+#include <memory>        // For std::unique_ptr, std::shared_ptr
+#include <stdexcept>     // For std::out_of_range
+#include <string>        // For std::string
+#include <string_view>   // For std::string_view
+#include <type_traits>   // For std::is_arithmetic
+#include <utility>       // For std::pair
+#include <vector>        // For std::vector
+
+/**
+ * Append-only string buffer. Capacity doubles when it runs out, so n appended
+ * bytes cost O(n) in total. The contents are always NUL-terminated: c_str()
+ * is free and never rescans, unlike strcat finding the end of its destination.
+ */
+class StringBuilder
+{
+   private:
+    std::unique_ptr<char[]> buffer;
+    std::size_t length = 0;
+    std::size_t room = 0;  // Usable bytes, not counting the terminator
+
+    // Returns the old buffer, so a caller copying from it can free it afterwards
+    std::unique_ptr<char[]> grow(std::size_t needed)
+    {
+        std::size_t next = std::max({needed, 2 * room, std::size_t(63)});
+        std::unique_ptr<char[]> bigger(new char[next + 1]);
+        if (length > 0) std::memcpy(bigger.get(), buffer.get(), length);
+        bigger[length] = '\0';
+        buffer.swap(bigger);
+        room = next;
+        return bigger;
+    }
+
+   public:
+    StringBuilder() = default;
+    explicit StringBuilder(std::size_t capacity) { reserve(capacity); }
+
+    void reserve(std::size_t capacity)
+    {
+        if (capacity > room) grow(capacity);
+    }
+
+    // text may be a view of this builder (sb.append(sb.view())); the old buffer it
+    // points into is kept until the copy is done
+    StringBuilder& append(std::string_view text)
+    {
+        std::unique_ptr<char[]> old;
+        if (length + text.size() > room) old = grow(length + text.size());
+        if (!text.empty()) std::memcpy(buffer.get() + length, text.data(), text.size());
+        length += text.size();
+        buffer[length] = '\0';
+        return *this;
+    }
+
+    StringBuilder& append(char c)
+    {
+        if (length + 1 > room) grow(length + 1);
+        buffer[length++] = c;
+        buffer[length] = '\0';
+        return *this;
+    }
+
+    // Decimal text of an integer or floating-point value, without a stream or locale.
+    // bool is written as 1 or 0, like std::ostream without std::boolalpha.
+    template <typename T>
+    StringBuilder& appendNumber(T value)
+    {
+        static_assert(std::is_arithmetic<T>::value, "appendNumber takes a number");
+        if constexpr (std::is_same<T, bool>::value)
+            return append(value ? '1' : '0');
+        else
+        {
+            char digits[64];
+            auto result = std::to_chars(digits, digits + sizeof(digits), value);
+            return append(std::string_view(digits, static_cast<std::size_t>(result.ptr - digits)));
+        }
+    }
+
+    // Strings and chars are appended as text, other arithmetic values as numbers
+    template <typename T>
+    StringBuilder& operator<<(const T& value)
+    {
+        if constexpr (std::is_same<T, char>::value)
+            return append(value);
+        else if constexpr (std::is_arithmetic<T>::value)
+            return appendNumber(value);
+        else
+            return append(std::string_view(value));
+    }
+
+    void clear()
+    {
+        length = 0;
+        if (buffer) buffer[0] = '\0';
+    }
+
+    std::size_t size() const { return length; }
+    std::size_t capacity() const { return room; }
+    bool empty() const { return length == 0; }
+
+    std::string_view view() const { return std::string_view(buffer.get(), length); }
+    const char* c_str() const { return buffer ? buffer.get() : ""; }
+    std::string str() const { return std::string(view()); }
+};
+
+/**
+ * Rope (cord): text as a balanced binary tree whose leaves are slices of
+ * shared, immutable buffers. Copies share the whole tree; substr() and the
+ * two halves of a split share the leaves' buffers, so editing a large
+ * document copies O(log n) nodes instead of moving the tail of the text.
+ *
+ * - append() collects text in a small tail buffer and moves it into the
+ *   tree one leaf (up to kLeafSize bytes) at a time.
+ * - forEachChunk() visits the text as string_views into the leaves, with
+ *   no copy; str() builds the flat string on first use and keeps it until
+ *   the next edit.
+ * - Every concatenation is an AVL-style join: the two children of any node
+ *   differ in depth by at most 1, so depth stays under 1.44 * log2(leaves)
+ *   and append, insert, erase and substr each create O(log n) nodes.
+ * Not safe to use one Rope from several threads; separate copies are fine.
+ */
+class Rope
+{
+   public:
+    static constexpr std::size_t kLeafSize = 4096;
+
+   private:
+    struct Node;
+    using NodePtr = std::shared_ptr<const Node>;
+
+    struct Node
+    {
+        std::size_t length = 0;
+        std::size_t leaves = 1;
+        int depth = 0;
+        // Leaf: text[offset, offset + length)
+        std::shared_ptr<const std::string> text;
+        std::size_t offset = 0;
+        // Inner node
+        NodePtr left, right;
+
+        bool isLeaf() const { return !left; }
+    };
+
+    NodePtr root;
+    std::string tail;  // Appended text not in the tree yet
+    mutable std::string flat;
+    mutable bool flatValid = true;
+
+    static NodePtr makeLeaf(std::shared_ptr<const std::string> text, std::size_t offset,
+                            std::size_t length)
+    {
+        if (length == 0) return nullptr;
+        auto node = std::make_shared<Node>();
+        node->length = length;
+        node->text = std::move(text);
+        node->offset = offset;
+        return node;
+    }
+
+    static NodePtr makeLeaf(std::string_view text)
+    {
+        auto owned = std::make_shared<const std::string>(text);
+        return makeLeaf(owned, 0, owned->size());
+    }
+
+    static std::string_view leafText(const Node& leaf)
+    {
+        return std::string_view(*leaf.text).substr(leaf.offset, leaf.length);
+    }
+
+    static NodePtr makeInner(NodePtr left, NodePtr right)
+    {
+        auto node = std::make_shared<Node>();
+        node->length = left->length + right->length;
+        node->leaves = left->leaves + right->leaves;
+        node->depth = std::max(left->depth, right->depth) + 1;
+        node->left = std::move(left);
+        node->right = std::move(right);
+        return node;
+    }
+
+    // Inner node over subtrees whose depths differ by at most 2, rotated (as in an
+    // AVL tree) so the two sides of every new node differ by at most 1
+    static NodePtr balanced(NodePtr left, NodePtr right)
+    {
+        if (left->depth > right->depth + 1)
+        {
+            if (left->left->depth >= left->right->depth)
+                return makeInner(left->left, makeInner(left->right, std::move(right)));
+            const NodePtr& middle = left->right;
+            return makeInner(makeInner(left->left, middle->left),
+                             makeInner(middle->right, std::move(right)));
+        }
+        if (right->depth > left->depth + 1)
+        {
+            if (right->right->depth >= right->left->depth)
+                return makeInner(makeInner(std::move(left), right->left), right->right);
+            const NodePtr& middle = right->left;
+            return makeInner(makeInner(std::move(left), middle->left),
+                             makeInner(middle->right, right->right));
+        }
+        return makeInner(std::move(left), std::move(right));
+    }
+
+    // Concatenation that keeps the tree height-balanced: the shallower tree is joined in
+    // along the taller one's spine, O(depth difference) new nodes
+    static NodePtr join(NodePtr left, NodePtr right)
+    {
+        if (!left) return right;
+        if (!right) return left;
+        // Two short leaves become one, so many small edits do not leave crumbs
+        if (left->isLeaf() && right->isLeaf() && left->length + right->length <= kLeafSize / 4)
+        {
+            std::string merged(leafText(*left));
+            merged.append(leafText(*right));
+            return makeLeaf(merged);
+        }
+        if (left->depth > right->depth + 1) return balanced(left->left, join(left->right, right));
+        if (right->depth > left->depth + 1)
+            return balanced(join(left, right->left), right->right);
+        return makeInner(std::move(left), std::move(right));
+    }
+
+    static std::pair<NodePtr, NodePtr> split(const NodePtr& node, std::size_t pos)
+    {
+        if (!node) return {nullptr, nullptr};
+        if (pos == 0) return {nullptr, node};
+        if (pos >= node->length) return {node, nullptr};
+        if (node->isLeaf())
+            return {makeLeaf(node->text, node->offset, pos),
+                    makeLeaf(node->text, node->offset + pos, node->length - pos)};
+        if (pos <= node->left->length)
+        {
+            auto [first, second] = split(node->left, pos);
+            return {first, join(second, node->right)};
+        }
+        auto [first, second] = split(node->right, pos - node->left->length);
+        return {join(node->left, first), second};
+    }
+
+    void flushTail()
+    {
+        if (tail.empty()) return;
+        root = join(root, makeLeaf(tail));
+        tail.clear();
+    }
+
+    template <typename F>
+    static void visit(const NodePtr& node, F& f)
+    {
+        if (!node) return;
+        if (node->isLeaf())
+        {
+            f(leafText(*node));
+            return;
+        }
+        visit(node->left, f);
+        visit(node->right, f);
+    }
+
+   public:
+    Rope() = default;
+    explicit Rope(std::string_view text) { append(text); }
+
+    Rope& append(std::string_view text)
+    {
+        flatValid = false;
+        if (tail.size() + text.size() <= kLeafSize)
+        {
+            tail.append(text);
+            return *this;
+        }
+        flushTail();
+        for (std::size_t at = 0; at < text.size(); at += kLeafSize)
+        {
+            std::string_view piece = text.substr(at, kLeafSize);
+            if (piece.size() < kLeafSize)
+                tail.assign(piece);  // The last partial leaf keeps collecting appends
+            else
+                root = join(root, makeLeaf(piece));
+        }
+        return *this;
+    }
+
+    Rope& operator+=(std::string_view text) { return append(text); }
+
+    // Appends another rope, sharing its chunks
+    Rope& append(const Rope& other)
+    {
+        flushTail();
+        root = join(root, other.root);
+        tail = other.tail;
+        flatValid = false;
+        return *this;
+    }
+
+    // Inserts text before position pos; throws std::out_of_range past the end
+    void insert(std::size_t pos, std::string_view text)
+    {
+        if (pos > size()) throw std::out_of_range("Rope::insert position past the end");
+        if (pos == size())
+        {
+            append(text);
+            return;
+        }
+        flushTail();
+        auto [before, after] = split(root, pos);
+        NodePtr middle;
+        for (std::size_t at = 0; at < text.size(); at += kLeafSize)
+            middle = join(middle, makeLeaf(text.substr(at, kLeafSize)));
+        root = join(join(before, middle), after);
+        flatValid = false;
+    }
+
+    // Removes up to count characters starting at pos
+    void erase(std::size_t pos, std::size_t count)
+    {
+        if (pos > size()) throw std::out_of_range("Rope::erase position past the end");
+        flushTail();
+        count = std::min(count, size() - pos);
+        auto [before, rest] = split(root, pos);
+        auto [removed, after] = split(rest, count);
+        root = join(before, after);
+        flatValid = false;
+    }
+
+    // Characters [pos, pos + count) as a new rope sharing this one's chunks
+    Rope substr(std::size_t pos, std::size_t count) const
+    {
+        if (pos > size()) throw std::out_of_range("Rope::substr position past the end");
+        count = std::min(count, size() - pos);
+        // Built from the tree alone (copying *this would copy the flat cache too); only the
+        // unflushed tail, under kLeafSize bytes, is copied into a leaf
+        NodePtr whole = tail.empty() ? root : join(root, makeLeaf(tail));
+        Rope part;
+        part.root = split(split(whole, pos).second, count).first;
+        part.flatValid = count == 0;
+        return part;
+    }
+
+    char at(std::size_t pos) const
+    {
+        if (pos >= size()) throw std::out_of_range("Rope::at position past the end");
+        std::size_t treeLength = root ? root->length : 0;
+        if (pos >= treeLength) return tail[pos - treeLength];
+        const Node* node = root.get();
+        while (!node->isLeaf())
+        {
+            if (pos < node->left->length)
+                node = node->left.get();
+            else
+            {
+                pos -= node->left->length;
+                node = node->right.get();
+            }
+        }
+        return (*node->text)[node->offset + pos];
+    }
+
+    // Calls f(string_view) for every chunk of the text, in order, without copying it
+    template <typename F>
+    void forEachChunk(F&& f) const
+    {
+        visit(root, f);
+        if (!tail.empty()) f(std::string_view(tail));
+    }
+
+    // The whole text as one string, built on the first call after an edit
+    const std::string& str() const
+    {
+        if (!flatValid)
+        {
+            flat.clear();
+            flat.reserve(size());
+            forEachChunk([this](std::string_view chunk) { flat.append(chunk); });
+            flatValid = true;
+        }
+        return flat;
+    }
+
+    std::size_t size() const { return (root ? root->length : 0) + tail.size(); }
+    bool empty() const { return size() == 0; }
+    std::size_t chunkCount() const { return (root ? root->leaves : 0) + (tail.empty() ? 0 : 1); }
+    int depth() const { return root ? root->depth : 0; }
+};
+
+#endif
@@ -0,0 +1,390 @@
+/**
+ * File: string-kernels.h
+ * Description: Vectorized versions of the byte-at-a-time string loops in
+ * 01-string.cpp and 11-dsa-sheet/02-linked-list/assessment.cpp: length of a
+ * C string, first mismatch (equality and ordering), substring search,
+ * counting one character and in-place reverse. Each kernel exists as a
+ * scalar, SSE2 and AVX2 version; the best one this CPU runs is picked once
+ * at runtime (GCC/Clang target attributes, no special compiler flags needed).
+ */
+
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uintptr_t
+#include <cstring>      // For std::memcmp
+#include <string_view>  // For std::string_view
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define STRING_KERNELS_X86 1
+#endif
+
+// length() reads whole aligned blocks around the string, which the address sanitizer reports
+#if defined(__SANITIZE_ADDRESS__)
+#define STRING_KERNELS_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define STRING_KERNELS_NO_ASAN
+#endif
+
+namespace string_kernels
+{
+
+constexpr std::size_t npos = std::string_view::npos;
+
+// ---- Scalar: the reference every vector kernel must match ----
+
+inline std::size_t lengthScalar(const char* s)
+{
+    const char* end = s;
+    while (*end) end++;
+    return static_cast<std::size_t>(end - s);
+}
+
+// Index of the first position where a and b differ, or n when the first n bytes match
+inline std::size_t mismatchScalar(const char* a, const char* b, std::size_t n)
+{
+    std::size_t i = 0;
+    while (i < n && a[i] == b[i]) i++;
+    return i;
+}
+
+// Position of the first needle[0, m) in haystack[from, n), or npos; needs 2 <= m <= n
+inline std::size_t findFrom(const char* haystack, std::size_t n, std::size_t from,
+                            const char* needle, std::size_t m)
+{
+    for (std::size_t i = from; i + m <= n; i++)
+        if (haystack[i] == needle[0] && haystack[i + m - 1] == needle[m - 1] &&
+            std::memcmp(haystack + i + 1, needle + 1, m - 2) == 0)
+            return i;
+    return npos;
+}
+
+inline std::size_t findScalar(const char* haystack, std::size_t n, const char* needle,
+                              std::size_t m)
+{
+    if (m == 0) return 0;
+    if (m > n) return npos;
+    if (m == 1)
+    {
+        for (std::size_t i = 0; i < n; i++)
+            if (haystack[i] == needle[0]) return i;
+        return npos;
+    }
+    return findFrom(haystack, n, 0, needle, m);
+}
+
+inline std::size_t countScalar(const char* s, std::size_t n, char c)
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; i++) count += s[i] == c;
+    return count;
+}
+
+inline void reverseScalar(char* s, std::size_t n)
+{
+    if (n < 2) return;
+    char* start = s;
+    char* end = s + n - 1;
+    while (start < end)
+    {
+        char temp = *start;
+        *start++ = *end;
+        *end-- = temp;
+    }
+}
+
+#if defined(STRING_KERNELS_X86)
+
+// ---- SSE2 (baseline on x86-64) ----
+
+// Aligned loads never cross a page boundary, so reading the rest of the block
+// that holds the terminator cannot fault even though it is past the string
+STRING_KERNELS_NO_ASAN inline std::size_t lengthSse2(const char* s)
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(s);
+    const unsigned skip = address & 15;
+    const __m128i* block = reinterpret_cast<const __m128i*>(address - skip);
+    const __m128i zero = _mm_setzero_si128();
+    unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+                        _mm_cmpeq_epi8(_mm_load_si128(block), zero))) >> skip;
+    if (mask) return __builtin_ctz(mask);
+    for (;;)
+    {
+        block++;
+        mask = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero));
+        if (mask)
+            return reinterpret_cast<const char*>(block) - s + __builtin_ctz(mask);
+    }
+}
+
+inline std::size_t mismatchSse2(const char* a, const char* b, std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i y = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+        unsigned differ = ~_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) & 0xFFFF;
+        if (differ) return i + __builtin_ctz(differ);
+    }
+    return i + mismatchScalar(a + i, b + i, n - i);
+}
+
+// First-and-last-byte filter: a block of 16 candidate positions is compared
+// against needle[0] at i and needle[m - 1] at i + m - 1; only positions where
+// both match are checked in full
+inline std::size_t findSse2(const char* haystack, std::size_t n, const char* needle,
+                            std::size_t m)
+{
+    if (m < 2 || m > n) return findScalar(haystack, n, needle, m);
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[m - 1]);
+    std::size_t i = 0;
+    for (; i + m - 1 + 16 <= n; i += 16)
+    {
+        __m128i atFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i));
+        __m128i atLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + m - 1));
+        unsigned candidates = _mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(atFirst, first), _mm_cmpeq_epi8(atLast, last)));
+        for (; candidates; candidates &= candidates - 1)
+        {
+            std::size_t at = i + __builtin_ctz(candidates);
+            if (std::memcmp(haystack + at + 1, needle + 1, m - 2) == 0) return at;
+        }
+    }
+    return findFrom(haystack, n, i, needle, m);
+}
+
+// Byte counters go up by one per match (cmpeq gives -1, subtracted) and are
+// folded into 64-bit totals with psadbw before any of them can reach 256
+inline std::size_t countSse2(const char* s, std::size_t n, char c)
+{
+    const __m128i target = _mm_set1_epi8(c);
+    const __m128i zero = _mm_setzero_si128();
+    __m128i totals = zero;
+    std::size_t i = 0;
+    while (i + 16 <= n)
+    {
+        __m128i counters = zero;
+        for (int round = 0; round < 255 && i + 16 <= n; round++, i += 16)
+        {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + i));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(x, target));
+        }
+        totals = _mm_add_epi64(totals, _mm_sad_epu8(counters, zero));
+    }
+    alignas(16) unsigned long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), totals);
+    std::size_t count = static_cast<std::size_t>(lanes[0] + lanes[1]);
+    return count + countScalar(s + i, n - i, c);
+}
+
+// SSE2 has no byte shuffle: reverse the dwords, then the words in each dword,
+// then the two bytes in each word
+inline __m128i reverseBytes128(__m128i x)
+{
+    x = _mm_shuffle_epi32(x, _MM_SHUFFLE(0, 1, 2, 3));
+    x = _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, _MM_SHUFFLE(2, 3, 0, 1)),
+                            _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(x, 8), _mm_srli_epi16(x, 8));
+}
+
+// Swaps reversed 16-byte blocks from both ends inward; the middle is left to the scalar loop
+inline void reverseSse2(char* s, std::size_t n)
+{
+    char* left = s;
+    char* right = s + n;
+    while (right - left >= 32)
+    {
+        right -= 16;
+        __m128i front = _mm_loadu_si128(reinterpret_cast<const __m128i*>(left));
+        __m128i back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(right));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(left), reverseBytes128(back));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(right), reverseBytes128(front));
+        left += 16;
+    }
+    reverseScalar(left, static_cast<std::size_t>(right - left));
+}
+
+// ---- AVX2 ----
+
+__attribute__((target("avx2"))) STRING_KERNELS_NO_ASAN inline std::size_t lengthAvx2(const char* s)
+{
+    const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(s);
+    const unsigned skip = address & 31;
+    const __m256i* block = reinterpret_cast<const __m256i*>(address - skip);
+    const __m256i zero = _mm256_setzero_si256();
+    unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(
+                        _mm256_cmpeq_epi8(_mm256_load_si256(block), zero))) >> skip;
+    if (mask) return __builtin_ctz(mask);
+    for (;;)
+    {
+        block++;
+        mask = _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256(block), zero));
+        if (mask)
+            return reinterpret_cast<const char*>(block) - s + __builtin_ctz(mask);
+    }
+}
+
+__attribute__((target("avx2"))) inline std::size_t mismatchAvx2(const char* a, const char* b,
+                                                                std::size_t n)
+{
+    std::size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i y = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        unsigned differ = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(x, y)));
+        if (differ) return i + __builtin_ctz(differ);
+    }
+    return i + mismatchSse2(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline std::size_t findAvx2(const char* haystack, std::size_t n,
+                                                            const char* needle, std::size_t m)
+{
+    if (m < 2 || m > n) return findScalar(haystack, n, needle, m);
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[m - 1]);
+    std::size_t i = 0;
+    for (; i + m - 1 + 32 <= n; i += 32)
+    {
+        __m256i atFirst = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i));
+        __m256i atLast =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + m - 1));
+        unsigned candidates = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(atFirst, first), _mm256_cmpeq_epi8(atLast, last))));
+        for (; candidates; candidates &= candidates - 1)
+        {
+            std::size_t at = i + __builtin_ctz(candidates);
+            if (std::memcmp(haystack + at + 1, needle + 1, m - 2) == 0) return at;
+        }
+    }
+    return findFrom(haystack, n, i, needle, m);
+}
+
+__attribute__((target("avx2"))) inline std::size_t countAvx2(const char* s, std::size_t n, char c)
+{
+    const __m256i target = _mm256_set1_epi8(c);
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i totals = zero;
+    std::size_t i = 0;
+    while (i + 32 <= n)
+    {
+        __m256i counters = zero;
+        for (int round = 0; round < 255 && i + 32 <= n; round++, i += 32)
+        {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + i));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(x, target));
+        }
+        totals = _mm256_add_epi64(totals, _mm256_sad_epu8(counters, zero));
+    }
+    alignas(32) unsigned long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), totals);
+    std::size_t count = static_cast<std::size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]);
+    return count + countSse2(s + i, n - i, c);
+}
+
+// pshufb reverses the bytes inside each 128-bit lane, then the two lanes swap
+__attribute__((target("avx2"))) inline __m256i reverseBytes256(__m256i x)
+{
+    const __m256i order = _mm256_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0,
+                                           15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+    x = _mm256_shuffle_epi8(x, order);
+    return _mm256_permute2x128_si256(x, x, 1);
+}
+
+__attribute__((target("avx2"))) inline void reverseAvx2(char* s, std::size_t n)
+{
+    char* left = s;
+    char* right = s + n;
+    while (right - left >= 64)
+    {
+        right -= 32;
+        __m256i front = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(left));
+        __m256i back = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(right));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(left), reverseBytes256(back));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(right), reverseBytes256(front));
+        left += 32;
+    }
+    reverseSse2(left, static_cast<std::size_t>(right - left));
+}
+
+#endif
+
+// ---- Runtime dispatch ----
+
+struct Kernels
+{
+    const char* name;
+    std::size_t (*length)(const char*);
+    std::size_t (*mismatch)(const char*, const char*, std::size_t);
+    std::size_t (*find)(const char*, std::size_t, const char*, std::size_t);
+    std::size_t (*count)(const char*, std::size_t, char);
+    void (*reverse)(char*, std::size_t);
+};
+
+// Every kernel set this build and this CPU can run, slowest (scalar) first
+inline int availableKernels(Kernels* out)
+{
+    int count = 0;
+    out[count++] = {"scalar", lengthScalar, mismatchScalar, findScalar, countScalar,
+                    reverseScalar};
+#if defined(STRING_KERNELS_X86)
+    out[count++] = {"sse2", lengthSse2, mismatchSse2, findSse2, countSse2, reverseSse2};
+    if (__builtin_cpu_supports("avx2"))
+        out[count++] = {"avx2", lengthAvx2, mismatchAvx2, findAvx2, countAvx2, reverseAvx2};
+#endif
+    return count;
+}
+
+// Fastest kernel set for this CPU, detected once
+inline const Kernels& bestKernels()
+{
+    static const Kernels best = []
+    {
+        Kernels all[4];
+        int count = availableKernels(all);
+        return all[count - 1];
+    }();
+    return best;
+}
+
+// ---- string_view front end ----
+
+// Number of characters before the terminating '\0', like strlen
+inline std::size_t length(const char* s) { return bestKernels().length(s); }
+
+inline bool equal(std::string_view a, std::string_view b)
+{
+    return a.size() == b.size() && bestKernels().mismatch(a.data(), b.data(), a.size()) == a.size();
+}
+
+// Lexicographic order of the bytes as unsigned char, like strcmp: <0, 0 or >0
+inline int compare(std::string_view a, std::string_view b)
+{
+    const std::size_t n = a.size() < b.size() ? a.size() : b.size();
+    const std::size_t i = bestKernels().mismatch(a.data(), b.data(), n);
+    if (i < n)
+        return static_cast<unsigned char>(a[i]) - static_cast<unsigned char>(b[i]);
+    return a.size() < b.size() ? -1 : a.size() > b.size() ? 1 : 0;
+}
+
+// Position of the first occurrence of needle in haystack, or npos
+inline std::size_t find(std::string_view haystack, std::string_view needle)
+{
+    return bestKernels().find(haystack.data(), haystack.size(), needle.data(), needle.size());
+}
+
+inline std::size_t count(std::string_view s, char c)
+{
+    return bestKernels().count(s.data(), s.size(), c);
+}
+
+inline void reverse(char* s, std::size_t n) { bestKernels().reverse(s, n); }
+
+}  // namespace string_kernels
+
+#endif
@@ -10,6 +10,9 @@
 #include <vector>    // For std::vector (dynamic array in C++)
 #include <array>     // For std::array (fixed-size array wrapper in C++11)
 #include <memory>    // For std::unique_ptr, std::shared_ptr (smart pointers for dynamic memory)
+#include <chrono>    // For timing the matrix benchmark
+#include <thread>    // For std::thread::hardware_concurrency
+#include "matrix.h"  // For Matrix<T>, MatrixView<T>, transpose, multiply
 
 // =========================================================================
 // 1. Introduction: Static vs. Dynamic Memory Allocation
@@ -278,6 +281,154 @@ void stdVector2DExample()
     }
 }
 
+/**
+ * **3.2.3. Contiguous 2D Arrays (`Matrix<T>` from matrix.h)**
+ * -   `int**` costs `rows + 1` allocations and `vector<vector<int>>` costs `rows + 1` as well;
+ * rows end up scattered across the heap and every access first loads a row pointer.
+ * -   `Matrix<T>` stores all rows in **one** aligned block, row-major, so element (r, c) is
+ * `data[r * stride + c]`. Walking a row is a linear scan the hardware prefetcher and SIMD units
+ * handle well.
+ * -   `MatrixView<T>` is a non-owning window (whole matrix or sub-block) that can be passed to
+ * functions without copying.
+ */
+
+// Example 3.2.3: Matrix<T> usage
+void matrixExample()
+{
+    Matrix<int> matrix(3, 4);  // One allocation, zero-initialized
+    matrix(0, 0) = 1;
+    matrix(1, 2) = 5;
+    matrix(2, 3) = 9;
+
+    std::cout << "3.2.3 Matrix elements (row stride " << matrix.rowStride() << "):" << std::endl;
+    for (std::size_t r = 0; r < matrix.rows(); ++r)
+    {
+        for (std::size_t c = 0; c < matrix.cols(); ++c)
+        {
+            std::cout << matrix(r, c) << "\t";
+        }
+        std::cout << std::endl;
+    }
+
+    // A view of the bottom-right 2x2 block shares memory with the matrix
+    MatrixView<int> corner = matrix.view().block(1, 2, 2, 2);
+    corner(0, 0) += 100;
+    std::cout << "3.2.3 After corner(0, 0) += 100, matrix(1, 2) = " << matrix(1, 2) << std::endl;
+
+    Matrix<int> transposed = transpose(matrix);
+    std::cout << "3.2.3 Transposed is " << transposed.rows() << "x" << transposed.cols()
+              << ", transposed(3, 2) = " << transposed(3, 2) << std::endl;
+
+    try
+    {
+        matrix.at(3, 0);
+    }
+    catch (const std::out_of_range& error)
+    {
+        std::cout << "3.2.3 at(3, 0) threw: " << error.what() << std::endl;
+    }
+}
+
+// Example 3.2.4: Multiply and transpose, float** (one new[] per row) vs Matrix<float>
+// The Matrix inner loops only become SIMD with vectorization enabled, e.g.
+//   g++ -std=c++17 -O3 -march=native -pthread 02-static-dynamic-arrays.cpp
+void matrixBenchmark(std::size_t n)
+{
+    auto secondsSince = [](std::chrono::steady_clock::time_point start)
+    { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+    // Pointer-to-pointers version, plain i-j-k loops
+    float** a = new float*[n];
+    float** b = new float*[n];
+    float** c = new float*[n];
+    float** t = new float*[n];
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        a[i] = new float[n];
+        b[i] = new float[n];
+        c[i] = new float[n];
+        t[i] = new float[n]();  // Zeroed, like Matrix
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            a[i][j] = static_cast<float>((i * 7 + j) % 13) - 6;
+            b[i][j] = static_cast<float>((i + j * 5) % 11) - 5;
+        }
+    }
+
+    Matrix<float> ma(n, n), mb(n, n);
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            ma(i, j) = a[i][j];
+            mb(i, j) = b[i][j];
+        }
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            float sum = 0;
+            for (std::size_t k = 0; k < n; ++k) sum += a[i][k] * b[k][j];
+            c[i][j] = sum;
+        }
+    }
+    double naiveMultiply = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < n; ++i)
+        for (std::size_t j = 0; j < n; ++j) t[j][i] = a[i][j];
+    double naiveTranspose = secondsSince(start);
+
+    start = std::chrono::steady_clock::now();
+    Matrix<float> mc = multiply(ma, mb);
+    double tiledMultiply = secondsSince(start);
+
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+    start = std::chrono::steady_clock::now();
+    Matrix<float> mcThreaded = multiply(ma, mb, threads);
+    double threadedMultiply = secondsSince(start);
+
+    Matrix<float> mt(n, n);  // Allocated up front, like t above
+    start = std::chrono::steady_clock::now();
+    transpose(ma.view(), mt.view());
+    double tiledTranspose = secondsSince(start);
+
+    // Small integers only, so every float sum is exact and the results must match exactly
+    bool same = true;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            same = same && c[i][j] == mc(i, j) && c[i][j] == mcThreaded(i, j);
+            same = same && t[i][j] == mt(i, j);
+        }
+    }
+
+    double flops = 2.0 * n * n * n;
+    std::cout << "3.2.4 " << n << "x" << n << " float, results match: " << same << std::endl;
+    std::cout << "      multiply  float**: " << flops / naiveMultiply / 1e9
+              << " GFLOP/s, Matrix: " << flops / tiledMultiply / 1e9
+              << " GFLOP/s, Matrix on " << threads << " threads: "
+              << flops / threadedMultiply / 1e9 << " GFLOP/s" << std::endl;
+    std::cout << "      transpose float**: " << naiveTranspose * 1e3
+              << " ms, Matrix: " << tiledTranspose * 1e3 << " ms" << std::endl;
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        delete[] a[i];
+        delete[] b[i];
+        delete[] c[i];
+        delete[] t[i];
+    }
+    delete[] a;
+    delete[] b;
+    delete[] c;
+    delete[] t;
+}
+
 /**
  * **3.3. When to Use Dynamic Arrays (`std::vector`):**
  * -   When the size of the collection is not known at compile time or needs to change during
@@ -374,6 +525,8 @@ int main()
     std::cout << "\n--- Section 3.2: Modern C++ Dynamic Arrays (`std::vector`) ---" << std::endl;
     stdVectorExample();
     stdVector2DExample();
+    matrixExample();
+    matrixBenchmark(1024);
 
     std::cout << "\n--- Section 4: `std::array` (Fixed-Size Array Wrapper) ---" << std::endl;
     stdArrayFixedExample();
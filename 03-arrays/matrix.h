@@ -0,0 +1,319 @@
+/**
+ * File: matrix.h
+ * Description: A contiguous, row-major 2D array (Matrix<T>) with non-owning views, plus
+ * cache-blocked transpose and multiply kernels. It is the single-allocation alternative to the
+ * pointer-to-pointers and vector-of-vectors examples in 02-static-dynamic-arrays.cpp.
+ */
+
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include <algorithm>    // For std::min, std::fill
+#include <cstddef>      // For std::size_t
+#include <new>          // For aligned operator new / delete
+#include <stdexcept>    // For std::out_of_range, std::invalid_argument
+#include <thread>       // For std::thread (multithreaded multiply)
+#include <type_traits>  // For std::enable_if_t, std::is_same_v
+#include <utility>      // For std::swap
+#include <vector>       // For the list of worker threads
+
+/**
+ * **Layout**
+ * -   All rows live in one block of memory, row r starting at data + r * stride.
+ * -   stride >= cols is rounded up so that every row starts on a 64-byte cache line, which lets
+ * the compiler use aligned SIMD loads and keeps rows from sharing lines. A stride that is a
+ * multiple of 4 KB gets one more line of padding.
+ * -   Element (r, c) is at data[r * stride + c]: one multiply and one add, no pointer chasing.
+ */
+
+/**
+ * Non-owning window onto a row-major block of T: a whole Matrix or any rectangle inside it.
+ * Copying a view copies the pointer only. Use MatrixView<const T> for read-only access.
+ */
+template <typename T>
+class MatrixView
+{
+   private:
+    T* first;            // Element (0, 0) of the view
+    std::size_t nRows;   // Rows in the view
+    std::size_t nCols;   // Columns in the view
+    std::size_t stride;  // Elements between the starts of consecutive rows
+
+   public:
+    MatrixView(T* data, std::size_t rows, std::size_t cols, std::size_t rowStride)
+        : first(data), nRows(rows), nCols(cols), stride(rowStride)
+    {
+    }
+
+    // A view of U converts to a read-only view of const U
+    template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T>>>
+    MatrixView(const MatrixView<U>& other)
+        : MatrixView(other.data(), other.rows(), other.cols(), other.rowStride())
+    {
+    }
+
+    T& operator()(std::size_t r, std::size_t c) const { return first[r * stride + c]; }
+
+    // Bounds-checked access, throws std::out_of_range
+    T& at(std::size_t r, std::size_t c) const
+    {
+        if (r >= nRows || c >= nCols) throw std::out_of_range("MatrixView::at out of range");
+        return first[r * stride + c];
+    }
+
+    T* row(std::size_t r) const { return first + r * stride; }
+
+    /**
+     * Sub-rectangle of rows x cols elements starting at (r, c), sharing this view's memory.
+     * @throws std::out_of_range if the rectangle does not fit inside the view.
+     */
+    MatrixView block(std::size_t r, std::size_t c, std::size_t rows, std::size_t cols) const
+    {
+        if (r > nRows || c > nCols || rows > nRows - r || cols > nCols - c)
+            throw std::out_of_range("MatrixView::block out of range");
+        return {row(r) + c, rows, cols, stride};
+    }
+
+    std::size_t rows() const { return nRows; }
+    std::size_t cols() const { return nCols; }
+    std::size_t rowStride() const { return stride; }
+    T* data() const { return first; }
+};
+
+/**
+ * Owning rows x cols matrix in a single 64-byte aligned allocation. Copyable and movable.
+ */
+template <typename T>
+class Matrix
+{
+   private:
+    static constexpr std::size_t kAlignment = 64;  // One cache line
+    static constexpr std::size_t kRowMultiple =
+        kAlignment % sizeof(T) == 0 ? kAlignment / sizeof(T) : 1;
+
+    T* elements = nullptr;
+    std::size_t nRows = 0;
+    std::size_t nCols = 0;
+    std::size_t stride = 0;
+
+    static std::size_t strideFor(std::size_t cols)
+    {
+        std::size_t stride = (cols + kRowMultiple - 1) / kRowMultiple * kRowMultiple;
+        // Rows exactly a multiple of 4 KB apart all map to the same cache sets, which makes
+        // column-wise access (transpose, tiles) thrash; one extra line per row avoids that
+        if (stride * sizeof(T) % 4096 == 0) stride += kRowMultiple;
+        return stride;
+    }
+
+    void allocate()
+    {
+        std::size_t count = nRows * stride;
+        if (count == 0) return;
+        elements = static_cast<T*>(
+            ::operator new(count * sizeof(T), std::align_val_t(std::max(kAlignment, alignof(T)))));
+        std::size_t built = 0;
+        try
+        {
+            for (; built < count; built++) new (elements + built) T();
+        }
+        catch (...)
+        {
+            for (std::size_t i = 0; i < built; i++) elements[i].~T();
+            release(0);
+            throw;
+        }
+    }
+
+    // Destroys count elements and frees the block
+    void release(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; i++) elements[i].~T();
+        if (elements)
+            ::operator delete(elements, std::align_val_t(std::max(kAlignment, alignof(T))));
+        elements = nullptr;
+    }
+
+   public:
+    Matrix() = default;
+
+    Matrix(std::size_t rows, std::size_t cols, const T& value = T())
+        : nRows(rows), nCols(cols), stride(strideFor(cols))
+    {
+        allocate();
+        fill(value);
+    }
+
+    Matrix(const Matrix& other) : nRows(other.nRows), nCols(other.nCols), stride(other.stride)
+    {
+        allocate();
+        std::copy(other.elements, other.elements + nRows * stride, elements);
+    }
+
+    Matrix(Matrix&& other) noexcept { swap(other); }
+
+    Matrix& operator=(Matrix other) noexcept
+    {
+        swap(other);
+        return *this;
+    }
+
+    ~Matrix() { release(nRows * stride); }
+
+    void swap(Matrix& other) noexcept
+    {
+        std::swap(elements, other.elements);
+        std::swap(nRows, other.nRows);
+        std::swap(nCols, other.nCols);
+        std::swap(stride, other.stride);
+    }
+
+    void fill(const T& value)
+    {
+        for (std::size_t r = 0; r < nRows; r++) std::fill(row(r), row(r) + nCols, value);
+    }
+
+    T& operator()(std::size_t r, std::size_t c) { return elements[r * stride + c]; }
+    const T& operator()(std::size_t r, std::size_t c) const { return elements[r * stride + c]; }
+
+    // Bounds-checked access, throws std::out_of_range
+    T& at(std::size_t r, std::size_t c) { return view().at(r, c); }
+    const T& at(std::size_t r, std::size_t c) const { return view().at(r, c); }
+
+    T* row(std::size_t r) { return elements + r * stride; }
+    const T* row(std::size_t r) const { return elements + r * stride; }
+
+    MatrixView<T> view() { return {elements, nRows, nCols, stride}; }
+    MatrixView<const T> view() const { return {elements, nRows, nCols, stride}; }
+    operator MatrixView<T>() { return view(); }
+    operator MatrixView<const T>() const { return view(); }
+
+    std::size_t rows() const { return nRows; }
+    std::size_t cols() const { return nCols; }
+    std::size_t rowStride() const { return stride; }
+    T* data() { return elements; }
+    const T* data() const { return elements; }
+};
+
+namespace matrix_detail
+{
+// Blocks template argument deduction, so read-only view parameters accept mutable views too
+template <typename T>
+struct Identity
+{
+    using type = T;
+};
+
+const std::size_t kTransposeTile = 32;  // 32 x 32 floats = 4 KB per tile, both tiles fit in L1
+const std::size_t kRowTile = 64;        // Rows of A / C per multiply tile
+const std::size_t kDepthTile = 256;     // Columns of A = rows of B per multiply tile
+const std::size_t kColTile = 512;       // Columns of B / C per multiply tile
+
+// C[rows rowBegin..rowEnd) += A * B, tiled so the B tile stays in cache while it is reused
+template <typename T>
+void multiplyRows(MatrixView<const T> a, MatrixView<const T> b, MatrixView<T> c,
+                  std::size_t rowBegin, std::size_t rowEnd)
+{
+    const std::size_t depth = a.cols();
+    const std::size_t width = b.cols();
+    for (std::size_t j0 = 0; j0 < width; j0 += kColTile)
+    {
+        std::size_t j1 = std::min(width, j0 + kColTile);
+        for (std::size_t k0 = 0; k0 < depth; k0 += kDepthTile)
+        {
+            std::size_t k1 = std::min(depth, k0 + kDepthTile);
+            for (std::size_t i0 = rowBegin; i0 < rowEnd; i0 += kRowTile)
+            {
+                std::size_t i1 = std::min(rowEnd, i0 + kRowTile);
+                for (std::size_t i = i0; i < i1; i++)
+                {
+                    T* __restrict out = c.row(i);
+                    const T* aRow = a.row(i);
+                    for (std::size_t k = k0; k < k1; k++)
+                    {
+                        const T scale = aRow[k];
+                        const T* __restrict in = b.row(k);
+                        // Unit-stride, no aliasing: the compiler turns this into SIMD
+                        for (std::size_t j = j0; j < j1; j++) out[j] += scale * in[j];
+                    }
+                }
+            }
+        }
+    }
+}
+}  // namespace matrix_detail
+
+/**
+ * dst = transpose(src), one square tile at a time so both reads and writes stay in cache.
+ * @throws std::invalid_argument if dst is not src.cols() x src.rows().
+ */
+template <typename T>
+void transpose(typename matrix_detail::Identity<MatrixView<const T>>::type src, MatrixView<T> dst)
+{
+    if (dst.rows() != src.cols() || dst.cols() != src.rows())
+        throw std::invalid_argument("transpose: destination has the wrong shape");
+    const std::size_t tile = matrix_detail::kTransposeTile;
+    for (std::size_t r0 = 0; r0 < src.rows(); r0 += tile)
+    {
+        std::size_t r1 = std::min(src.rows(), r0 + tile);
+        for (std::size_t c0 = 0; c0 < src.cols(); c0 += tile)
+        {
+            std::size_t c1 = std::min(src.cols(), c0 + tile);
+            for (std::size_t r = r0; r < r1; r++)
+            {
+                const T* in = src.row(r);
+                for (std::size_t c = c0; c < c1; c++) dst(c, r) = in[c];
+            }
+        }
+    }
+}
+
+template <typename T>
+Matrix<T> transpose(const Matrix<T>& src)
+{
+    Matrix<T> result(src.cols(), src.rows());
+    transpose(src.view(), result.view());
+    return result;
+}
+
+/**
+ * c = a * b using cache-blocked tiles. With threads > 1, bands of rows of c are computed on
+ * separate threads; each thread writes only its own rows, so no locking is needed.
+ * c must not overlap a or b.
+ * @throws std::invalid_argument if the shapes do not match.
+ */
+template <typename T>
+void multiply(typename matrix_detail::Identity<MatrixView<const T>>::type a,
+              typename matrix_detail::Identity<MatrixView<const T>>::type b, MatrixView<T> c,
+              unsigned threads = 1)
+{
+    if (a.cols() != b.rows() || c.rows() != a.rows() || c.cols() != b.cols())
+        throw std::invalid_argument("multiply: matrix shapes do not match");
+    for (std::size_t i = 0; i < c.rows(); i++) std::fill(c.row(i), c.row(i) + c.cols(), T());
+
+    // Hand out whole row tiles so threads never share a cache line of c
+    const std::size_t tiles = (a.rows() + matrix_detail::kRowTile - 1) / matrix_detail::kRowTile;
+    threads = static_cast<unsigned>(std::min<std::size_t>(std::max(threads, 1u), tiles));
+    if (threads <= 1)
+    {
+        matrix_detail::multiplyRows(a, b, c, 0, a.rows());
+        return;
+    }
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+    {
+        std::size_t begin = std::min(a.rows(), tiles * t / threads * matrix_detail::kRowTile);
+        std::size_t end = std::min(a.rows(), tiles * (t + 1) / threads * matrix_detail::kRowTile);
+        workers.emplace_back([=] { matrix_detail::multiplyRows(a, b, c, begin, end); });
+    }
+    for (std::thread& worker : workers) worker.join();
+}
+
+template <typename T>
+Matrix<T> multiply(const Matrix<T>& a, const Matrix<T>& b, unsigned threads = 1)
+{
+    Matrix<T> result(a.rows(), b.cols());
+    multiply(a.view(), b.view(), result.view(), threads);
+    return result;
+}
+
+#endif
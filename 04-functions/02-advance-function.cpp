@@ -11,6 +11,9 @@
 #include <vector>      // For std::vector
 #include <functional>  // For std::function (modern C++ function pointers)
 #include <numeric>     // For std::accumulate
+#include <chrono>      // For timing the fused-transform benchmark
+#include <cmath>       // For std::sqrt
+#include "parallel-algorithms.h"  // For data_parallel::transform_reduce, inclusive_scan, Pipeline
 
 // =========================================================================
 // 1. Function Pointers: Deeper Dive
@@ -284,6 +287,7 @@ void safeOperation() noexcept
  */
 
 // Example 5.2: constexpr function
+// (To precompute a whole table of such values, see make_table in 08-templates/constexpr-tables.h)
 constexpr int getSquare(int n)
 {
     return n * n;
@@ -322,6 +326,101 @@ void process(char c)
     std::cout << "6.1 Processing char: " << c << std::endl;
 }
 
+// =========================================================================
+// 7. Data-Parallel Functors: transform_reduce, inclusive_scan, Fused Pipelines
+// =========================================================================
+
+/**
+ * **7. Data-Parallel Functors**
+ * -   The functors of Section 3 and the fold of Section 4 each handle one value at a time.
+ * The same callables can drive a whole array across threads (see parallel-algorithms.h):
+ * -   `parallel_for(n, body)`: calls `body(i)` for every index.
+ * -   `transform_reduce(span, init, reduce, transform)`: what `Accumulator` and
+ * `sum_fold_expression` compute, with a `Multiplier`-style transform applied to each value.
+ * -   `inclusive_scan(in, out, op)`: every running total that `Accumulator` prints, as an array.
+ * -   `from(span).transform(f).transform(g).reduce(...)`: the chained transforms are composed
+ * into one callable, so the data is read once and no temporary array is written.
+ * -   `reduce` must be associative (e.g. +, *, min, max): the values are grouped by chunk.
+ * Chunks depend only on the input size, so results are the same for any thread count.
+ * -   A stateful functor like `Accumulator` cannot be shared across threads; the parallel
+ * version keeps one partial result per chunk instead and combines the partials in order.
+ */
+
+// Example 7.1: Multiplier and a fold over a whole vector, and Accumulator's running sums
+void parallelFunctorExamples()
+{
+    std::vector<int> values(1000);
+    std::iota(values.begin(), values.end(), 1);  // 1, 2, ..., 1000
+    data_parallel::Span<const int> view(values);
+
+    long long tripled = data_parallel::transform_reduce(view, 0LL, std::plus<>(), Multiplier(3));
+    std::cout << "7.1 Sum of 3 * (1..1000): " << tripled << std::endl;
+
+    auto addOne = [](int x) { return x + 1; };
+    long long chained = data_parallel::from(view)
+                            .transform(Multiplier(3))
+                            .transform(addOne)
+                            .reduce(0LL, std::plus<>());
+    std::cout << "7.1 Sum of 3 * x + 1 (fused): " << chained << std::endl;
+
+    std::vector<long long> running(values.size());
+    data_parallel::inclusive_scan(view, data_parallel::Span<long long>(running), std::plus<>());
+    std::cout << "7.1 Running sums: " << running[0] << ", " << running[1] << ", " << running[2]
+              << ", ..., " << running.back() << std::endl;
+
+    std::vector<int> squares(values.size());
+    data_parallel::parallel_for(values.size(),
+                                [&](size_t i) { squares[i] = values[i] * values[i]; });
+    std::cout << "7.1 parallel_for squares[9]: " << squares[9] << std::endl;
+}
+
+// Example 7.2: Same bits on any thread count; unfused vs fused passes over 16M doubles
+void benchmarkParallelFunctors()
+{
+    using Clock = std::chrono::steady_clock;
+    auto ms_since = [](Clock::time_point start)
+    { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+    std::vector<double> values(1 << 24);
+    for (size_t i = 0; i < values.size(); i++) values[i] = 1.0 / (1 + i % 1000);
+    data_parallel::Span<const double> view(values);
+    auto scale = [](double x) { return x * 1.5; };
+    auto root = [](double x) { return std::sqrt(x); };
+
+    data_parallel::WorkStealingPool one(1), four(4);
+    double onOne = data_parallel::from(view, {&one}).transform(scale).reduce(0.0, std::plus<>());
+    double onFour = data_parallel::from(view, {&four}).transform(scale).reduce(0.0, std::plus<>());
+    std::cout << "7.2 Sum on 1 thread == sum on 4 threads: " << (onOne == onFour) << std::endl;
+
+    auto start = Clock::now();
+    double loop = 0.0;
+    for (double x : values) loop += root(scale(x));
+    double loop_ms = ms_since(start);
+
+    // Each transform writes its own array before the reduce reads the last one
+    std::vector<double> scaled(values.size()), rooted(values.size());
+    start = Clock::now();
+    data_parallel::from(view).transform(scale).writeTo(data_parallel::Span<double>(scaled));
+    data_parallel::from(data_parallel::Span<const double>(scaled))
+        .transform(root)
+        .writeTo(data_parallel::Span<double>(rooted));
+    auto identity = [](double x) { return x; };
+    double unfused = data_parallel::transform_reduce(data_parallel::Span<const double>(rooted),
+                                                     0.0, std::plus<>(), identity);
+    double unfused_ms = ms_since(start);
+
+    start = Clock::now();
+    double fused = data_parallel::from(view).transform(scale).transform(root).reduce(
+        0.0, std::plus<>());
+    double fused_ms = ms_since(start);
+
+    std::cout << "7.2 " << values.size() << " doubles on "
+              << data_parallel::WorkStealingPool::shared().size() << " threads: loop " << loop_ms
+              << " ms, unfused " << unfused_ms << " ms, fused " << fused_ms
+              << " ms (relative difference " << std::abs(fused - loop) / loop
+              << ", unfused == fused: " << (unfused == fused) << ")" << std::endl;
+}
+
 // =========================================================================
 // Main Function (Entry Point of the Program)
 // =========================================================================
@@ -394,5 +493,9 @@ int main()
     // process(5L); // Might be ambiguous or call process(double) depending on compiler
     // rules/conversions
 
+    std::cout << "\n--- Section 7: Data-Parallel Functors ---" << std::endl;
+    parallelFunctorExamples();
+    benchmarkParallelFunctors();
+
     return 0;
 }
@@ -0,0 +1,416 @@
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+// Data-parallel versions of the one-element-at-a-time functors in
+// 02-advance-function.cpp (Accumulator, Multiplier, sum_fold_expression):
+// parallel_for, transform_reduce and inclusive_scan over a Span, taking any
+// functor or lambda, plus a Pipeline that fuses chained transforms into the
+// final pass so no intermediate array is written.
+//
+// Work is cut into chunks whose size depends only on the input length and the
+// grain, never on the thread count, and reductions combine the chunk results
+// in chunk order. The same input therefore gives the same bits on 1 thread or
+// 64, even for floating point. The reduce operation must be associative (it is
+// applied in a different grouping than a left-to-right loop), and body,
+// transform and reduce must not throw.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace data_parallel
+{
+
+// Pointer and length, like std::span (C++20)
+template <typename T>
+class Span
+{
+   private:
+    T* first;
+    size_t count;
+
+   public:
+    Span(T* data, size_t size) : first(data), count(size) {}
+    template <typename U>
+    Span(std::vector<U>& v) : first(v.data()), count(v.size())
+    {
+    }
+    template <typename U>
+    Span(const std::vector<U>& v) : first(v.data()), count(v.size())
+    {
+    }
+    template <typename U>
+    Span(Span<U> other) : first(other.data()), count(other.size())
+    {
+    }
+
+    T* data() const { return first; }
+    size_t size() const { return count; }
+    T& operator[](size_t i) const { return first[i]; }
+    T* begin() const { return first; }
+    T* end() const { return first + count; }
+    Span subspan(size_t offset, size_t length) const { return Span(first + offset, length); }
+};
+
+template <typename U>
+Span(std::vector<U>&) -> Span<U>;
+template <typename U>
+Span(const std::vector<U>&) -> Span<const U>;
+
+// Worker threads that run one batch of indexed tasks at a time. Every thread,
+// the caller of run() included, starts with an equal share of the indices and
+// takes them from the front; a thread whose share runs out steals the back
+// half of another thread's remaining share, so uneven tasks even out without
+// a shared counter every thread has to hit.
+class WorkStealingPool
+{
+   private:
+    // Remaining indices [begin, end) of one thread, packed as (begin << 32) | end.
+    // The owner moves begin with a CAS, thieves move end; the owner stores a new
+    // range only while its own is empty, when no thief touches it.
+    struct alignas(64) Share
+    {
+        std::atomic<std::uint64_t> range{0};
+    };
+
+    static std::uint64_t pack(std::uint64_t begin, std::uint64_t end) { return begin << 32 | end; }
+    static std::uint64_t beginOf(std::uint64_t range) { return range >> 32; }
+    static std::uint64_t endOf(std::uint64_t range) { return range & 0xffffffffu; }
+
+    std::vector<std::thread> workers;
+    std::unique_ptr<Share[]> shares;  // shares[0] belongs to the caller of run()
+    std::mutex runLock;               // Serializes run() calls from different threads
+    std::mutex lock;
+    std::condition_variable wake;      // Workers wait here for a new batch
+    std::condition_variable finished;  // run() waits here for every thread to leave
+    std::function<void(size_t)> task;  // Current batch
+    unsigned activeThreads = 0;        // Threads still inside work()
+    unsigned generation = 0;           // Bumped for every batch so workers notice it
+    bool stopping = false;
+
+    bool takeOwn(unsigned self, size_t& index)
+    {
+        std::atomic<std::uint64_t>& range = shares[self].range;
+        std::uint64_t current = range.load(std::memory_order_acquire);
+        while (beginOf(current) < endOf(current))
+        {
+            if (range.compare_exchange_weak(current, pack(beginOf(current) + 1, endOf(current)),
+                                            std::memory_order_acq_rel))
+            {
+                index = beginOf(current);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Moves the back half of some other thread's share into ours. False when
+    // every share is empty, which means the batch has been handed out.
+    bool steal(unsigned self)
+    {
+        unsigned threads = size();
+        for (unsigned k = 1; k < threads; k++)
+        {
+            std::atomic<std::uint64_t>& range = shares[(self + k) % threads].range;
+            std::uint64_t current = range.load(std::memory_order_acquire);
+            while (beginOf(current) < endOf(current))
+            {
+                std::uint64_t left = endOf(current) - beginOf(current);
+                std::uint64_t cut = endOf(current) - (left + 1) / 2;
+                if (range.compare_exchange_weak(current, pack(beginOf(current), cut),
+                                                std::memory_order_acq_rel))
+                {
+                    shares[self].range.store(pack(cut, endOf(current)),
+                                             std::memory_order_release);
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // Runs tasks of the current batch until none are left to take or steal
+    void work(unsigned self)
+    {
+        size_t index;
+        do
+        {
+            while (takeOwn(self, index)) task(index);
+        } while (steal(self));
+        std::lock_guard<std::mutex> guard(lock);
+        if (--activeThreads == 0) finished.notify_all();
+    }
+
+    void workerLoop(unsigned self)
+    {
+        unsigned seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+            }
+            work(self);
+        }
+    }
+
+   public:
+    // threads == 0 means one per hardware thread; the caller of run() counts as one
+    explicit WorkStealingPool(unsigned threads = 0)
+    {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        shares.reset(new Share[threads]);
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back([this, i] { workerLoop(i); });
+    }
+
+    ~WorkStealingPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    // Threads that execute work, including the caller
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Calls body(i) for every i in [0, count) and returns once all calls are done.
+    // body must not throw, and must not call run() on the same pool.
+    void run(size_t count, std::function<void(size_t)> body)
+    {
+        if (count == 0) return;
+        if (count > 0xffffffffu) throw std::length_error("WorkStealingPool::run: too many tasks");
+        std::lock_guard<std::mutex> oneBatch(runLock);
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            task = std::move(body);
+            unsigned threads = size();
+            for (unsigned t = 0; t < threads; t++)
+                shares[t].range.store(pack(count * t / threads, count * (t + 1) / threads),
+                                      std::memory_order_relaxed);
+            activeThreads = threads;
+            generation++;
+        }
+        wake.notify_all();
+        work(0);
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [&] { return activeThreads == 0; });
+    }
+
+    // Process-wide pool sized to the machine
+    static WorkStealingPool& shared()
+    {
+        static WorkStealingPool pool;
+        return pool;
+    }
+};
+
+// Where and how finely to split the work. grain is the smallest chunk worth a
+// task: raise it for cheap per-element work, lower it for expensive work.
+struct Schedule
+{
+    WorkStealingPool* pool = nullptr;  // nullptr means WorkStealingPool::shared()
+    size_t grain = 1 << 14;
+};
+
+// About kTargetChunks chunks of at least grain elements: enough for stealing to
+// balance a few dozen threads, few enough that the per-chunk partials stay tiny
+class Chunks
+{
+   private:
+    static constexpr size_t kTargetChunks = 256;
+    size_t n;
+    size_t step;
+
+   public:
+    Chunks(size_t n, size_t grain) : n(n)
+    {
+        step = std::max<size_t>({grain, 1, (n + kTargetChunks - 1) / kTargetChunks});
+    }
+
+    size_t count() const { return (n + step - 1) / step; }
+    size_t begin(size_t chunk) const { return chunk * step; }
+    size_t end(size_t chunk) const { return std::min(n, (chunk + 1) * step); }
+};
+
+// Calls body(chunk) for every chunk; a single chunk runs here without waking the pool
+template <typename Body>
+void forEachChunk(const Chunks& chunks, const Schedule& schedule, Body body)
+{
+    if (chunks.count() <= 1)
+    {
+        if (chunks.count() == 1) body(size_t(0));
+        return;
+    }
+    WorkStealingPool& pool = schedule.pool ? *schedule.pool : WorkStealingPool::shared();
+    pool.run(chunks.count(), [&body](size_t chunk) { body(chunk); });
+}
+
+// Calls body(i) for every i in [0, n)
+template <typename Body>
+void parallel_for(size_t n, Body body, const Schedule& schedule = Schedule())
+{
+    Chunks chunks(n, schedule.grain);
+    forEachChunk(chunks, schedule,
+                 [&](size_t c)
+                 {
+                     for (size_t i = chunks.begin(c), end = chunks.end(c); i < end; i++) body(i);
+                 });
+}
+
+// reduce(init, reduce(transform(in[0]), transform(in[1]), ...)), grouped by chunk.
+// Returns init for an empty input.
+template <typename T, typename Init, typename Reduce, typename Transform>
+Init transform_reduce(Span<T> in, Init init, Reduce reduce, Transform transform,
+                      const Schedule& schedule = Schedule())
+{
+    Chunks chunks(in.size(), schedule.grain);
+    std::vector<Init> partial(chunks.count(), init);
+    forEachChunk(chunks, schedule,
+                 [&](size_t c)
+                 {
+                     size_t i = chunks.begin(c);
+                     size_t end = chunks.end(c);
+                     Init local = transform(in[i]);
+                     for (i++; i < end; i++) local = reduce(local, transform(in[i]));
+                     partial[c] = local;
+                 });
+    for (const Init& value : partial) init = reduce(init, value);
+    return init;
+}
+
+// out[i] = transform(in[0]) op ... op transform(in[i]). out may be the same span as in.
+// Two passes: chunk totals, then each chunk rescanned from the total of the ones before it.
+template <typename T, typename U, typename Op, typename Transform>
+void transform_inclusive_scan(Span<T> in, Span<U> out, Op op, Transform transform,
+                              const Schedule& schedule = Schedule())
+{
+    if (out.size() < in.size())
+        throw std::invalid_argument("transform_inclusive_scan: output shorter than input");
+    Chunks chunks(in.size(), schedule.grain);
+    std::vector<U> carry(chunks.count());
+    forEachChunk(chunks, schedule,
+                 [&](size_t c)
+                 {
+                     size_t i = chunks.begin(c);
+                     size_t end = chunks.end(c);
+                     U total = transform(in[i]);
+                     for (i++; i < end; i++) total = op(total, transform(in[i]));
+                     carry[c] = total;
+                 });
+    // carry[c] becomes the total of every chunk before c (unused for chunk 0)
+    if (!carry.empty())
+    {
+        U running = carry[0];
+        for (size_t c = 1; c < carry.size(); c++)
+        {
+            U total = carry[c];
+            carry[c] = running;
+            running = op(running, total);
+        }
+    }
+    forEachChunk(chunks, schedule,
+                 [&](size_t c)
+                 {
+                     size_t i = chunks.begin(c);
+                     size_t end = chunks.end(c);
+                     U running = c == 0 ? U(transform(in[i])) : op(carry[c], transform(in[i]));
+                     out[i] = running;
+                     for (i++; i < end; i++)
+                     {
+                         running = op(running, transform(in[i]));
+                         out[i] = running;
+                     }
+                 });
+}
+
+template <typename T, typename U, typename Op>
+void inclusive_scan(Span<T> in, Span<U> out, Op op, const Schedule& schedule = Schedule())
+{
+    transform_inclusive_scan(in, out, op, [](const T& x) { return x; }, schedule);
+}
+
+template <typename T, typename F>
+class Pipeline;
+
+template <typename T, typename F>
+Pipeline<T, F> makePipeline(Span<T> in, F transform, const Schedule& schedule)
+{
+    return Pipeline<T, F>(in, transform, schedule);
+}
+
+// Lazily chained transforms over a span. Nothing runs until a terminal call
+// (reduce, writeTo, scanInto), which applies the whole chain to each element
+// in the same pass, e.g.
+//   from(values).transform(Multiplier(3)).transform(addOne).reduce(0LL, std::plus<>())
+// reads values once and writes nothing but the chunk partials.
+template <typename T, typename F>
+class Pipeline
+{
+   private:
+    Span<T> input;
+    F chain;  // Every transform so far, composed
+    Schedule schedule;
+
+   public:
+    Pipeline(Span<T> input, F chain, const Schedule& schedule)
+        : input(input), chain(chain), schedule(schedule)
+    {
+    }
+
+    template <typename G>
+    auto transform(G next) const
+    {
+        F first = chain;
+        return makePipeline(input, [first, next](const T& x) { return next(first(x)); },
+                            schedule);
+    }
+
+    template <typename Init, typename Reduce>
+    Init reduce(Init init, Reduce op) const
+    {
+        return transform_reduce(input, init, op, chain, schedule);
+    }
+
+    // out[i] = chain(in[i])
+    template <typename U>
+    void writeTo(Span<U> out) const
+    {
+        if (out.size() < input.size())
+            throw std::invalid_argument("Pipeline::writeTo: output shorter than input");
+        Span<T> in = input;
+        const F& f = chain;
+        parallel_for(in.size(), [&](size_t i) { out[i] = f(in[i]); }, schedule);
+    }
+
+    template <typename U, typename Op>
+    void scanInto(Span<U> out, Op op) const
+    {
+        transform_inclusive_scan(input, out, op, chain, schedule);
+    }
+};
+
+template <typename T>
+auto from(Span<T> in, const Schedule& schedule = Schedule())
+{
+    return makePipeline(in, [](const T& x) { return x; }, schedule);
+}
+
+}  // namespace data_parallel
+
+#endif
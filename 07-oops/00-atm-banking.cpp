@@ -1,6 +1,17 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
 #include <iostream>
-#include <limits>
 #include <memory>
+#include <mutex>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "../09-STL/fast-input.h"
+#include "account-ledger.h"
+#include "ledger-journal.h"
 
 class Bank_Account
 {
@@ -70,34 +81,178 @@ class Bank_Account
     }
 };
 
-void clear_input()
-{
-    std::cin.clear();
-    std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
-}
-
+// Prompts until a positive amount is entered; 0 once input has ended (callers reject it)
 double get_positive_amount(const std::string& prompt)
 {
     double amount;
     while (true)
     {
         std::cout << prompt;
-        std::cin >> amount;
-        if (std::cin.fail() || amount <= 0)
+        ReadStatus status = stdin_reader().read_line_value(amount);
+        if (status == ReadStatus::end_of_input) return 0;
+        if (status == ReadStatus::ok && amount > 0 && std::isfinite(amount)) return amount;
+        std::cout << "Invalid amount. Please enter a positive number.\n";
+    }
+}
+
+// Many accounts, many threads: striped per-transfer locking vs whole batches
+void ledger_demo()
+{
+    const std::size_t accounts = 100000;
+    std::vector<int> numbers(accounts);
+    std::vector<Cents> opening(accounts, 100000);  // $1000.00 each
+    for (std::size_t i = 0; i < accounts; i++) numbers[i] = static_cast<int>(700000 + i);
+    Account_Ledger ledger(numbers, opening);
+
+    auto random_transfers = [&](unsigned seed, std::size_t count)
+    {
+        std::mt19937 rng(seed);
+        std::vector<Transfer> transfers(count);
+        for (Transfer& t : transfers)
+            t = {static_cast<std::uint32_t>(rng() % accounts),
+                 static_cast<std::uint32_t>(rng() % accounts), static_cast<Cents>(rng() % 50000)};
+        return transfers;
+    };
+
+    const unsigned threads = 4;
+    const std::size_t per_thread = 500000;
+    std::vector<std::vector<Transfer>> work;
+    for (unsigned t = 0; t < threads; t++) work.push_back(random_transfers(t + 1, per_thread));
+
+    auto seconds_since = [](std::chrono::steady_clock::time_point start)
+    { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < threads; t++)
+        workers.emplace_back(
+            [&, t]
+            {
+                for (const Transfer& transfer : work[t]) ledger.transfer(transfer);
+            });
+    for (std::thread& worker : workers) worker.join();
+    double striped = seconds_since(start);
+
+    const std::size_t batch_size = 65536;
+    std::size_t applied = 0;
+    bool audits_ok = true;
+    start = std::chrono::steady_clock::now();
+    workers.clear();
+    std::mutex result_lock;
+    for (unsigned t = 0; t < threads; t++)
+        workers.emplace_back(
+            [&, t]
+            {
+                for (std::size_t i = 0; i < per_thread; i += batch_size)
+                {
+                    std::size_t count = std::min(batch_size, per_thread - i);
+                    Batch_Result result = ledger.submit_batch(work[t].data() + i, count);
+                    std::lock_guard<std::mutex> guard(result_lock);
+                    applied += result.applied;
+                    audits_ok = audits_ok && result.audit_ok;
+                }
+            });
+    for (std::thread& worker : workers) worker.join();
+    double batched = seconds_since(start);
+
+    double total = static_cast<double>(threads * per_thread);
+    std::cout << "Ledger with " << accounts << " accounts, " << threads << " threads\n";
+    std::cout << "  striped transfers: " << total / striped / 1e6 << " M/s\n";
+    std::cout << "  batched transfers: " << total / batched / 1e6 << " M/s (" << applied
+              << " applied, every batch audit ok: " << audits_ok << ")\n";
+    std::cout << "  final audit ok: " << ledger.audit() << ", total $" << ledger.total() / 100
+              << '\n';
+}
+
+// Durable ledger: group-committed WAL, a snapshot, then recovery from both
+void journal_demo()
+{
+    namespace fs = std::filesystem;
+    const fs::path directory = fs::temp_directory_path() / "atm-ledger-demo";
+    fs::remove_all(directory);
+    fs::create_directories(directory);
+
+    const std::size_t accounts = 100000;
+    std::vector<int> numbers(accounts);
+    std::vector<Cents> opening(accounts, 100000);
+    for (std::size_t i = 0; i < accounts; i++) numbers[i] = static_cast<int>(700000 + i);
+
+    std::mt19937 rng(42);
+    auto random_batch = [&](std::size_t count)
+    {
+        std::vector<Transfer> transfers(count);
+        for (Transfer& t : transfers)
+            t = {static_cast<std::uint32_t>(rng() % accounts),
+                 static_cast<std::uint32_t>(rng() % accounts), static_cast<Cents>(rng() % 50000)};
+        return transfers;
+    };
+    auto seconds_since = [](std::chrono::steady_clock::time_point start)
+    { return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count(); };
+
+    Journal_Options options;
+    options.snapshot_every = 0;  // Snapshot by hand below
+    std::vector<Cents> expected(accounts);
+    std::uint64_t snapshot_sequence = 0;
+    {
+        Journaled_Ledger ledger(directory.string(), numbers, opening, options);
+        const std::size_t total = 1000000;
+        const std::size_t batch_size = 4096;
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t done = 0; done < total; done += batch_size)
         {
-            std::cout << "Invalid amount. Please enter a positive number.\n";
-            clear_input();
+            std::vector<Transfer> batch = random_batch(std::min(batch_size, total - done));
+            ledger.submit_batch(batch.data(), batch.size());
         }
-        else
+        ledger.commit();
+        double logged = seconds_since(start);
+        std::cout << "Journaled ledger: " << ledger.last_sequence() << " records durable in "
+                  << logged << " s (" << total / logged / 1e6 << " M transfers/s, "
+                  << fs::file_size(directory / "ledger.wal") / (1 << 20) << " MB WAL)\n";
+
+        start = std::chrono::steady_clock::now();
+        ledger.snapshot();
+        snapshot_sequence = ledger.last_sequence();
+        std::cout << "  snapshot at sequence " << snapshot_sequence << " in "
+                  << seconds_since(start) * 1e3 << " ms\n";
+
+        for (std::size_t i = 0; i < 50000; i++) ledger.transfer(random_batch(1)[0]);
+        for (std::size_t i = 0; i < accounts; i++)
+            expected[i] = ledger.balance(static_cast<std::uint32_t>(i));
+    }  // Closing commits the tail
+
+    auto start = std::chrono::steady_clock::now();
+    Journaled_Ledger reopened(directory.string(), numbers, opening, options);
+    double reopen = seconds_since(start);
+    bool same = true;
+    for (std::size_t i = 0; i < accounts; i++)
+        same = same && reopened.balance(static_cast<std::uint32_t>(i)) == expected[i];
+    const Recovery_Stats& stats = reopened.recovery();
+    std::cout << "  recovered in " << reopen * 1e3 << " ms: snapshot " << stats.snapshot_sequence
+              << " + " << stats.replayed_records << " replayed, balances match: " << same
+              << ", audit ok: " << reopened.audit() << '\n';
+}
+
+// `--ledger-demo` and `--journal-demo` run those benchmarks instead of the ATM menu
+// (the journal one writes and syncs about 26 MB under the temp directory)
+int main(int argc, char** argv)
+{
+    bool demo = false;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string_view arg = argv[i];
+        if (arg == "--ledger-demo")
         {
-            clear_input();
-            return amount;
+            ledger_demo();
+            demo = true;
+        }
+        else if (arg == "--journal-demo")
+        {
+            journal_demo();
+            demo = true;
         }
     }
-}
+    if (demo) return 0;
 
-int main()
-{
     std::string username = "Shaikh";
     auto user_account = std::make_unique<Bank_Account>(759654, 100.0);
     auto friend_account = std::make_unique<Bank_Account>(123456, 50.0);  // Example recipient
@@ -114,9 +269,9 @@ int main()
         std::cout << "5: Exit\n";
         std::cout << "Enter your choice: ";
 
-        int choice;
-        std::cin >> choice;
-        clear_input();
+        int choice = 0;
+        ReadStatus status = stdin_reader().read_line_value(choice);
+        if (status == ReadStatus::end_of_input) choice = 5;  // Closed input: leave, don't spin
 
         switch (choice)
         {
@@ -20,9 +20,16 @@
  * type of the object pointed to by a base class pointer or reference.
  */
 
-#include <iostream>  // For input/output operations (e.g., std::cout)
-#include <string>    // For std::string
-#include <vector>    // For std::vector (useful for collections of polymorphic objects)
+#include <algorithm>  // For std::sort (benchmark percentiles)
+#include <chrono>     // For timing the loggers
+#include <fstream>    // For std::ofstream ("/dev/null" sink in the benchmark)
+#include <random>     // For the random scene in benchmarkShapes()
+#include <iostream>   // For input/output operations (e.g., std::cout)
+#include <string>     // For std::string
+#include <vector>     // For std::vector (useful for collections of polymorphic objects)
+#include "async-logger.h"
+#include "shape-batch.h"
+#include "vector2d-array.h"
 
 // Use the standard namespace to avoid prefixing std::
 using namespace std;
@@ -38,21 +45,34 @@ using namespace std;
  * -   Log a message with a severity level.
  *
  * The compiler determines which 'log' function to call based on the arguments provided.
+ *
+ * The overloads only pick what to record; the work happens in AsyncLogger
+ * (async-logger.h), so a call copies its arguments and returns without
+ * formatting, writing or flushing on the calling thread.
  */
 class Logger
 {
+   private:
+    AsyncLogger& backend;
+
    public:
+    /**
+     * @brief Creates a Logger that records into backend.
+     * @param backend The asynchronous logger that formats and writes the lines.
+     */
+    explicit Logger(AsyncLogger& backend) : backend(backend) {}
+
     /**
      * @brief Logs a simple message.
      * @param message The string message to log.
      */
-    void log(const string& message) const { cout << "[INFO]: " << message << endl; }
+    void log(const string& message) const { backend.log<LogLevel::info>(message); }
 
     /**
      * @brief Logs an integer value.
      * @param value The integer value to log.
      */
-    void log(int value) const { cout << "[INFO]: Numeric value: " << value << endl; }
+    void log(int value) const { backend.log<LogLevel::info>("Numeric value: ", value); }
 
     /**
      * @brief Logs a message with a specified severity.
@@ -60,11 +80,73 @@ class Logger
      * @param message The string message to log.
      */
     void log(const string& severity, const string& message) const
+    {
+        backend.write(async_logger_detail::levelFromName(severity), "[", severity, "]: ", message);
+    }
+};
+
+/**
+ * @brief The original synchronous Logger, kept as the baseline for benchmarkLogger().
+ *
+ * Every call formats, writes and flushes (`endl`) on the calling thread.
+ */
+class ConsoleLogger
+{
+   public:
+    void log(const string& message) const { cout << "[INFO]: " << message << endl; }
+    void log(int value) const { cout << "[INFO]: Numeric value: " << value << endl; }
+    void log(const string& severity, const string& message) const
     {
         cout << "[" << severity << "]: " << message << endl;
     }
 };
 
+/**
+ * @brief Per-call latency of ConsoleLogger vs Logger, both writing to /dev/null.
+ *
+ * Build with optimizations, e.g. g++ -O2 -std=c++17 -pthread 05-polymorphism.cpp
+ */
+void benchmarkLogger()
+{
+    const int calls = 200000;
+    vector<double> latencies(calls);
+    auto percentiles = [&](const char* name)
+    {
+        vector<double> sorted = latencies;
+        sort(sorted.begin(), sorted.end());
+        cout << name << ": p50 " << sorted[calls / 2] << " ns, p99 " << sorted[calls * 99 / 100]
+             << " ns" << endl;
+    };
+    auto timeCalls = [&](auto&& logOnce)
+    {
+        for (int i = 0; i < calls; i++)
+        {
+            auto start = chrono::steady_clock::now();
+            logOnce(i);
+            auto elapsed = chrono::steady_clock::now() - start;
+            latencies[i] = chrono::duration<double, nano>(elapsed).count();
+        }
+    };
+
+    ofstream devNull("/dev/null");
+    streambuf* console = cout.rdbuf(devNull.rdbuf());  // ConsoleLogger hard-codes cout
+    ConsoleLogger syncLogger;
+    timeCalls([&](int i) { syncLogger.log("Transaction " + to_string(i) + " ok"); });
+    cout.rdbuf(console);
+    percentiles("ConsoleLogger (cout + endl)");
+
+    ofstream asyncOut("/dev/null");
+    AsyncLogger backend(asyncOut);
+    Logger asyncLogger(backend);
+    timeCalls([&](int i) { asyncLogger.log("Transaction " + to_string(i) + " ok"); });
+    auto start = chrono::steady_clock::now();
+    backend.flush();
+    double drain = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    percentiles("Logger (AsyncLogger)");
+    cout << "  remaining lines written by flush() in " << drain << " ms, " << backend.linesWritten()
+         << " lines in total" << endl;
+}
+
 // --- 2. Compile-time Polymorphism (Operator Overloading) ---
 /**
  * @section Operator Overloading
@@ -144,6 +226,13 @@ class Shape
      */
     virtual void draw() const = 0;  // Pure virtual function
 
+    /**
+     * @brief Pure virtual functions for the shape's geometry.
+     * @return The area and the perimeter (circumference for a circle).
+     */
+    virtual double area() const = 0;
+    virtual double perimeter() const = 0;
+
     /**
      * @brief Displays the shape's color.
      */
@@ -184,6 +273,9 @@ class Circle : public Shape
         cout << "Drawing a " << color << " Circle with radius " << radius << endl;
     }
 
+    double area() const override { return shape_geometry::circleArea(radius); }
+    double perimeter() const override { return shape_geometry::circlePerimeter(radius); }
+
     ~Circle() override { cout << "Circle destructor called." << endl; }
 };
 
@@ -217,6 +309,9 @@ class Rectangle : public Shape
              << height << endl;
     }
 
+    double area() const override { return shape_geometry::rectangleArea(width, height); }
+    double perimeter() const override { return shape_geometry::rectanglePerimeter(width, height); }
+
     ~Rectangle() override { cout << "Rectangle destructor called." << endl; }
 };
 
@@ -250,9 +345,165 @@ class Triangle : public Shape
              << triangleHeight << endl;
     }
 
+    double area() const override { return shape_geometry::triangleArea(base, triangleHeight); }
+
+    /**
+     * @brief Perimeter of the isosceles triangle with this base and height.
+     */
+    double perimeter() const override
+    {
+        return shape_geometry::trianglePerimeter(base, triangleHeight);
+    }
+
     ~Triangle() override { cout << "Triangle destructor called." << endl; }
 };
 
+
+/**
+ * @brief Batch vector math on 500,000 vectors: scalar Vector2D objects vs Vector2DArray, and a
+ * fused expression vs the same math through a temporary array.
+ */
+void benchmarkVector2D()
+{
+    const size_t n = 500000;
+    const int repeats = 20;
+    vector<Vector2D> aosA(n), aosB(n), aosC(n);
+    Vector2DArray a(n), b(n), c(n);
+    mt19937 rng(7);
+    uniform_real_distribution<double> value(-1.0, 1.0);
+    for (size_t i = 0; i < n; i++)
+    {
+        double ax = value(rng), ay = value(rng), bx = value(rng), by = value(rng);
+        aosA[i] = Vector2D(ax, ay);
+        aosB[i] = Vector2D(bx, by);
+        a.set(i, ax, ay);
+        b.set(i, bx, by);
+    }
+    auto nanosecondsPerVector = [&](auto&& work)
+    {
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) work();
+        return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() /
+               (double(repeats) * n);
+    };
+
+    // Each pass accumulates into c, so repeated passes cannot be folded into one
+    double objects = nanosecondsPerVector(
+        [&]
+        {
+            for (size_t i = 0; i < n; i++) aosC[i] = aosC[i] + aosA[i];
+        });
+    double columns = nanosecondsPerVector([&] { c = c + a; });
+    double fused = nanosecondsPerVector([&] { c = c + b * 0.5; });
+    double temporary = nanosecondsPerVector(
+        [&]
+        {
+            Vector2DArray scaled = b * 0.5;  // What a library without expression templates does
+            c = c + scaled;
+        });
+    double dotSum = 0;
+    double dotTime = nanosecondsPerVector([&] { dotSum += dot(a, b); });
+    Vector2DArray unit = a;
+    double normalizeTime = nanosecondsPerVector([&] { unit.normalize(); });
+    vector<double> lengths(n);
+    double lengthTime = nanosecondsPerVector([&] { unit.lengths(lengths.data()); });
+
+    cout << "Vector math, ns per vector (" << n << " vectors):\n";
+    cout << "  vector<Vector2D> c + a: " << objects << ", Vector2DArray c + a: " << columns
+         << '\n';
+    cout << "  c + b * s fused: " << fused << ", with a temporary array: " << temporary << '\n';
+    cout << "  dot(a, b): " << dotTime << ", normalize: " << normalizeTime
+         << ", lengths: " << lengthTime << " (all unit length: "
+         << all_of(lengths.begin(), lengths.end(), [](double l) { return abs(l - 1) < 1e-12; })
+         << ", dot sum " << dotSum << ")" << endl;
+}
+
+/**
+ * @brief Total area and perimeter of a million random shapes, three ways:
+ * virtual calls through Shape*, the type-sorted ShapeScene, and std::variant.
+ *
+ * Build with optimizations, e.g. g++ -O2 -std=c++17 -pthread 05-polymorphism.cpp
+ */
+void benchmarkShapes()
+{
+    const size_t count = 1000000;
+    const char* palette[] = {"Red", "Green", "Blue", "Yellow"};
+    mt19937 rng(2024);
+    uniform_real_distribution<double> size(0.5, 10.0);
+
+    vector<Shape*> pointers;
+    ShapeScene scene;
+    ColorTable variantColors;
+    vector<ShapeValue> values;
+    pointers.reserve(count);
+    values.reserve(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        const char* color = palette[rng() % 4];
+        double a = size(rng);
+        double b = size(rng);
+        uint32_t colorId = variantColors.intern(color);
+        switch (rng() % 3)
+        {
+            case 0:
+                pointers.push_back(new Circle(color, a));
+                scene.addCircle(color, a);
+                values.push_back(CircleValue{a, colorId});
+                break;
+            case 1:
+                pointers.push_back(new Rectangle(color, a, b));
+                scene.addRectangle(color, a, b);
+                values.push_back(RectangleValue{a, b, colorId});
+                break;
+            default:
+                pointers.push_back(new Triangle(color, a, b));
+                scene.addTriangle(color, a, b);
+                values.push_back(TriangleValue{a, b, colorId});
+        }
+    }
+
+    auto millisecondsFor = [](auto&& work, double& result)
+    {
+        const int repeats = 10;
+        auto start = chrono::steady_clock::now();
+        for (int r = 0; r < repeats; r++) result = work();
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count() /
+               repeats;
+    };
+    double virtualSum = 0, sceneSum = 0, variantSum = 0;
+    double virtualTime = millisecondsFor(
+        [&]
+        {
+            double sum = 0;
+            for (const Shape* shape : pointers) sum += shape->area() + shape->perimeter();
+            return sum;
+        },
+        virtualSum);
+    double sceneTime =
+        millisecondsFor([&] { return scene.totalArea() + scene.totalPerimeter(); }, sceneSum);
+    double variantTime =
+        millisecondsFor([&] { return totalArea(values) + totalPerimeter(values); }, variantSum);
+    groupByType(values);
+    double groupedSum = 0;
+    double groupedTime =
+        millisecondsFor([&] { return totalArea(values) + totalPerimeter(values); }, groupedSum);
+
+    cout << "Area + perimeter of " << count << " shapes:\n";
+    cout << "  virtual Shape*: " << virtualTime << " ms\n";
+    cout << "  ShapeScene:     " << sceneTime << " ms (" << virtualTime / sceneTime << "x)\n";
+    cout << "  variant:        " << variantTime << " ms (" << virtualTime / variantTime << "x)\n";
+    cout << "  variant, grouped by type: " << groupedTime << " ms ("
+         << virtualTime / groupedTime << "x)\n";
+    auto close = [&](double sum) { return abs(sum - virtualSum) < 1e-9 * virtualSum; };
+    cout << "  results agree: " << (close(sceneSum) && close(variantSum) && close(groupedSum))
+         << ", red area " << scene.areaOfColor("Red") << endl;
+
+    ofstream devNull("/dev/null");
+    streambuf* console = cout.rdbuf(devNull.rdbuf());  // The destructors print
+    for (Shape* shape : pointers) delete shape;
+    cout.rdbuf(console);
+}
+
 /**
  * @brief Main function to demonstrate different types of polymorphism.
  */
@@ -264,10 +515,16 @@ int main()
 
     // --- Compile-time Polymorphism (Function Overloading) Example ---
     cout << "--- Function Overloading (Compile-time Polymorphism) ---\n";
-    Logger myLogger;
-    myLogger.log("Application started successfully.");  // Calls log(const string&)
-    myLogger.log(12345);                                // Calls log(int)
-    myLogger.log("WARNING", "Disk space is low.");      // Calls log(const string&, const string&)
+    {
+        // The logger thread owns cout until backend is destroyed at the end of this block,
+        // so nothing else may print (or swap cout's buffer, as benchmarkLogger does) in here
+        AsyncLogger backend(cout);
+        Logger myLogger(backend);
+        myLogger.log("Application started successfully.");  // Calls log(const string&)
+        myLogger.log(12345);                                // Calls log(int)
+        myLogger.log("WARNING", "Disk space is low.");  // Calls log(const string&, const string&)
+    }  // ~AsyncLogger writes the remaining lines and joins its thread
+    benchmarkLogger();
     cout << "\n";
 
     // --- Compile-time Polymorphism (Operator Overloading) Example ---
@@ -284,6 +541,15 @@ int main()
     cout << "Vector Sum (vec1 + vec2): ";
     vecSum.display();
     cout << endl;
+
+    // The same '+' on whole arrays of vectors, evaluated in one fused loop (vector2d-array.h)
+    Vector2DArray positions(3, 1.0, 2.0);
+    Vector2DArray velocities(3, 3.0, 4.0);
+    positions = positions + velocities * 0.5;  // One loop, no temporary arrays
+    cout << "Array step (p + v * 0.5): (" << positions.x(0) << ", " << positions.y(0)
+         << ") for each of " << positions.size() << " vectors, dot(p, v) = "
+         << dot(positions, velocities) << endl;
+    benchmarkVector2D();
     cout << "\n";
 
     // --- Run-time Polymorphism (Virtual Functions and Abstract Classes) Example ---
@@ -319,6 +585,17 @@ int main()
     }
     shapes.clear();  // Clear the vector after deleting objects
 
+    // The same shapes stored by type instead of behind base pointers (shape-batch.h)
+    cout << "\nData-oriented ShapeScene (no virtual calls):\n";
+    ShapeScene scene;
+    scene.addCircle("Red", 5.0);
+    scene.addRectangle("Blue", 10.0, 7.0);
+    scene.addTriangle("Green", 6.0, 8.0);
+    scene.drawAll(cout);
+    cout << "Total area: " << scene.totalArea() << ", total perimeter: " << scene.totalPerimeter()
+         << endl;
+    benchmarkShapes();
+
     cout << "\n*****************************************************\n";
     cout << "           Polymorphism Demonstration End            \n";
     cout << "*****************************************************\n";
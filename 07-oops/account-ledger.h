@@ -0,0 +1,251 @@
+#ifndef ACCOUNT_LEDGER_H
+#define ACCOUNT_LEDGER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#if __cplusplus >= 202002L
+#include <span>
+#endif
+
+/*
+ * Thread-safe store for many accounts, the multi-user counterpart of
+ * Bank_Account in 00-atm-banking.cpp.
+ *
+ * - Money is integer cents, so sums are exact (no double rounding).
+ * - Struct of arrays: balances and account numbers live in separate
+ *   contiguous vectors indexed by account id (0 .. size() - 1).
+ * - Account id i is guarded by stripe i % stripe_count. A transfer locks the
+ *   two stripes in ascending stripe order, so two transfers can never wait
+ *   on each other in a cycle (no deadlock), and debit + credit happen as one
+ *   step under both locks.
+ * - submit_batch() is the single-writer path: it takes every stripe once,
+ *   applies the whole batch with no per-transfer locking, audits the total
+ *   and only then releases the stripes.
+ * Nothing is printed; every operation reports a Transfer_Status.
+ */
+
+using Cents = std::int64_t;
+
+struct Transfer
+{
+    std::uint32_t from;
+    std::uint32_t to;
+    Cents amount;
+};
+
+enum class Transfer_Status : std::uint8_t
+{
+    ok,
+    invalid_amount,      // amount <= 0
+    same_account,        // from == to
+    unknown_account,     // id >= size()
+    insufficient_funds,  // would leave the source negative
+};
+
+struct Batch_Result
+{
+    std::size_t applied = 0;
+    std::size_t rejected = 0;
+    Cents moved = 0;        // Sum of the applied amounts
+    bool audit_ok = false;  // Total of all balances unchanged by the batch
+};
+
+class Account_Ledger
+{
+   public:
+    static constexpr std::size_t stripe_count = 256;
+
+   private:
+    struct alignas(64) Stripe  // One cache line each, so stripes do not false-share
+    {
+        std::mutex lock;
+    };
+
+    std::vector<Cents> balances;        // balances[id]
+    std::vector<int> account_numbers;   // account_numbers[id]
+    std::unique_ptr<Stripe[]> stripes;  // stripes[id % stripe_count] guards id
+    mutable std::mutex total_lock;      // Guards expected_total; taken after stripes
+    Cents expected_total = 0;           // Changed only by deposit() / withdraw()
+
+    static std::size_t stripe_of(std::uint32_t id) { return id % stripe_count; }
+
+    bool known(std::uint32_t id) const { return id < balances.size(); }
+
+    // Validates t and moves the money; caller holds the stripes of t.from and t.to
+    Transfer_Status apply(const Transfer& t)
+    {
+        if (t.amount <= 0) return Transfer_Status::invalid_amount;
+        if (!known(t.from) || !known(t.to)) return Transfer_Status::unknown_account;
+        if (t.from == t.to) return Transfer_Status::same_account;
+        if (balances[t.from] < t.amount) return Transfer_Status::insufficient_funds;
+        balances[t.from] -= t.amount;
+        balances[t.to] += t.amount;
+        return Transfer_Status::ok;
+    }
+
+    void lock_all()
+    {
+        for (std::size_t s = 0; s < stripe_count; s++) stripes[s].lock.lock();
+    }
+
+    void unlock_all()
+    {
+        for (std::size_t s = stripe_count; s-- > 0;) stripes[s].lock.unlock();
+    }
+
+    // Sum of all balances; caller holds every stripe
+    Cents sum_balances() const
+    {
+        Cents sum = 0;
+        for (Cents balance : balances) sum += balance;
+        return sum;
+    }
+
+   public:
+    /*
+     * One account per entry; account id i gets numbers[i] and
+     * initial_cents[i]. Throws std::invalid_argument if the sizes differ or
+     * a balance is negative.
+     */
+    Account_Ledger(const std::vector<int>& numbers, const std::vector<Cents>& initial_cents)
+        : balances(initial_cents), account_numbers(numbers), stripes(new Stripe[stripe_count])
+    {
+        if (numbers.size() != initial_cents.size())
+            throw std::invalid_argument("Account_Ledger: one balance per account number expected");
+        for (Cents balance : balances)
+        {
+            if (balance < 0) throw std::invalid_argument("Account_Ledger: negative balance");
+            expected_total += balance;
+        }
+    }
+
+    Account_Ledger(const Account_Ledger&) = delete;
+    Account_Ledger& operator=(const Account_Ledger&) = delete;
+
+    std::size_t size() const { return balances.size(); }
+    int account_no(std::uint32_t id) const { return account_numbers.at(id); }
+
+    // Throws std::out_of_range for an unknown id
+    Cents balance(std::uint32_t id)
+    {
+        if (!known(id)) throw std::out_of_range("Account_Ledger::balance: unknown account");
+        std::lock_guard<std::mutex> guard(stripes[stripe_of(id)].lock);
+        return balances[id];
+    }
+
+    Transfer_Status deposit(std::uint32_t id, Cents amount)
+    {
+        if (amount <= 0) return Transfer_Status::invalid_amount;
+        if (!known(id)) return Transfer_Status::unknown_account;
+        std::lock_guard<std::mutex> guard(stripes[stripe_of(id)].lock);
+        std::lock_guard<std::mutex> total(total_lock);
+        balances[id] += amount;
+        expected_total += amount;
+        return Transfer_Status::ok;
+    }
+
+    Transfer_Status withdraw(std::uint32_t id, Cents amount)
+    {
+        if (amount <= 0) return Transfer_Status::invalid_amount;
+        if (!known(id)) return Transfer_Status::unknown_account;
+        std::lock_guard<std::mutex> guard(stripes[stripe_of(id)].lock);
+        if (balances[id] < amount) return Transfer_Status::insufficient_funds;
+        std::lock_guard<std::mutex> total(total_lock);
+        balances[id] -= amount;
+        expected_total -= amount;
+        return Transfer_Status::ok;
+    }
+
+    // Moves t.amount from t.from to t.to atomically with respect to every other operation
+    Transfer_Status transfer(const Transfer& t)
+    {
+        if (!known(t.from) || !known(t.to)) return Transfer_Status::unknown_account;
+        std::size_t first = stripe_of(t.from);
+        std::size_t second = stripe_of(t.to);
+        if (first > second) std::swap(first, second);  // Fixed global order
+        std::lock_guard<std::mutex> lock_first(stripes[first].lock);
+        if (first == second) return apply(t);
+        std::lock_guard<std::mutex> lock_second(stripes[second].lock);
+        return apply(t);
+    }
+
+    /*
+     * Applies transfers[0 .. count) in order as one exclusive batch and audits
+     * the ledger before anyone else can see it. If statuses is not null,
+     * statuses[i] receives the outcome of transfers[i].
+     */
+    Batch_Result submit_batch(const Transfer* transfers, std::size_t count,
+                              Transfer_Status* statuses = nullptr)
+    {
+        Batch_Result result;
+        lock_all();
+        std::lock_guard<std::mutex> total(total_lock);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            Transfer_Status status = apply(transfers[i]);
+            if (statuses) statuses[i] = status;
+            if (status == Transfer_Status::ok)
+            {
+                result.applied++;
+                result.moved += transfers[i].amount;
+            }
+            else
+            {
+                result.rejected++;
+            }
+        }
+        result.audit_ok = sum_balances() == expected_total;
+        unlock_all();
+        return result;
+    }
+
+    Batch_Result submit_batch(const std::vector<Transfer>& transfers,
+                              std::vector<Transfer_Status>* statuses = nullptr)
+    {
+        if (statuses) statuses->resize(transfers.size());
+        return submit_batch(transfers.data(), transfers.size(),
+                            statuses ? statuses->data() : nullptr);
+    }
+
+#if __cplusplus >= 202002L
+    Batch_Result submit_batch(std::span<const Transfer> transfers)
+    {
+        return submit_batch(transfers.data(), transfers.size());
+    }
+#endif
+
+    // True if the balances add up to everything deposited minus withdrawn
+    bool audit()
+    {
+        lock_all();
+        bool ok;
+        {
+            std::lock_guard<std::mutex> total(total_lock);
+            ok = sum_balances() == expected_total;
+        }
+        unlock_all();
+        return ok;
+    }
+
+    // Copies every balance into out[0 .. size()) as one consistent picture
+    void copy_balances(Cents* out)
+    {
+        lock_all();
+        std::copy(balances.begin(), balances.end(), out);
+        unlock_all();
+    }
+
+    Cents total() const
+    {
+        std::lock_guard<std::mutex> guard(total_lock);
+        return expected_total;
+    }
+};
+
+#endif
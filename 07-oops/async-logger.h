@@ -0,0 +1,455 @@
+#ifndef ASYNC_LOGGER_H
+#define ASYNC_LOGGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+ * Asynchronous logger: a log call only copies its arguments into a ring
+ * buffer owned by the calling thread; a background thread turns them into
+ * text and writes everything collected with one write + flush per pass.
+ *
+ * - Each thread gets its own single-producer / single-consumer byte ring,
+ *   so logging threads never contend with each other and never lock.
+ * - Formatting is deferred: a record holds the raw argument bytes plus a
+ *   pointer to a formatter instantiated for exactly those argument types.
+ * - log<Level>() for a level below LOGGER_MIN_LEVEL compiles to nothing
+ *   (build with e.g. -DLOGGER_MIN_LEVEL=2 to strip debug and info). The
+ *   arguments at the call site are still evaluated.
+ * - A full ring makes its producer wait for the flusher ("block" policy);
+ *   nothing is dropped. A single record larger than half the ring is
+ *   replaced by a short "message too long" line.
+ * - flush() returns once everything logged before it has been written, and
+ *   the destructor does a final drain. Log calls racing with destruction
+ *   are not allowed.
+ *
+ * Lines from one thread keep their order; lines from different threads are
+ * interleaved in the order the flusher visits the rings.
+ * Accepted argument types: integers, floating point, bool, char, and
+ * strings (std::string, std::string_view, const char*), which are copied.
+ */
+
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
+
+enum class LogLevel : std::uint8_t
+{
+    debug,
+    info,
+    warning,
+    error,
+};
+
+constexpr LogLevel kMinLogLevel = static_cast<LogLevel>(LOGGER_MIN_LEVEL);
+
+namespace async_logger_detail
+{
+inline const char* levelPrefix(LogLevel level)
+{
+    switch (level)
+    {
+        case LogLevel::debug:
+            return "[DEBUG]: ";
+        case LogLevel::info:
+            return "[INFO]: ";
+        case LogLevel::warning:
+            return "[WARNING]: ";
+        default:
+            return "[ERROR]: ";
+    }
+}
+
+// "DEBUG", "INFO", "WARNING" or "ERROR" (any case); anything else counts as info
+inline LogLevel levelFromName(std::string_view name)
+{
+    auto is = [name](std::string_view level)
+    {
+        if (name.size() != level.size()) return false;
+        for (std::size_t i = 0; i < name.size(); i++)
+            if ((name[i] | 0x20) != (level[i] | 0x20)) return false;
+        return true;
+    };
+    if (is("debug")) return LogLevel::debug;
+    if (is("warning")) return LogLevel::warning;
+    if (is("error")) return LogLevel::error;
+    return LogLevel::info;
+}
+
+using Formatter = void (*)(const char* payload, std::string& out);
+
+// Fixed part of every record in a ring; the encoded arguments follow it
+struct RecordHeader
+{
+    std::uint32_t size;    // Whole record, header included, a multiple of 8
+    std::uint8_t kind;     // One of the constants below
+    std::uint8_t level;
+    std::uint8_t unused[2];
+    Formatter format;
+};
+
+constexpr std::uint8_t kPadding = 0;   // Skip to the start of the ring
+constexpr std::uint8_t kPrefixed = 1;  // "[LEVEL]: " + arguments
+constexpr std::uint8_t kPlain = 2;     // Arguments only
+constexpr std::size_t kAlign = 8;
+
+constexpr std::size_t roundUp(std::size_t n) { return (n + kAlign - 1) & ~(kAlign - 1); }
+
+// ring_size rounded up to a power of two, at least 256
+inline std::size_t ringCapacity(std::size_t ring_size)
+{
+    std::size_t capacity = 256;
+    while (capacity < ring_size) capacity *= 2;
+    return capacity;
+}
+
+struct StringArg  // How every string-like argument is stored: length, then the bytes
+{
+};
+
+// The stored form of an argument type
+template <class T, class = void>
+struct Stored
+{
+    using type = StringArg;  // Anything convertible to std::string_view
+};
+
+template <class T>
+struct Stored<T, std::enable_if_t<std::is_arithmetic<T>::value>>
+{
+    using type = T;
+};
+
+template <class T>
+using StoredType = typename Stored<std::decay_t<T>>::type;
+
+template <class T>
+struct Codec
+{
+    static std::size_t size(const T&) { return sizeof(T); }
+
+    static char* encode(char* at, const T& value)
+    {
+        std::memcpy(at, &value, sizeof(T));
+        return at + sizeof(T);
+    }
+
+    static void decode(const char*& at, std::string& out)
+    {
+        T value;
+        std::memcpy(&value, at, sizeof(T));
+        at += sizeof(T);
+        if constexpr (std::is_same<T, bool>::value)
+            out += value ? '1' : '0';  // As `cout << bool` prints it
+        else if constexpr (std::is_same<T, char>::value)
+            out += value;
+        else
+        {
+            char text[64];
+            std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+            out.append(text, result.ptr);
+        }
+    }
+};
+
+template <>
+struct Codec<StringArg>
+{
+    static std::size_t size(std::string_view text) { return sizeof(std::uint32_t) + text.size(); }
+
+    static char* encode(char* at, std::string_view text)
+    {
+        std::uint32_t length = static_cast<std::uint32_t>(text.size());
+        std::memcpy(at, &length, sizeof(length));
+        std::memcpy(at + sizeof(length), text.data(), text.size());
+        return at + sizeof(length) + text.size();
+    }
+
+    static void decode(const char*& at, std::string& out)
+    {
+        std::uint32_t length;
+        std::memcpy(&length, at, sizeof(length));
+        out.append(at + sizeof(length), length);
+        at += sizeof(length) + length;
+    }
+};
+
+template <class... Stored>
+void formatRecord(const char* payload, std::string& out)
+{
+    (Codec<Stored>::decode(payload, out), ...);  // Left to right, like the call
+}
+
+// One thread's staging ring. head and tail count bytes ever consumed / produced.
+struct ThreadBuffer
+{
+    explicit ThreadBuffer(std::size_t bytes) : capacity(bytes), data(new char[bytes]) {}
+
+    const std::size_t capacity;  // Power of two
+    std::unique_ptr<char[]> data;
+    alignas(64) std::atomic<std::uint64_t> head{0};  // Written by the flusher
+    alignas(64) std::atomic<std::uint64_t> tail{0};  // Written by the owning thread
+    std::atomic<bool> retired{false};                 // The owning thread has exited
+    std::atomic<bool> orphaned{false};                // The logger has been destroyed
+};
+
+// Per-thread list of the rings this thread owns, one per logger it has used
+struct ThreadRings
+{
+    std::vector<std::pair<std::uint64_t, std::shared_ptr<ThreadBuffer>>> rings;
+
+    ~ThreadRings()
+    {
+        for (auto& ring : rings) ring.second->retired.store(true, std::memory_order_release);
+    }
+};
+
+inline ThreadRings& threadRings()
+{
+    thread_local ThreadRings rings;
+    return rings;
+}
+
+inline std::atomic<std::uint64_t>& nextLoggerId()
+{
+    static std::atomic<std::uint64_t> id{1};
+    return id;
+}
+}  // namespace async_logger_detail
+
+class AsyncLogger
+{
+   private:
+    using ThreadBuffer = async_logger_detail::ThreadBuffer;
+    using RecordHeader = async_logger_detail::RecordHeader;
+
+    std::ostream& out;
+    const std::size_t ring_bytes;
+    const std::chrono::microseconds interval;
+    const std::uint64_t id = async_logger_detail::nextLoggerId()++;
+
+    std::mutex registry_lock;  // Guards buffers
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+    std::mutex state_lock;  // Guards the four fields below
+    std::condition_variable wake;
+    std::condition_variable drained;
+    std::uint64_t requested = 0;      // flush() tickets handed out
+    std::uint64_t completed = 0;      // Tickets whose drain pass has finished
+    std::uint64_t drains_wanted = 0;  // Bumped by producers that found their ring full
+    bool stopping = false;
+
+    std::atomic<std::uint64_t> lines{0};
+    std::string batch;  // Only touched by the flusher thread
+    std::thread flusher;
+
+    ThreadBuffer& localBuffer()
+    {
+        auto& rings = async_logger_detail::threadRings().rings;
+        for (auto& ring : rings)
+            if (ring.first == id) return *ring.second;
+        rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                   [](const auto& ring) { return ring.second->orphaned.load(); }),
+                    rings.end());
+        auto buffer = std::make_shared<ThreadBuffer>(ring_bytes);
+        {
+            std::lock_guard<std::mutex> guard(registry_lock);
+            buffers.push_back(buffer);
+        }
+        rings.emplace_back(id, buffer);
+        return *buffer;
+    }
+
+    // Reserves size bytes contiguously in the ring, waiting for the flusher if it is full
+    char* reserve(ThreadBuffer& ring, std::size_t size, std::uint64_t& tail)
+    {
+        tail = ring.tail.load(std::memory_order_relaxed);
+        std::size_t offset = static_cast<std::size_t>(tail & (ring.capacity - 1));
+        std::size_t padding = ring.capacity - offset < size ? ring.capacity - offset : 0;
+        while (tail + padding + size - ring.head.load(std::memory_order_acquire) > ring.capacity)
+        {
+            {
+                // Under the lock, so the flusher cannot miss it between its check and its wait
+                std::lock_guard<std::mutex> state(state_lock);
+                ++drains_wanted;
+            }
+            wake.notify_one();
+            std::this_thread::yield();
+        }
+        if (padding > 0)
+        {
+            RecordHeader skip{};
+            skip.size = static_cast<std::uint32_t>(padding);
+            skip.kind = async_logger_detail::kPadding;
+            std::memcpy(ring.data.get() + offset, &skip, sizeof(skip.size) + 1);
+            tail += padding;
+            offset = 0;
+        }
+        return ring.data.get() + offset;
+    }
+
+    template <class... Args>
+    void append(std::uint8_t kind, LogLevel level, const Args&... args)
+    {
+        using namespace async_logger_detail;
+        std::size_t payload = (std::size_t{0} + ... + Codec<StoredType<Args>>::size(args));
+        std::size_t size = roundUp(sizeof(RecordHeader) + payload);
+        if (size > ring_bytes / 2)
+        {
+            append(kind, level, "<message too long: ", payload, " bytes>");
+            return;
+        }
+        ThreadBuffer& ring = localBuffer();
+        std::uint64_t tail;
+        char* at = reserve(ring, size, tail);
+        RecordHeader header{};
+        header.size = static_cast<std::uint32_t>(size);
+        header.kind = kind;
+        header.level = static_cast<std::uint8_t>(level);
+        header.format = &formatRecord<StoredType<Args>...>;
+        std::memcpy(at, &header, sizeof(header));
+        at += sizeof(header);
+        ((at = Codec<StoredType<Args>>::encode(at, args)), ...);
+        ring.tail.store(tail + size, std::memory_order_release);
+    }
+
+    // Formats everything visible in one ring into batch
+    void drain(ThreadBuffer& ring)
+    {
+        std::uint64_t head = ring.head.load(std::memory_order_relaxed);
+        const std::uint64_t tail = ring.tail.load(std::memory_order_acquire);
+        while (head != tail)
+        {
+            const char* at = ring.data.get() + (head & (ring.capacity - 1));
+            RecordHeader header;
+            std::memcpy(&header, at, sizeof(header.size) + 1);
+            if (header.kind != async_logger_detail::kPadding)
+            {
+                std::memcpy(&header, at, sizeof(header));
+                if (header.kind == async_logger_detail::kPrefixed)
+                    batch += async_logger_detail::levelPrefix(static_cast<LogLevel>(header.level));
+                header.format(at + sizeof(header), batch);
+                batch += '\n';
+                lines.fetch_add(1, std::memory_order_relaxed);
+            }
+            head += header.size;
+            ring.head.store(head, std::memory_order_release);  // Frees the space at once
+        }
+    }
+
+    void drainAll()
+    {
+        std::vector<std::shared_ptr<ThreadBuffer>> snapshot;
+        {
+            std::lock_guard<std::mutex> guard(registry_lock);
+            snapshot = buffers;
+        }
+        for (auto& ring : snapshot) drain(*ring);
+        if (!batch.empty())
+        {
+            out.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            out.flush();
+            batch.clear();
+        }
+        // Forget rings whose thread has exited and whose records are all written
+        std::lock_guard<std::mutex> guard(registry_lock);
+        buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                     [](const std::shared_ptr<ThreadBuffer>& ring)
+                                     {
+                                         return ring->retired.load(std::memory_order_acquire) &&
+                                                ring->head.load() == ring->tail.load();
+                                     }),
+                      buffers.end());
+    }
+
+    void flusherLoop()
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        while (true)
+        {
+            const bool last = stopping;
+            const std::uint64_t ticket = requested;
+            const std::uint64_t wanted = drains_wanted;
+            state.unlock();
+            drainAll();
+            state.lock();
+            completed = ticket;
+            drained.notify_all();
+            if (last) return;
+            wake.wait_for(state, interval, [&]
+                          { return stopping || requested != ticket || drains_wanted != wanted; });
+        }
+    }
+
+   public:
+    /*
+     * Lines go to output, which only the flusher thread touches from now
+     * on. ring_size is the per-thread staging buffer, rounded up to a power
+     * of two; the flusher wakes at least every flush_interval.
+     */
+    explicit AsyncLogger(std::ostream& output, std::size_t ring_size = 1 << 18,
+                         std::chrono::microseconds flush_interval = std::chrono::milliseconds(1))
+        : out(output),
+          ring_bytes(async_logger_detail::ringCapacity(ring_size)),
+          interval(flush_interval)
+    {
+        flusher = std::thread([this] { flusherLoop(); });
+    }
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // Writes everything still buffered, then stops the flusher
+    ~AsyncLogger()
+    {
+        {
+            std::lock_guard<std::mutex> state(state_lock);
+            stopping = true;
+        }
+        wake.notify_one();
+        flusher.join();
+        for (auto& ring : buffers) ring->orphaned.store(true);
+    }
+
+    // "[LEVEL]: " followed by the arguments; nothing at all below kMinLogLevel
+    template <LogLevel Level, class... Args>
+    void log(const Args&... args)
+    {
+        if constexpr (Level >= kMinLogLevel)
+            append(async_logger_detail::kPrefixed, Level, args...);
+    }
+
+    // The arguments as one line, without a prefix; the level is checked at run time
+    template <class... Args>
+    void write(LogLevel level, const Args&... args)
+    {
+        if (level >= kMinLogLevel) append(async_logger_detail::kPlain, level, args...);
+    }
+
+    // Blocks until everything logged before the call has reached the output
+    void flush()
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        const std::uint64_t ticket = ++requested;
+        wake.notify_one();
+        drained.wait(state, [&] { return completed >= ticket; });
+    }
+
+    std::uint64_t linesWritten() const { return lines.load(std::memory_order_relaxed); }
+};
+
+#endif
@@ -0,0 +1,547 @@
+#ifndef LEDGER_JOURNAL_H
+#define LEDGER_JOURNAL_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "account-ledger.h"
+
+/*
+ * Durable Account_Ledger: every successful operation is appended to a
+ * binary write-ahead log (WAL) before it is reported durable, and the whole
+ * ledger is periodically written as a snapshot so the log can be emptied.
+ *
+ * Files in the journal directory (POSIX only):
+ *   ledger.wal       fixed-size Wal_Records, appended in sequence order
+ *   ledger.snapshot  Snapshot_Header + balances + account numbers
+ *
+ * Group commit: records collect in memory and are written with one write()
+ * and one fdatasync() per group, once group_commit_bytes are buffered or
+ * the oldest buffered record is group_commit_latency old (a background
+ * thread checks), or on commit(). durable_sequence() tells callers how far
+ * the disk has caught up.
+ *
+ * Recovery loads the snapshot (memory-mapped) and replays only the records
+ * after it, so start-up time grows with the WAL tail, not the history. A
+ * torn or corrupt record at the end of the log (crash mid-write) is cut off.
+ *
+ * All mutations are serialized through one mutex so that log order is
+ * exactly apply order; batch through submit_batch() for throughput. I/O
+ * failures throw std::system_error. Records use native byte order.
+ */
+
+struct Journal_Options
+{
+    std::size_t group_commit_bytes = 1 << 20;                // Flush at 1 MB buffered...
+    std::chrono::microseconds group_commit_latency{2000};    // ...or 2 ms after the first record
+    std::uint64_t snapshot_every = 1000000;                  // Records per snapshot, 0 = manual
+};
+
+struct Recovery_Stats
+{
+    std::uint64_t snapshot_sequence = 0;  // Last sequence contained in the snapshot
+    std::uint64_t replayed_records = 0;   // WAL records applied on top of it
+    bool torn_tail = false;               // A partial or corrupt record was cut off
+    double seconds = 0;
+};
+
+namespace journal_detail
+{
+enum Record_Kind : std::uint32_t
+{
+    deposit_record = 1,
+    withdraw_record = 2,
+    transfer_record = 3,
+};
+
+struct Wal_Record
+{
+    std::uint64_t sequence;  // 1, 2, 3, ... with no gaps
+    Cents amount;
+    std::uint32_t from;  // The account for deposits and withdrawals
+    std::uint32_t to;
+    std::uint32_t kind;
+    std::uint32_t checksum;  // fnv1a of the 28 bytes before it
+};
+static_assert(sizeof(Wal_Record) == 32, "WAL records are 32 bytes on disk");
+
+struct Snapshot_Header
+{
+    char magic[8];
+    std::uint64_t sequence;
+    std::uint64_t accounts;
+    std::uint64_t checksum;  // fnv1a of the balances and account numbers
+};
+static_assert(sizeof(Snapshot_Header) == 32, "Snapshot header is 32 bytes on disk");
+
+const char snapshot_magic[8] = {'L', 'E', 'D', 'G', 'S', 'N', 'P', '1'};
+
+inline std::uint64_t fnv1a(const void* data, std::size_t length,
+                           std::uint64_t hash = 14695981039346656037ull)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < length; i++) hash = (hash ^ bytes[i]) * 1099511628211ull;
+    return hash;
+}
+
+inline std::uint32_t record_checksum(const Wal_Record& record)
+{
+    return static_cast<std::uint32_t>(fnv1a(&record, offsetof(Wal_Record, checksum)));
+}
+
+[[noreturn]] inline void throw_errno(const std::string& what)
+{
+    throw std::system_error(errno, std::generic_category(), what);
+}
+
+inline void write_all(int fd, const void* data, std::size_t length, const std::string& what)
+{
+    const char* bytes = static_cast<const char*>(data);
+    while (length > 0)
+    {
+        ssize_t written = ::write(fd, bytes, length);
+        if (written < 0)
+        {
+            if (errno == EINTR) continue;
+            throw_errno(what);
+        }
+        bytes += written;
+        length -= static_cast<std::size_t>(written);
+    }
+}
+
+// Closes a file descriptor when it goes out of scope
+struct File
+{
+    int fd = -1;
+    explicit File(int descriptor) : fd(descriptor) {}
+    File(const File&) = delete;
+    File& operator=(const File&) = delete;
+    ~File()
+    {
+        if (fd >= 0) ::close(fd);
+    }
+};
+
+// Unmaps a read-only mapping when it goes out of scope
+struct Mapping
+{
+    void* address;
+    std::size_t size;
+    Mapping(void* mapped, std::size_t length) : address(mapped), size(length) {}
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+    ~Mapping() { ::munmap(address, size); }
+};
+}  // namespace journal_detail
+
+class Journaled_Ledger
+{
+   private:
+    using Wal_Record = journal_detail::Wal_Record;
+    using Clock = std::chrono::steady_clock;
+
+    std::string wal_path;
+    std::string snapshot_path;
+    std::string directory;
+    Journal_Options options;
+    std::unique_ptr<Account_Ledger> ledger;
+    journal_detail::File wal{-1};  // Closed by its destructor, also if the constructor throws
+
+    std::mutex io_lock;  // Serializes writes to the files; always taken before state_lock
+    std::mutex state_lock;
+    std::vector<Wal_Record> pending;  // Applied but not yet written
+    std::exception_ptr flush_error;   // First failed write or sync; guarded by io_lock
+    Clock::time_point first_pending;
+    std::uint64_t next_sequence = 1;
+    std::uint64_t durable = 0;  // Highest sequence known to be on disk
+    std::uint64_t snapshot_sequence = 0;
+    std::vector<Transfer_Status> batch_statuses;
+    Recovery_Stats stats;
+
+    std::thread flusher;
+    std::condition_variable flusher_wake;
+    bool stopping = false;
+
+    // Appends the record for an applied operation; caller holds state_lock
+    void log(journal_detail::Record_Kind kind, std::uint32_t from, std::uint32_t to,
+             Cents amount)
+    {
+        if (pending.empty()) first_pending = Clock::now();
+        Wal_Record record{next_sequence++, amount, from, to, kind, 0};
+        record.checksum = journal_detail::record_checksum(record);
+        pending.push_back(record);
+    }
+
+    // Ends a mutation: releases state_lock, then flushes or snapshots if a threshold is hit
+    void finish(std::unique_lock<std::mutex>& state)
+    {
+        bool snapshot_due = options.snapshot_every != 0 &&
+                            next_sequence - 1 - snapshot_sequence >= options.snapshot_every;
+        bool flush_due = pending.size() * sizeof(Wal_Record) >= options.group_commit_bytes;
+        state.unlock();
+        if (snapshot_due)
+            snapshot();
+        else if (flush_due)
+            commit();
+    }
+
+    /*
+     * Writes and syncs everything buffered; caller holds io_lock but not state_lock.
+     * A failure is sticky: the group it was writing is gone from pending and the WAL
+     * may hold part of it, so every later flush rethrows the first error.
+     */
+    void flush_locked()
+    {
+        if (flush_error) std::rethrow_exception(flush_error);
+        std::vector<Wal_Record> group;
+        {
+            std::lock_guard<std::mutex> state(state_lock);
+            group.swap(pending);
+        }
+        if (group.empty()) return;
+        try
+        {
+            journal_detail::write_all(wal.fd, group.data(), group.size() * sizeof(Wal_Record),
+                                      "write " + wal_path);
+            if (::fdatasync(wal.fd) != 0) journal_detail::throw_errno("fdatasync " + wal_path);
+        }
+        catch (const std::system_error&)
+        {
+            flush_error = std::current_exception();
+            throw;
+        }
+        std::lock_guard<std::mutex> state(state_lock);
+        durable = group.back().sequence;
+        if (pending.empty() && pending.capacity() < group.capacity())
+        {
+            group.clear();
+            pending.swap(group);  // Keep the larger buffer for the next group
+        }
+    }
+
+    void flusher_loop()
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        while (!stopping)
+        {
+            flusher_wake.wait_for(state, options.group_commit_latency);
+            if (stopping || pending.empty()) continue;
+            if (Clock::now() - first_pending < options.group_commit_latency) continue;
+            state.unlock();
+            try
+            {
+                std::lock_guard<std::mutex> io(io_lock);
+                flush_locked();
+            }
+            catch (const std::system_error&)
+            {
+                // Kept in flush_error; the next commit() reports it to the caller
+                return;
+            }
+            state.lock();
+        }
+    }
+
+    void sync_directory()
+    {
+        journal_detail::File dir(::open(directory.c_str(), O_RDONLY | O_DIRECTORY));
+        if (dir.fd < 0 || ::fsync(dir.fd) != 0) journal_detail::throw_errno("fsync " + directory);
+    }
+
+    // Builds the ledger from the snapshot, or from the opening balances if there is none
+    void load_snapshot(const std::vector<int>& numbers, const std::vector<Cents>& opening)
+    {
+        journal_detail::File file(::open(snapshot_path.c_str(), O_RDONLY));
+        if (file.fd < 0)
+        {
+            if (errno != ENOENT) journal_detail::throw_errno("open " + snapshot_path);
+            ledger.reset(new Account_Ledger(numbers, opening));
+            return;
+        }
+        struct stat info;
+        if (::fstat(file.fd, &info) != 0) journal_detail::throw_errno("stat " + snapshot_path);
+        std::size_t size = static_cast<std::size_t>(info.st_size);
+        if (size < sizeof(journal_detail::Snapshot_Header))
+            throw std::runtime_error("snapshot is truncated: " + snapshot_path);
+
+        void* mapped = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file.fd, 0);
+        if (mapped == MAP_FAILED) journal_detail::throw_errno("mmap " + snapshot_path);
+        journal_detail::Mapping unmap(mapped, size);
+
+        journal_detail::Snapshot_Header header;
+        std::memcpy(&header, mapped, sizeof(header));
+        const char* body = static_cast<const char*>(mapped) + sizeof(header);
+        std::size_t body_bytes = header.accounts * (sizeof(Cents) + sizeof(int));
+        if (std::memcmp(header.magic, journal_detail::snapshot_magic, sizeof(header.magic)) != 0 ||
+            size != sizeof(header) + body_bytes ||
+            journal_detail::fnv1a(body, body_bytes) != header.checksum)
+            throw std::runtime_error("snapshot is corrupt: " + snapshot_path);
+
+        std::vector<Cents> balances(header.accounts);
+        std::vector<int> account_numbers(header.accounts);
+        std::memcpy(balances.data(), body, header.accounts * sizeof(Cents));
+        std::memcpy(account_numbers.data(), body + header.accounts * sizeof(Cents),
+                    header.accounts * sizeof(int));
+        ledger.reset(new Account_Ledger(account_numbers, balances));
+        snapshot_sequence = header.sequence;
+    }
+
+    // Applies the WAL records after the snapshot and cuts off a torn tail
+    void replay_wal()
+    {
+        wal.fd = ::open(wal_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        if (wal.fd < 0) journal_detail::throw_errno("open " + wal_path);
+
+        std::vector<Wal_Record> chunk(8192);
+        std::uint64_t expected = 0;  // Sequence the next record must have, once the first is seen
+        off_t good_bytes = 0;
+        off_t offset = 0;
+        bool done = false;
+        while (!done)
+        {
+            ssize_t got = ::pread(wal.fd, chunk.data(), chunk.size() * sizeof(Wal_Record), offset);
+            if (got < 0) journal_detail::throw_errno("read " + wal_path);
+            std::size_t records = static_cast<std::size_t>(got) / sizeof(Wal_Record);
+            if (records == 0) break;
+            for (std::size_t i = 0; i < records && !done; i++)
+            {
+                const Wal_Record& record = chunk[i];
+                if (record.checksum != journal_detail::record_checksum(record) ||
+                    (expected != 0 && record.sequence != expected))
+                {
+                    done = true;
+                    break;
+                }
+                expected = record.sequence + 1;
+                good_bytes += sizeof(Wal_Record);
+                if (record.sequence <= snapshot_sequence) continue;  // Already in the snapshot
+                if (apply_record(record) != Transfer_Status::ok)
+                    throw std::runtime_error("WAL replay diverged at sequence " +
+                                             std::to_string(record.sequence));
+                stats.replayed_records++;
+            }
+            offset += got;
+        }
+
+        struct stat info;
+        if (::fstat(wal.fd, &info) != 0) journal_detail::throw_errno("stat " + wal_path);
+        if (info.st_size != good_bytes)
+        {
+            stats.torn_tail = true;
+            if (::ftruncate(wal.fd, good_bytes) != 0 || ::fsync(wal.fd) != 0)
+                journal_detail::throw_errno("truncate " + wal_path);
+        }
+        std::uint64_t last = expected == 0 ? 0 : expected - 1;
+        next_sequence = std::max(last, snapshot_sequence) + 1;
+        durable = next_sequence - 1;
+    }
+
+    Transfer_Status apply_record(const Wal_Record& record)
+    {
+        switch (record.kind)
+        {
+            case journal_detail::deposit_record:
+                return ledger->deposit(record.from, record.amount);
+            case journal_detail::withdraw_record:
+                return ledger->withdraw(record.from, record.amount);
+            case journal_detail::transfer_record:
+                return ledger->transfer({record.from, record.to, record.amount});
+            default:
+                return Transfer_Status::invalid_amount;
+        }
+    }
+
+   public:
+    /*
+     * Opens (or creates) the journal in directory, which must exist.
+     * numbers / opening are only used when there is no snapshot yet.
+     */
+    Journaled_Ledger(const std::string& dir, const std::vector<int>& numbers,
+                     const std::vector<Cents>& opening, Journal_Options journal_options = {})
+        : wal_path(dir + "/ledger.wal"),
+          snapshot_path(dir + "/ledger.snapshot"),
+          directory(dir),
+          options(journal_options)
+    {
+        auto start = Clock::now();
+        load_snapshot(numbers, opening);
+        replay_wal();
+        stats.snapshot_sequence = snapshot_sequence;
+        stats.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        flusher = std::thread([this] { flusher_loop(); });
+    }
+
+    Journaled_Ledger(const Journaled_Ledger&) = delete;
+    Journaled_Ledger& operator=(const Journaled_Ledger&) = delete;
+
+    // Clean shutdown: everything applied is made durable
+    ~Journaled_Ledger()
+    {
+        {
+            std::lock_guard<std::mutex> state(state_lock);
+            stopping = true;
+        }
+        flusher_wake.notify_all();
+        flusher.join();
+        try
+        {
+            commit();
+        }
+        catch (const std::system_error&)
+        {
+            // Nothing left to report to; the records stay un-durable
+        }
+    }
+
+    Transfer_Status deposit(std::uint32_t id, Cents amount)
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        Transfer_Status status = ledger->deposit(id, amount);
+        if (status != Transfer_Status::ok) return status;
+        log(journal_detail::deposit_record, id, id, amount);
+        finish(state);
+        return status;
+    }
+
+    Transfer_Status withdraw(std::uint32_t id, Cents amount)
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        Transfer_Status status = ledger->withdraw(id, amount);
+        if (status != Transfer_Status::ok) return status;
+        log(journal_detail::withdraw_record, id, id, amount);
+        finish(state);
+        return status;
+    }
+
+    Transfer_Status transfer(const Transfer& t)
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        Transfer_Status status = ledger->transfer(t);
+        if (status != Transfer_Status::ok) return status;
+        log(journal_detail::transfer_record, t.from, t.to, t.amount);
+        finish(state);
+        return status;
+    }
+
+    // Account_Ledger::submit_batch, with one WAL record per applied transfer
+    Batch_Result submit_batch(const Transfer* transfers, std::size_t count,
+                              Transfer_Status* statuses = nullptr)
+    {
+        std::unique_lock<std::mutex> state(state_lock);
+        if (!statuses)
+        {
+            batch_statuses.resize(count);
+            statuses = batch_statuses.data();
+        }
+        Batch_Result result = ledger->submit_batch(transfers, count, statuses);
+        for (std::size_t i = 0; i < count; i++)
+        {
+            if (statuses[i] == Transfer_Status::ok)
+                log(journal_detail::transfer_record, transfers[i].from, transfers[i].to,
+                    transfers[i].amount);
+        }
+        finish(state);
+        return result;
+    }
+
+    // Makes every operation applied so far durable before returning; throws std::system_error
+    // if this or any earlier write to the WAL failed, including one by the background flusher
+    void commit()
+    {
+        std::lock_guard<std::mutex> io(io_lock);
+        flush_locked();
+    }
+
+    /*
+     * Writes the whole ledger to ledger.snapshot (through a temporary file,
+     * mmap and rename, so a crash leaves either the old or the new snapshot)
+     * and then empties the WAL. Blocks mutations while it runs.
+     */
+    void snapshot()
+    {
+        std::lock_guard<std::mutex> io(io_lock);
+        flush_locked();
+        std::lock_guard<std::mutex> state(state_lock);
+        // state_lock keeps mutators out, so the balances are exactly those after sequence
+        // next_sequence - 1. Operations applied after flush_locked released the lock may
+        // still be in pending; the snapshot covers them, and they are dropped below.
+        const std::uint64_t sequence = next_sequence - 1;
+        const std::size_t accounts = ledger->size();
+        const std::size_t size = sizeof(journal_detail::Snapshot_Header) +
+                                 accounts * (sizeof(Cents) + sizeof(int));
+        const std::string temp_path = snapshot_path + ".tmp";
+        {
+            journal_detail::File file(::open(temp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+            if (file.fd < 0) journal_detail::throw_errno("open " + temp_path);
+            if (::ftruncate(file.fd, static_cast<off_t>(size)) != 0)
+                journal_detail::throw_errno("ftruncate " + temp_path);
+            void* mapped = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+            if (mapped == MAP_FAILED) journal_detail::throw_errno("mmap " + temp_path);
+
+            char* body = static_cast<char*>(mapped) + sizeof(journal_detail::Snapshot_Header);
+            ledger->copy_balances(reinterpret_cast<Cents*>(body));
+            int* numbers = reinterpret_cast<int*>(body + accounts * sizeof(Cents));
+            for (std::size_t i = 0; i < accounts; i++)
+                numbers[i] = ledger->account_no(static_cast<std::uint32_t>(i));
+
+            journal_detail::Snapshot_Header header;
+            std::memcpy(header.magic, journal_detail::snapshot_magic, sizeof(header.magic));
+            header.sequence = sequence;
+            header.accounts = accounts;
+            header.checksum = journal_detail::fnv1a(body, size - sizeof(header));
+            std::memcpy(mapped, &header, sizeof(header));
+
+            bool synced = ::msync(mapped, size, MS_SYNC) == 0;
+            ::munmap(mapped, size);
+            if (!synced) journal_detail::throw_errno("msync " + temp_path);
+        }
+        if (::rename(temp_path.c_str(), snapshot_path.c_str()) != 0)
+            journal_detail::throw_errno("rename " + temp_path);
+        sync_directory();
+        // A crash before this truncate is harmless: replay skips sequences <= snapshot
+        if (::ftruncate(wal.fd, 0) != 0 || ::fsync(wal.fd) != 0)
+            journal_detail::throw_errno("truncate " + wal_path);
+        snapshot_sequence = sequence;
+        pending.clear();  // Every pending record is <= sequence, and now durable in the snapshot
+        durable = sequence;
+    }
+
+    Cents balance(std::uint32_t id) { return ledger->balance(id); }
+    bool audit() { return ledger->audit(); }
+    Cents total() const { return ledger->total(); }
+    std::size_t size() const { return ledger->size(); }
+
+    std::uint64_t last_sequence()
+    {
+        std::lock_guard<std::mutex> state(state_lock);
+        return next_sequence - 1;
+    }
+
+    std::uint64_t durable_sequence()
+    {
+        std::lock_guard<std::mutex> state(state_lock);
+        return durable;
+    }
+
+    const Recovery_Stats& recovery() const { return stats; }
+};
+
+#endif
@@ -0,0 +1,333 @@
+#ifndef SHAPE_BATCH_H
+#define SHAPE_BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+/*
+ * Data-oriented counterparts of the Shape hierarchy in 05-polymorphism.cpp,
+ * for scenes with millions of shapes.
+ *
+ * - ShapeScene sorts shapes by type: every concrete type has its own
+ *   columns (struct of arrays), so a batch of circles is one loop over a
+ *   contiguous radius array with no virtual call, no pointer chasing and
+ *   nothing the compiler cannot inline or vectorize.
+ * - Colors are interned once in a ColorTable; a shape stores a 32-bit id.
+ * - ShapeValue is the std::variant alternative: one contiguous vector of
+ *   mixed shapes in insertion order, dispatched with std::visit (a jump
+ *   table, no heap object per shape).
+ *
+ * The formulas live in shape_geometry so the virtual classes, the scene and
+ * the variant all compute exactly the same thing. A triangle is given by
+ * base and height, so it is taken to be isosceles for its perimeter.
+ */
+
+namespace shape_geometry
+{
+constexpr double kPi = 3.14159265358979323846;
+
+inline double circleArea(double radius) { return kPi * radius * radius; }
+inline double circlePerimeter(double radius) { return 2 * kPi * radius; }
+inline double rectangleArea(double width, double height) { return width * height; }
+inline double rectanglePerimeter(double width, double height) { return 2 * (width + height); }
+inline double triangleArea(double base, double height) { return 0.5 * base * height; }
+
+// Isosceles triangle: base plus two equal legs from the base ends to the apex
+inline double trianglePerimeter(double base, double height)
+{
+    return base + 2 * std::sqrt(0.25 * base * base + height * height);
+}
+
+/*
+ * term(0) + ... + term(n - 1) with four independent accumulators, so the
+ * additions do not wait on each other (and map onto SIMD lanes at -O3).
+ */
+template <class Term>
+double sumTerms(std::size_t n, Term term)
+{
+    double s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        s0 += term(i);
+        s1 += term(i + 1);
+        s2 += term(i + 2);
+        s3 += term(i + 3);
+    }
+    for (; i < n; i++) s0 += term(i);
+    return (s0 + s1) + (s2 + s3);
+}
+}  // namespace shape_geometry
+
+/**
+ * Interns color names: each distinct name is stored once and shapes refer
+ * to it by a small integer id.
+ */
+class ColorTable
+{
+   private:
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> ids;
+
+   public:
+    std::uint32_t intern(std::string_view color)
+    {
+        auto found = ids.find(std::string(color));
+        if (found != ids.end()) return found->second;
+        std::uint32_t id = static_cast<std::uint32_t>(names.size());
+        names.emplace_back(color);
+        ids.emplace(names.back(), id);
+        return id;
+    }
+
+    // Id of a color already interned; throws std::out_of_range otherwise
+    std::uint32_t idOf(std::string_view color) const { return ids.at(std::string(color)); }
+
+    const std::string& name(std::uint32_t id) const { return names.at(id); }
+    std::size_t size() const { return names.size(); }
+};
+
+/**
+ * Shapes stored by type, one column per field.
+ * Shapes of one type keep their insertion order; drawAll() and the batch
+ * results go circles first, then rectangles, then triangles.
+ */
+class ShapeScene
+{
+   public:
+    struct Circles
+    {
+        std::vector<double> radius;
+        std::vector<std::uint32_t> color;
+    };
+
+    struct Rectangles
+    {
+        std::vector<double> width;
+        std::vector<double> height;
+        std::vector<std::uint32_t> color;
+    };
+
+    struct Triangles
+    {
+        std::vector<double> base;
+        std::vector<double> height;
+        std::vector<std::uint32_t> color;
+    };
+
+   private:
+    ColorTable colors;
+    Circles circles;
+    Rectangles rectangles;
+    Triangles triangles;
+
+    // Sum of term(i) over the shapes of one type whose color is colorId
+    template <class Term>
+    static double sumOfColor(const std::vector<std::uint32_t>& color, std::uint32_t colorId,
+                             Term term)
+    {
+        return shape_geometry::sumTerms(color.size(), [&](std::size_t i)
+                                        { return color[i] == colorId ? term(i) : 0.0; });
+    }
+
+   public:
+    void addCircle(std::string_view color, double radius)
+    {
+        circles.radius.push_back(radius);
+        circles.color.push_back(colors.intern(color));
+    }
+
+    void addRectangle(std::string_view color, double width, double height)
+    {
+        rectangles.width.push_back(width);
+        rectangles.height.push_back(height);
+        rectangles.color.push_back(colors.intern(color));
+    }
+
+    void addTriangle(std::string_view color, double base, double height)
+    {
+        triangles.base.push_back(base);
+        triangles.height.push_back(height);
+        triangles.color.push_back(colors.intern(color));
+    }
+
+    // Reserves room for the given number of shapes of each type
+    void reserve(std::size_t circleCount, std::size_t rectangleCount, std::size_t triangleCount)
+    {
+        circles.radius.reserve(circleCount);
+        circles.color.reserve(circleCount);
+        rectangles.width.reserve(rectangleCount);
+        rectangles.height.reserve(rectangleCount);
+        rectangles.color.reserve(rectangleCount);
+        triangles.base.reserve(triangleCount);
+        triangles.height.reserve(triangleCount);
+        triangles.color.reserve(triangleCount);
+    }
+
+    std::size_t size() const
+    {
+        return circles.radius.size() + rectangles.width.size() + triangles.base.size();
+    }
+
+    const Circles& circleColumns() const { return circles; }
+    const Rectangles& rectangleColumns() const { return rectangles; }
+    const Triangles& triangleColumns() const { return triangles; }
+    const ColorTable& colorTable() const { return colors; }
+
+    double totalArea() const
+    {
+        using namespace shape_geometry;
+        const double* r = circles.radius.data();
+        const double* w = rectangles.width.data();
+        const double* h = rectangles.height.data();
+        const double* b = triangles.base.data();
+        const double* th = triangles.height.data();
+        return sumTerms(circles.radius.size(), [r](std::size_t i) { return circleArea(r[i]); }) +
+               sumTerms(rectangles.width.size(),
+                        [w, h](std::size_t i) { return rectangleArea(w[i], h[i]); }) +
+               sumTerms(triangles.base.size(),
+                        [b, th](std::size_t i) { return triangleArea(b[i], th[i]); });
+    }
+
+    double totalPerimeter() const
+    {
+        using namespace shape_geometry;
+        const double* r = circles.radius.data();
+        const double* w = rectangles.width.data();
+        const double* h = rectangles.height.data();
+        const double* b = triangles.base.data();
+        const double* th = triangles.height.data();
+        return sumTerms(circles.radius.size(),
+                        [r](std::size_t i) { return circlePerimeter(r[i]); }) +
+               sumTerms(rectangles.width.size(),
+                        [w, h](std::size_t i) { return rectanglePerimeter(w[i], h[i]); }) +
+               sumTerms(triangles.base.size(),
+                        [b, th](std::size_t i) { return trianglePerimeter(b[i], th[i]); });
+    }
+
+    // Total area of the shapes of one color; throws std::out_of_range for an unknown color
+    double areaOfColor(std::string_view color) const
+    {
+        using namespace shape_geometry;
+        const std::uint32_t id = colors.idOf(color);
+        const double* r = circles.radius.data();
+        const double* w = rectangles.width.data();
+        const double* h = rectangles.height.data();
+        const double* b = triangles.base.data();
+        const double* th = triangles.height.data();
+        return sumOfColor(circles.color, id, [r](std::size_t i) { return circleArea(r[i]); }) +
+               sumOfColor(rectangles.color, id,
+                          [w, h](std::size_t i) { return rectangleArea(w[i], h[i]); }) +
+               sumOfColor(triangles.color, id,
+                          [b, th](std::size_t i) { return triangleArea(b[i], th[i]); });
+    }
+
+    // Writes every shape's area into out[0 .. size()), in scene order
+    void areas(double* out) const
+    {
+        using namespace shape_geometry;
+        for (std::size_t i = 0; i < circles.radius.size(); i++)
+            *out++ = circleArea(circles.radius[i]);
+        for (std::size_t i = 0; i < rectangles.width.size(); i++)
+            *out++ = rectangleArea(rectangles.width[i], rectangles.height[i]);
+        for (std::size_t i = 0; i < triangles.base.size(); i++)
+            *out++ = triangleArea(triangles.base[i], triangles.height[i]);
+    }
+
+    // Same lines as the virtual draw() methods print
+    void drawAll(std::ostream& out) const
+    {
+        for (std::size_t i = 0; i < circles.radius.size(); i++)
+            out << "Drawing a " << colors.name(circles.color[i]) << " Circle with radius "
+                << circles.radius[i] << '\n';
+        for (std::size_t i = 0; i < rectangles.width.size(); i++)
+            out << "Drawing a " << colors.name(rectangles.color[i]) << " Rectangle with width "
+                << rectangles.width[i] << " and height " << rectangles.height[i] << '\n';
+        for (std::size_t i = 0; i < triangles.base.size(); i++)
+            out << "Drawing a " << colors.name(triangles.color[i]) << " Triangle with base "
+                << triangles.base[i] << " and height " << triangles.height[i] << '\n';
+    }
+};
+
+// --- std::variant alternative: closed set of value types, one contiguous vector ---
+
+struct CircleValue
+{
+    double radius;
+    std::uint32_t color;  // Id in a ColorTable
+};
+
+struct RectangleValue
+{
+    double width;
+    double height;
+    std::uint32_t color;
+};
+
+struct TriangleValue
+{
+    double base;
+    double height;
+    std::uint32_t color;
+};
+
+using ShapeValue = std::variant<CircleValue, RectangleValue, TriangleValue>;
+
+inline double shapeArea(const CircleValue& c) { return shape_geometry::circleArea(c.radius); }
+inline double shapeArea(const RectangleValue& r)
+{
+    return shape_geometry::rectangleArea(r.width, r.height);
+}
+inline double shapeArea(const TriangleValue& t)
+{
+    return shape_geometry::triangleArea(t.base, t.height);
+}
+
+inline double shapePerimeter(const CircleValue& c)
+{
+    return shape_geometry::circlePerimeter(c.radius);
+}
+inline double shapePerimeter(const RectangleValue& r)
+{
+    return shape_geometry::rectanglePerimeter(r.width, r.height);
+}
+inline double shapePerimeter(const TriangleValue& t)
+{
+    return shape_geometry::trianglePerimeter(t.base, t.height);
+}
+
+/*
+ * Stable-sorts shapes by alternative, so std::visit sees long runs of one
+ * type and its dispatch branch is predicted (random order mispredicts on
+ * about every other shape).
+ */
+inline void groupByType(std::vector<ShapeValue>& shapes)
+{
+    std::stable_sort(shapes.begin(), shapes.end(), [](const ShapeValue& a, const ShapeValue& b)
+                     { return a.index() < b.index(); });
+}
+
+inline double totalArea(const std::vector<ShapeValue>& shapes)
+{
+    return shape_geometry::sumTerms(
+        shapes.size(), [&](std::size_t i)
+        { return std::visit([](const auto& shape) { return shapeArea(shape); }, shapes[i]); });
+}
+
+inline double totalPerimeter(const std::vector<ShapeValue>& shapes)
+{
+    return shape_geometry::sumTerms(
+        shapes.size(), [&](std::size_t i)
+        { return std::visit([](const auto& shape) { return shapePerimeter(shape); }, shapes[i]); });
+}
+
+#endif
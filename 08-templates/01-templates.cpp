@@ -7,10 +7,19 @@
  * Date: 2025-06-26
  */
 
-#include <iostream>     // For std::cout, std::endl
-#include <string>       // For std::string
-#include <vector>       // For std::vector in examples
-#include <type_traits>  // For std::is_arithmetic_v (C++20 Concepts example)
+#include <iostream>          // For std::cout, std::endl
+#include <string>            // For std::string
+#include <vector>            // For std::vector in examples
+#include <type_traits>       // For std::is_arithmetic_v, std::is_empty_v (PairSlot)
+#include <functional>        // For std::less (an empty type in the Pair example)
+#include <cstddef>           // For std::size_t
+#include <cstdint>           // For std::uintptr_t
+#include <initializer_list>  // For StaticVector's brace initialization
+#include <new>               // For placement new in StaticVector
+#include <stdexcept>         // For std::out_of_range, std::length_error
+#include <utility>           // For std::move, std::forward
+#include "constexpr-tables.h"  // For make_table and the precomputed tables (Example 5.2)
+#include "pair-array.h"        // For PairArray (Example 3.2.1)
 
 // =========================================================================
 // 1. Introduction: What are Templates? (The Generic Tool Analogy)
@@ -158,27 +167,60 @@ void demonstrateExplicitTemplateArguments()
  */
 
 // Example 3.1: Basic Class Template (a generic Pair)
-template <typename T1, typename T2>  // Two type parameters
-class Pair
+// PairSlot holds one member of a Pair. An empty class (a comparator, an allocator, a tag) still
+// takes a byte as a member, plus padding; as a base class it takes none (the empty-base
+// optimization), so such a T is inherited instead. Index keeps the two slots distinct types
+// when T1 and T2 are the same.
+template <typename T, int Index, bool = std::is_empty_v<T> && !std::is_final_v<T>>
+class PairSlot
 {
    private:
-    T1 first;
-    T2 second;
+    T value;
 
    public:
-    // Constructor for the Pair class template
-    Pair(T1 f, T2 s) : first(f), second(s) { std::cout << "3.1 Pair object created." << std::endl; }
+    template <typename U>
+    explicit PairSlot(U&& v) : value(std::forward<U>(v))
+    {
+    }
+    T& get() { return value; }
+    const T& get() const { return value; }
+};
 
-    // Member function to get the first element
-    T1 getFirst() const { return first; }
+template <typename T, int Index>
+class PairSlot<T, Index, true> : private T
+{
+   public:
+    template <typename U>
+    explicit PairSlot(U&& v) : T(std::forward<U>(v))
+    {
+    }
+    T& get() { return *this; }
+    const T& get() const { return *this; }
+};
 
-    // Member function to get the second element
-    T2 getSecond() const { return second; }
+template <typename T1, typename T2>  // Two type parameters
+class Pair : private PairSlot<T1, 0>, private PairSlot<T2, 1>
+{
+   private:
+    using First = PairSlot<T1, 0>;
+    using Second = PairSlot<T2, 1>;
+
+   public:
+    // Constructor for the Pair class template: forwarding references (U1&&, U2&&) pass each
+    // argument on as it came, so temporaries are moved into place and nothing is copied twice
+    template <typename U1, typename U2>
+    Pair(U1&& f, U2&& s) : First(std::forward<U1>(f)), Second(std::forward<U2>(s))
+    {
+    }
+
+    // Member functions to get the elements, by reference so nothing is copied
+    const T1& getFirst() const { return First::get(); }
+    const T2& getSecond() const { return Second::get(); }
 
     // Member function to display the pair
     void display() const
     {
-        std::cout << "3.1 Pair: (" << first << ", " << second << ")" << std::endl;
+        std::cout << "3.1 Pair: (" << getFirst() << ", " << getSecond() << ")" << std::endl;
     }
 };
 
@@ -202,6 +244,20 @@ void demonstrateClassTemplates()
     // Accessing members
     std::cout << "3.2 p1.getFirst(): " << p1.getFirst() << std::endl;
     std::cout << "3.2 p2.getSecond(): " << p2.getSecond() << std::endl;
+
+    // An empty member costs nothing: the comparator is a base, not a padded byte
+    std::cout << "3.2 sizeof(Pair<std::less<int>, int>): " << sizeof(Pair<std::less<int>, int>)
+              << ", sizeof(std::pair<std::less<int>, int>): "
+              << sizeof(std::pair<std::less<int>, int>) << std::endl;
+
+    // Example 3.2.1: The same pairs as two columns (pair-array.h)
+    PairArray<int, std::string> scores = {{30, "carol"}, {10, "alice"}, {20, "bob"}, {10, "dave"}};
+    scores.sortByKey();  // Stable: alice stays before dave
+    std::cout << "3.2.1 Sorted by key:";
+    for (std::size_t i = 0; i < scores.size(); ++i)
+        std::cout << " (" << scores.key(i) << ", " << scores.value(i) << ")";
+    std::cout << std::endl;
+    std::cout << "3.2.1 First key >= 15 at index " << scores.lowerBound(15) << std::endl;
 }
 
 /**
@@ -211,85 +267,244 @@ void demonstrateClassTemplates()
  */
 
 // Example 3.3.1: Class Template with Default Arguments
-template <typename T = int, int N = 10>  // T defaults to int, N defaults to 10
+/**
+ * Fixed-size array of N elements, stored inline (no heap) and aligned to Align bytes.
+ * -   Align defaults to alignof(T); raise it (e.g. 32 or 64) so that SIMD loads of data() are
+ * aligned and the array starts on its own cache line.
+ * -   Construction and fill() are constexpr, so a FixedArray can be built at compile time.
+ * -   operator[] is unchecked like a built-in array; at() checks and throws std::out_of_range.
+ * -   Nothing is printed; use displayElements() below to show the contents.
+ */
+template <typename T = int, std::size_t N = 10, std::size_t Align = alignof(T)>
 class FixedArray
 {
+    static_assert(N > 0, "FixedArray needs at least one element");
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+    static_assert(Align >= alignof(T), "Align must not be weaker than alignof(T)");
+
    private:
-    T arr[N];  // Array of type T with size N
+    alignas(Align) T arr[N]{};  // Value-initialized: zero for arithmetic types
 
    public:
-    FixedArray()
+    constexpr FixedArray() = default;
+
+    // All N elements set to value
+    constexpr explicit FixedArray(const T& value) { fill(value); }
+
+    // Unchecked access
+    constexpr T& operator[](std::size_t index) { return arr[index]; }
+    constexpr const T& operator[](std::size_t index) const { return arr[index]; }
+
+    // Checked access, throws std::out_of_range
+    constexpr T& at(std::size_t index)
     {
-        std::cout << "3.3.1 FixedArray<" << typeid(T).name() << ", " << N << "> created."
-                  << std::endl;
-        for (int i = 0; i < N; ++i)
-        {
-            arr[i] = T();  // Initialize elements (requires T to be default-constructible)
-        }
+        if (index >= N) throw std::out_of_range("FixedArray::at index out of bounds");
+        return arr[index];
     }
 
-    // Access operator
-    T& operator[](int index)
+    constexpr const T& at(std::size_t index) const
     {
-        if (index < 0 || index >= N)
-        {
-            // In real code, throw an exception or handle error properly
-            std::cerr << "Error: Array index out of bounds!" << std::endl;
-            // Return a reference to a dummy value or exit, for simplicity here
-            // this is just to avoid compiler warning for not returning a value.
-            static T dummy_val = T();
-            return dummy_val;
-        }
+        if (index >= N) throw std::out_of_range("FixedArray::at index out of bounds");
         return arr[index];
     }
 
-    const T& operator[](int index) const
+    constexpr void fill(const T& value)
     {
-        if (index < 0 || index >= N)
+        for (std::size_t i = 0; i < N; ++i)
         {
-            std::cerr << "Error: Array index out of bounds (const)!" << std::endl;
-            static T dummy_val = T();
-            return dummy_val;
+            arr[i] = value;
         }
-        return arr[index];
     }
 
-    void fill(const T& value)
+    static constexpr std::size_t size() { return N; }
+    static constexpr std::size_t alignment() { return Align; }
+
+    constexpr T* data() { return arr; }
+    constexpr const T* data() const { return arr; }
+    constexpr T* begin() { return arr; }
+    constexpr const T* begin() const { return arr; }
+    constexpr T* end() { return arr + N; }
+    constexpr const T* end() const { return arr + N; }
+};
+
+/**
+ * Vector with a runtime size but a fixed capacity N, stored inline: no heap allocation ever.
+ * Unlike FixedArray, only the first size() elements exist (are constructed).
+ * push_back/emplace_back on a full vector throw std::length_error.
+ */
+template <typename T, std::size_t N, std::size_t Align = alignof(T)>
+class StaticVector
+{
+    static_assert(N > 0, "StaticVector needs room for at least one element");
+    static_assert((Align & (Align - 1)) == 0, "Align must be a power of two");
+    static_assert(Align >= alignof(T), "Align must not be weaker than alignof(T)");
+
+   private:
+    alignas(Align) unsigned char storage[N * sizeof(T)];  // Raw slots, constructed on demand
+    std::size_t count = 0;
+
+    T* slots() { return reinterpret_cast<T*>(storage); }
+    const T* slots() const { return reinterpret_cast<const T*>(storage); }
+
+   public:
+    StaticVector() = default;
+
+    StaticVector(std::initializer_list<T> values)
+    {
+        for (const T& value : values) push_back(value);
+    }
+
+    StaticVector(const StaticVector& other)
     {
-        for (int i = 0; i < N; ++i)
+        for (const T& value : other) push_back(value);
+    }
+
+    StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    {
+        for (T& value : other) push_back(std::move(value));
+        other.clear();
+    }
+
+    StaticVector& operator=(const StaticVector& other)
+    {
+        if (this != &other)
         {
-            arr[i] = value;
+            clear();
+            for (const T& value : other) push_back(value);
         }
+        return *this;
     }
 
-    void display() const
+    StaticVector& operator=(StaticVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
     {
-        std::cout << "3.3.1 FixedArray elements: [";
-        for (int i = 0; i < N; ++i)
+        if (this != &other)
         {
-            std::cout << arr[i] << (i == N - 1 ? "" : ", ");
+            clear();
+            for (T& value : other) push_back(std::move(value));
+            other.clear();
         }
-        std::cout << "]" << std::endl;
+        return *this;
+    }
+
+    ~StaticVector() { clear(); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (count == N) throw std::length_error("StaticVector is full");
+        T* slot = new (slots() + count) T(std::forward<Args>(args)...);
+        ++count;
+        return *slot;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    // Removes the last element; the vector must not be empty
+    void pop_back()
+    {
+        --count;
+        slots()[count].~T();
+    }
+
+    void clear()
+    {
+        while (count > 0) pop_back();
+    }
+
+    // Unchecked access
+    T& operator[](std::size_t index) { return slots()[index]; }
+    const T& operator[](std::size_t index) const { return slots()[index]; }
+
+    // Checked access, throws std::out_of_range
+    T& at(std::size_t index)
+    {
+        if (index >= count) throw std::out_of_range("StaticVector::at index out of bounds");
+        return slots()[index];
     }
+
+    const T& at(std::size_t index) const
+    {
+        if (index >= count) throw std::out_of_range("StaticVector::at index out of bounds");
+        return slots()[index];
+    }
+
+    std::size_t size() const { return count; }
+    static constexpr std::size_t capacity() { return N; }
+    bool empty() const { return count == 0; }
+    bool full() const { return count == N; }
+
+    T* data() { return slots(); }
+    const T* data() const { return slots(); }
+    T* begin() { return slots(); }
+    const T* begin() const { return slots(); }
+    T* end() { return slots() + count; }
+    const T* end() const { return slots() + count; }
 };
 
+// Prints "label: [a, b, c]" for any container with begin()/end()
+template <typename Container>
+void displayElements(const std::string& label, const Container& values)
+{
+    std::cout << label << ": [";
+    bool first = true;
+    for (const auto& value : values)
+    {
+        std::cout << (first ? "" : ", ") << value;
+        first = false;
+    }
+    std::cout << "]" << std::endl;
+}
+
+// Built entirely at compile time: no code runs to initialize it
+constexpr FixedArray<int, 8> kSevens(7);
+static_assert(kSevens[3] == 7 && kSevens.size() == 8, "FixedArray works in constant expressions");
+static_assert(alignof(FixedArray<float, 16, 64>) == 64, "Align controls the array alignment");
+
 void demonstrateDefaultTemplateArguments()
 {
     std::cout << "\n--- 3.3.1 Default Template Arguments Example ---" << std::endl;
 
     FixedArray<> fa1;  // Uses default T=int, N=10
     fa1.fill(7);
-    fa1.display();  // Output: FixedArray<int, 10> created. FixedArray elements: [7, 7, ...]
+    displayElements("3.3.1 FixedArray<> elements", fa1);  // Output: [7, 7, 7, ...]
 
-    FixedArray<double> fa2;  // Uses default N=10, T=double
-    fa2.fill(3.14);
-    fa2.display();  // Output: FixedArray<double, 10> created. FixedArray elements: [3.14, 3.14,
-                    // ...]
+    FixedArray<double> fa2(3.14);  // Uses default N=10, T=double
+    displayElements("3.3.1 FixedArray<double> elements", fa2);  // Output: [3.14, 3.14, ...]
 
     FixedArray<std::string, 3> fa3;  // T=std::string, N=3
     fa3.fill("abc");
-    fa3.display();  // Output: FixedArray<std::string, 3> created. FixedArray elements: [abc, abc,
-                    // abc]
+    displayElements("3.3.1 FixedArray<std::string, 3> elements", fa3);  // Output: [abc, abc, abc]
+
+    try
+    {
+        fa3.at(3);  // Checked access past the end
+    }
+    catch (const std::out_of_range& error)
+    {
+        std::cout << "3.3.1 at(3) threw: " << error.what() << std::endl;
+    }
+
+    FixedArray<float, 16, 64> aligned(1.5f);  // Starts on a 64-byte boundary
+    std::cout << "3.3.1 FixedArray<float, 16, 64> address % 64 = "
+              << reinterpret_cast<std::uintptr_t>(aligned.data()) % 64 << std::endl;  // Output: 0
+
+    displayElements("3.3.1 constexpr kSevens", kSevens);
+
+    StaticVector<std::string, 4> words = {"stack", "only"};
+    words.push_back("no");
+    words.emplace_back("heap");
+    displayElements("3.3.1 StaticVector<std::string, 4>", words);
+    std::cout << "3.3.1 size " << words.size() << " of " << words.capacity()
+              << ", full: " << words.full() << std::endl;
+    try
+    {
+        words.push_back("overflow");
+    }
+    catch (const std::length_error& error)
+    {
+        std::cout << "3.3.1 push_back threw: " << error.what() << std::endl;
+    }
 }
 
 // =========================================================================
@@ -316,13 +531,12 @@ void demonstrateNonTypeTemplateParameters()
     // FixedArray<int, 5> is an instantiation where '5' is a non-type template parameter.
     FixedArray<int, 5> myIntArray;
     myIntArray.fill(42);
-    myIntArray.display();  // Output: FixedArray<int, 5> created. FixedArray elements: [42, 42, 42,
-                           // 42, 42]
+    displayElements("4.1 FixedArray<int, 5>", myIntArray);  // Output: [42, 42, 42, 42, 42]
 
     FixedArray<bool, 2> myBoolArray;
     myBoolArray.fill(true);
-    myBoolArray.display();  // Output: FixedArray<bool, 2> created. FixedArray elements: [1, 1]
-                            // (true often prints as 1)
+    displayElements("4.1 FixedArray<bool, 2>", myBoolArray);  // Output: [1, 1]
+                                                               // (true often prints as 1)
 }
 
 // =========================================================================
@@ -366,6 +580,24 @@ void demonstrateTemplateMetaprogramming()
 
     long long fact7 = Factorial<7>::value;  // Value is 5040, computed at compile time
     std::cout << "5.1 Factorial<7>::value = " << fact7 << std::endl;  // Output: 5040
+
+    // Example 5.2: Whole tables at compile time (constexpr-tables.h)
+    // Factorial<N> gives one value per instantiation; make_table fills a std::array with every
+    // value up to N in one go, and the index can then be a runtime value.
+    static_assert(kFactorials[5] == Factorial<5>::value, "Both are computed by the compiler");
+    static_assert(crc32("123456789") == 0xCBF43926u, "Standard CRC-32 check value");
+
+    int runtimeIndex = 20;  // Not a constant: the lookup is a single load from the table
+    std::cout << "5.2 factorial(" << runtimeIndex << ") = " << factorial(runtimeIndex)
+              << std::endl;  // Output: 2432902008176640000
+    std::cout << "5.2 fibonacci(90) = " << fibonacci(90) << std::endl;  // 2880067194370816120
+    std::cout << "5.2 powerOf10(18) = " << powerOf10(18) << std::endl;  // 1000000000000000000
+    std::cout << "5.2 crc32(\"hello\") = " << std::hex << crc32("hello") << std::dec
+              << std::endl;  // Output: 3610a686
+
+    // Any constexpr lambda works as a generator, e.g. the first 16 squares
+    constexpr auto squares = make_table<16>([](std::size_t i) { return static_cast<int>(i * i); });
+    std::cout << "5.2 squares[15] = " << squares[15] << std::endl;  // Output: 225
 }
 
 // =========================================================================
@@ -0,0 +1,124 @@
+/**
+ * File: constexpr-tables.h
+ * Description: Compile-time lookup tables. make_table fills a std::array by calling a constexpr
+ * generator for every index 0..N-1 while compiling; the tables below are `inline constexpr`, so
+ * they are emitted as read-only data (.rodata) with no start-up code, and a lookup is one load.
+ * It generalizes the single-value Factorial<N> example in 01-templates.cpp.
+ */
+
+#ifndef CONSTEXPR_TABLES_H
+#define CONSTEXPR_TABLES_H
+
+#include <array>        // For std::array (the table type)
+#include <cstddef>      // For std::size_t
+#include <cstdint>      // For std::uint32_t, std::uint64_t
+#include <string_view>  // For crc32 over text
+#include <type_traits>  // For std::invoke_result_t
+
+/**
+ * **make_table**
+ * -   `make_table<N>(generator)` takes any constexpr callable, including a lambda.
+ * -   `make_table<Generator, N>()` takes a default-constructible generator type.
+ * -   Entry i of the result is generator(i). Assign the result to a `constexpr` variable to force
+ * compile-time evaluation; signed overflow or other UB in the generator is then a compile error.
+ */
+template <std::size_t N, typename Generator>
+constexpr auto make_table(Generator generator)
+{
+    std::array<std::invoke_result_t<Generator, std::size_t>, N> table{};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        table[i] = generator(i);
+    }
+    return table;
+}
+
+template <typename Generator, std::size_t N>
+constexpr auto make_table()
+{
+    return make_table<N>(Generator{});
+}
+
+// n!, exact in 64 bits up to 20!
+struct FactorialGenerator
+{
+    constexpr std::uint64_t operator()(std::size_t n) const
+    {
+        std::uint64_t result = 1;
+        for (std::size_t i = 2; i <= n; ++i) result *= i;
+        return result;
+    }
+};
+
+// F(n) with F(0) = 0, F(1) = 1, exact in 64 bits up to F(93)
+struct FibonacciGenerator
+{
+    constexpr std::uint64_t operator()(std::size_t n) const
+    {
+        std::uint64_t previous = 0, current = 1;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::uint64_t next = previous + current;
+            previous = current;
+            current = next;
+        }
+        return previous;
+    }
+};
+
+// Base^n
+template <std::uint64_t Base>
+struct PowerGenerator
+{
+    constexpr std::uint64_t operator()(std::size_t n) const
+    {
+        std::uint64_t result = 1;
+        for (std::size_t i = 0; i < n; ++i) result *= Base;
+        return result;
+    }
+};
+
+// CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) of the single byte n
+struct Crc32Generator
+{
+    constexpr std::uint32_t operator()(std::size_t n) const
+    {
+        std::uint32_t crc = static_cast<std::uint32_t>(n);
+        for (int bit = 0; bit < 8; ++bit) crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        return crc;
+    }
+};
+
+// The tables themselves: sized to the largest exact 64-bit value
+inline constexpr auto kFactorials = make_table<FactorialGenerator, 21>();
+inline constexpr auto kFibonacci = make_table<FibonacciGenerator, 94>();
+inline constexpr auto kPowersOf10 = make_table<PowerGenerator<10>, 20>();
+inline constexpr auto kCrc32Table = make_table<Crc32Generator, 256>();
+
+// Lookups: n must be below the table size
+constexpr std::uint64_t factorial(std::size_t n) { return kFactorials[n]; }
+constexpr std::uint64_t fibonacci(std::size_t n) { return kFibonacci[n]; }
+constexpr std::uint64_t powerOf10(std::size_t n) { return kPowersOf10[n]; }
+
+// CRC-32 of a byte buffer, one table load per byte
+constexpr std::uint32_t crc32(const unsigned char* bytes, std::size_t length)
+{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        crc = (crc >> 8) ^ kCrc32Table[(crc ^ bytes[i]) & 0xFFu];
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+constexpr std::uint32_t crc32(std::string_view text)
+{
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (char c : text)
+    {
+        crc = (crc >> 8) ^ kCrc32Table[(crc ^ static_cast<unsigned char>(c)) & 0xFFu];
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+#endif
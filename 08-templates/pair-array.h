@@ -0,0 +1,115 @@
+/**
+ * File: pair-array.h
+ * Description: PairArray<K, V>, a sequence of key/value pairs stored as two columns (all keys in
+ * one array, all values in another) instead of one array of std::pair. A scan or binary search
+ * over the keys reads only the key column, and sortByKey moves each value once, after the keys
+ * are sorted. It is the column-store counterpart of the Pair class template in 01-templates.cpp.
+ */
+
+#ifndef PAIR_ARRAY_H
+#define PAIR_ARRAY_H
+
+#include <algorithm>         // For std::sort, std::lower_bound
+#include <cstddef>           // For std::size_t
+#include <cstdint>           // For std::uint32_t
+#include <initializer_list>  // For brace initialization from {key, value} pairs
+#include <stdexcept>         // For std::out_of_range
+#include <utility>           // For std::pair, std::forward, std::move
+#include <vector>            // For the two columns
+
+/**
+ * **PairArray<K, V>**
+ * -   `keys()` / `values()` expose each column as a contiguous `std::vector`, so key-only
+ * loops never load the values (with int keys and 32-byte values, about a tenth of the bytes).
+ * -   `sortByKey()` is stable: equal keys keep their order. The keys are sorted together with
+ * their original positions (K plus a 4-byte index), rewritten in order, and the values are
+ * then moved into a new column in one pass, value i coming from its key's old position.
+ * -   `lowerBound(key)` is a binary search over the key column; the array must be sorted by key.
+ * -   `K` needs `operator<`; `V` only needs to be movable.
+ */
+template <typename K, typename V>
+class PairArray
+{
+   private:
+    std::vector<K> keyColumn;
+    std::vector<V> valueColumn;
+
+    template <typename Index>
+    void sortByKeyWith()
+    {
+        std::vector<std::pair<K, Index>> order;
+        order.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            order.emplace_back(std::move(keyColumn[i]), static_cast<Index>(i));
+        }
+        // Ties compare the original positions, which is what keeps the sort stable
+        std::sort(order.begin(), order.end());
+
+        std::vector<V> sortedValues;
+        sortedValues.reserve(size());
+        for (std::size_t i = 0; i < size(); ++i)
+        {
+            keyColumn[i] = std::move(order[i].first);
+            sortedValues.push_back(std::move(valueColumn[order[i].second]));
+        }
+        valueColumn.swap(sortedValues);
+    }
+
+   public:
+    PairArray() = default;
+
+    PairArray(std::initializer_list<std::pair<K, V>> pairs)
+    {
+        reserve(pairs.size());
+        for (const auto& [key, value] : pairs) push_back(key, value);
+    }
+
+    std::size_t size() const { return keyColumn.size(); }
+    bool empty() const { return keyColumn.empty(); }
+
+    void reserve(std::size_t n)
+    {
+        keyColumn.reserve(n);
+        valueColumn.reserve(n);
+    }
+
+    template <typename KeyArg, typename ValueArg>
+    void push_back(KeyArg&& key, ValueArg&& value)
+    {
+        keyColumn.push_back(std::forward<KeyArg>(key));
+        valueColumn.push_back(std::forward<ValueArg>(value));
+    }
+
+    const K& key(std::size_t i) const { return keyColumn[i]; }
+    V& value(std::size_t i) { return valueColumn[i]; }
+    const V& value(std::size_t i) const { return valueColumn[i]; }
+
+    // Bounds-checked access to one pair
+    std::pair<const K&, V&> at(std::size_t i)
+    {
+        if (i >= size()) throw std::out_of_range("PairArray::at: index out of range");
+        return {keyColumn[i], valueColumn[i]};
+    }
+
+    // Keys are read-only outside the class so a sorted array stays sorted
+    const std::vector<K>& keys() const { return keyColumn; }
+    std::vector<V>& values() { return valueColumn; }
+    const std::vector<V>& values() const { return valueColumn; }
+
+    void sortByKey()
+    {
+        if (size() <= UINT32_MAX)
+            sortByKeyWith<std::uint32_t>();
+        else
+            sortByKeyWith<std::size_t>();
+    }
+
+    // First position whose key is not less than key (size() if none)
+    std::size_t lowerBound(const K& key) const
+    {
+        return std::lower_bound(keyColumn.begin(), keyColumn.end(), key) - keyColumn.begin();
+    }
+};
+
+#endif
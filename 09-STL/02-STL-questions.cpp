@@ -3,13 +3,21 @@
  * Description:
  *  - Q1: Sort integers
  *  - Q2: Unique elements in sorted order
- *  - Q3: Frequency counter
- *  - Q4: Intersection of vectors
+ *  - Q3: Frequency counter (exact, or Count-Min / Space-Saving for streams)
+ *  - Q4: Intersection of vectors (merge, galloping or SIMD blocks)
  *  - Q5: Stack with deque
  *  - Q7: Character frequency in string
  *  - Q8: Check membership in set
- *  - Q9: Basic phonebook with map
- *  - Q10: Sort vector of pairs
+ *  - Q9: Basic phonebook with map (or a flat sorted / hash backend)
+ *  - Q10: Sort pairs by first element (PairArray, ../08-templates/pair-array.h)
+ *  - benchmark_input: `cin >>` vs FastInput on a million integers
+ *  - benchmark_phonebook: map vs flat Phonebook backends
+ *  - benchmark_phonebook_cache: Bloom filter + LRU in front of a store
+ *  - benchmark_frequency: byte histograms and exact vs approximate counters
+ *  - benchmark_intersection: merge / gallop / SIMD posting-list intersection
+ *  - benchmark_sort: std::sort vs radix and parallel sort, set vs sort + unique
+ *  - benchmark_pairs: vector<pair> vs PairArray columns for sorting and key scans
+ * The benchmarks only run with `--benchmarks` (they take several seconds).
  */
 
 #include <iostream>
@@ -19,18 +27,43 @@
 #include <set>
 #include <deque>
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <string_view>
+#include <thread>
+#include "fast-input.h"
+#include "frequency-counter.h"
+#include "integer-sort.h"
+#include "phonebook-cache.h"
+#include "phonebook-stores.h"
+#include "phonebook.h"
+#include "sorted-sets.h"
+#include "../08-templates/pair-array.h"
 
 using namespace std;
 
-/* Utility: Take integer vector input */
+/*
+ * Utility: Take integer vector input
+ * Reads through FastInput, so a large input (e.g. `./a.out < numbers.txt`)
+ * is mapped and parsed in one pass. Stops early if the input ends or holds
+ * something that is not an integer.
+ */
 vector<int> take_input()
 {
-    size_t n;
+    FastInput& in = stdin_reader();
+    size_t n = 0;
     cout << "Enter number of elements: ";
-    cin >> n;
+    in.read(n);
     vector<int> v(n);
     cout << "Enter elements: ";
-    for (auto& it : v) cin >> it;
+    v.resize(in.read_values(v.data(), n));
+    if (v.size() < n)
+        cout << "\nRead " << v.size() << " of " << n << " elements (stopped at \""
+             << in.last_token() << "\")" << endl;
     return v;
 }
 
@@ -41,46 +74,43 @@ void print_vector(const vector<int>& v)
     cout << endl;
 }
 
-/* Q1. Read N integers and print them in sorted order */
+/* Q1. Read N integers and print them in sorted order (radix / parallel sort, integer-sort.h) */
 void Q1()
 {
     auto v = take_input();
-    sort(v.begin(), v.end());
+    integer_sort::sortIntegers(v);
     cout << "Sorted: ";
     print_vector(v);
 }
 
-/* Q2. Print unique elements in increasing order */
+/* Q2. Print unique elements in increasing order: sort + unique instead of a std::set */
 void Q2()
 {
     auto v = take_input();
-    set<int> st(v.begin(), v.end());
+    integer_sort::sortUnique(v);
     cout << "Unique elements: ";
-    for (const auto& it : st) cout << it << " ";
-    cout << endl;
+    print_vector(v);
 }
 
-/* Q3. Frequency counter of integers */
+/* Q3. Frequency counter of integers (frequency-counter.h; exact mode keeps every value) */
 void Q3()
 {
     auto v = take_input();
-    map<int, int> freq;
-    for (const auto& it : v) freq[it]++;
+    FrequencyCounter<int> freq;
+    freq.update(v);
     cout << "Frequencies:\n";
-    for (const auto& it : freq) cout << it.first << ": " << it.second << " ";
+    for (const auto& [value, count] : freq.sortedCounts()) cout << value << ": " << count << " ";
     cout << endl;
 }
 
-/* Q4. Intersection of two vectors */
+/* Q4. Intersection of two vectors (sorted-sets.h: sorts only what is not sorted yet) */
 vector<int> Q4()
 {
     vector<int> A = {1, 2, 2, 3, 4};
     vector<int> B = {2, 2, 4, 6};
-    vector<int> result;
 
-    sort(A.begin(), A.end());
-    sort(B.begin(), B.end());
-    set_intersection(A.begin(), A.end(), B.begin(), B.end(), back_inserter(result));
+    vector<int> result = sorted_sets::intersect(sorted_sets::sortIfNeeded(A),
+                                                sorted_sets::sortIfNeeded(B));
 
     cout << "Intersection: ";
     print_vector(result);
@@ -127,14 +157,15 @@ void Q5()
     stack.pop();  // Extra pop to test empty handling
 }
 
-/* Q7. Frequency of characters in a string using unordered_map */
+/* Q7. Frequency of characters in a string: a 256-entry byte histogram */
 void Q7()
 {
     string text = "frequency_of_each_character_in_string";
-    unordered_map<char, int> freq;
-    for (char ch : text) freq[ch]++;
+    ByteHistogram freq;
+    freq.update(text);
     cout << "Character Frequencies:\n";
-    for (const auto& [ch, count] : freq) cout << ch << ":" << count << "  ";
+    for (int ch = 0; ch < 256; ch++)
+        if (freq.count(ch) > 0) cout << char(ch) << ":" << freq.count(ch) << "  ";
     cout << endl;
 }
 
@@ -143,8 +174,8 @@ void Q8()
 {
     set<int> st = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10};
     cout << "Enter integer to search: ";
-    int x;
-    cin >> x;
+    int x = 0;
+    stdin_reader().read(x);
     auto it = st.find(x);
     if (it != st.end())
         cout << "Found: " << *it << endl;
@@ -152,49 +183,418 @@ void Q8()
         cout << "Not found" << endl;
 }
 
-/* Q9. Basic phone book using map<string, string> */
-class Phonebook
+/* Q9. Basic phone book (Phonebook in phonebook.h) */
+void Q9()
 {
-   private:
-    map<string, string> contacts;
+    Phonebook pb;
+    pb.addNumber("Lana", "94xxxx65");
+    pb.search("JETHALAL");
+    pb.showContacts();
 
-   public:
-    Phonebook() { contacts["JETHALAL"] = "81xxxx93"; }
-    void addNumber(const string& name, const string& number) { contacts[name] = number; }
-    void search(const string& name) const
+    Phonebook<SortedPhoneStore> directory;
+    vector<pair<string, string>> listing = {{"JETHALAL", "81xxxx93"},
+                                            {"Lana", "94xxxx65"},
+                                            {"Babita", "98xxxx12"},
+                                            {"Bagha", "97xxxx40"}};
+    directory.load(listing);
+    cout << "Names starting with \"Ba\":\n";
+    directory.store().forEachWithPrefix("Ba", [](string_view name, string_view number)
+                                        { cout << "  " << name << ": " << number << endl; });
+}
+
+/* Map vs flat backends: build time, memory and lookup time for a million contacts */
+void benchmark_phonebook()
+{
+    const size_t n = 1000000;
+    vector<pair<string, string>> listing(n);
+    mt19937_64 rng(99);
+    for (auto& [name, number] : listing)
     {
-        auto it = contacts.find(name);
-        if (it != contacts.end())
-            cout << name << " found: " << it->second << endl;
+        name = "user" + to_string(rng() % 1000000000000ull);
+        number = "9" + to_string(100000000 + rng() % 900000000);
+    }
+    vector<string> hits(200000), misses(200000);
+    for (auto& name : hits) name = listing[rng() % n].first;
+    for (auto& name : misses) name = "user" + to_string(rng() % 1000000000000ull) + "-";
+
+    auto seconds_since = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+    auto measure = [&](const char* label, auto& book)
+    {
+        auto start = chrono::steady_clock::now();
+        book.load(listing);
+        double build = seconds_since(start);
+        size_t found = 0;
+        start = chrono::steady_clock::now();
+        for (const auto& name : hits) found += book.find(name).has_value();
+        double hit = seconds_since(start) / hits.size();
+        start = chrono::steady_clock::now();
+        for (const auto& name : misses) found += book.find(name).has_value();
+        double miss = seconds_since(start) / misses.size();
+        cout << "  " << label << ": build " << build * 1e3 << " ms, "
+             << book.store().memoryBytes() / (1 << 20) << " MB, hit " << hit * 1e9
+             << " ns, miss " << miss * 1e9 << " ns (" << found << " found)" << endl;
+    };
+
+    cout << "Phonebook with " << n << " contacts:" << endl;
+    {
+        Phonebook<MapPhoneStore> book;
+        measure("map (memory estimated)", book);
+    }
+    {
+        Phonebook<SortedPhoneStore> book;
+        measure("sorted array", book);
+    }
+    {
+        Phonebook<HashPhoneStore> book;
+        measure("flat hash", book);
+    }
+}
+
+/* Q10. Sort pairs by first element (keys and values in separate columns, pair-array.h) */
+void Q10()
+{
+    PairArray<int, int> pairs = {{5, 20}, {1, 99}, {3, 50}, {2, 10}};
+    pairs.sortByKey();
+    cout << "Sorted pairs:\n";
+    for (size_t i = 0; i < pairs.size(); i++) cout << pairs.key(i) << " " << pairs.value(i) << endl;
+}
+
+/* Bulk input: a million integers through `istream >>` and through FastInput */
+void benchmark_input()
+{
+    const size_t n = 1000000;
+    const string path = "/tmp/stl-questions-numbers.txt";
+    {
+        ofstream out(path);
+        unsigned x = 12345;
+        for (size_t i = 0; i < n; i++)
+        {
+            x = x * 1103515245u + 12345u;
+            out << static_cast<int>(x >> 1) - (1 << 30) << (i % 16 == 15 ? '\n' : ' ');
+        }
+    }
+    auto seconds_since = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+
+    auto start = chrono::steady_clock::now();
+    vector<int> streamed(n);
+    {
+        ifstream in(path);
+        for (auto& it : streamed) in >> it;
+    }
+    double stream_time = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    vector<int> mapped(n);
+    {
+        FastInput in(path);
+        in.read_values(mapped.data(), n);
+    }
+    double mapped_time = seconds_since(start);
+
+    start = chrono::steady_clock::now();
+    vector<int> chunked(n);
+    {
+        FILE* file = fopen(path.c_str(), "r");
+        FastInput in(fileno(file), nullptr, 1 << 16, false);  // read() chunks, as from a pipe
+        in.read_values(chunked.data(), n);
+        fclose(file);
+    }
+    double chunked_time = seconds_since(start);
+    remove(path.c_str());
+
+    cout << n << " integers: istream >> " << stream_time * 1e3 << " ms, FastInput mmap "
+         << mapped_time * 1e3 << " ms, FastInput read() " << chunked_time * 1e3
+         << " ms, same values: " << (streamed == mapped && mapped == chunked) << endl;
+}
+
+/*
+ * Traffic that is mostly misses and repeats: 60% absent names, 35% from a
+ * hot set of 2000 names, 5% any contact. Plain vs cached map store.
+ */
+void benchmark_phonebook_cache()
+{
+    const size_t n = 1000000;
+    vector<pair<string, string>> listing(n);
+    mt19937_64 rng(7);
+    for (auto& [name, number] : listing)
+    {
+        name = "user" + to_string(rng() % 1000000000000ull);
+        number = "9" + to_string(100000000 + rng() % 900000000);
+    }
+    vector<string> queries(400000);
+    for (auto& name : queries)
+    {
+        size_t kind = rng() % 100;
+        if (kind < 60)
+            name = "user" + to_string(rng() % 1000000000000ull) + "-";
+        else if (kind < 95)
+            name = listing[rng() % 2000].first;
         else
-            cout << "Not found" << endl;
+            name = listing[rng() % n].first;
+    }
+
+    auto run = [&](const char* label, const auto& book)
+    {
+        size_t found = 0;
+        auto start = chrono::steady_clock::now();
+        for (const auto& name : queries) found += book.find(name).has_value();
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        cout << "  " << label << ": " << ns / queries.size() << " ns per search (" << found
+             << " found)" << endl;
+    };
+
+    cout << "Phonebook searches, 60% misses / 35% hot names:" << endl;
+    Phonebook<MapPhoneStore> plain;
+    plain.load(listing);
+    run("map", plain);
+
+    PhoneCacheOptions options;
+    options.expectedNames = n;
+    options.falsePositiveRate = 0.01;
+    options.cacheEntries = 4096;
+    Phonebook<CachedPhoneStore<MapPhoneStore>> cached(options);
+    cached.load(listing);
+    run("map + filter + LRU", cached);
+
+    PhoneCacheStats stats = cached.store().stats();
+    size_t absent = stats.filterRejects + stats.falsePositives;
+    cout << "  filter rejects " << stats.filterRejects << ", false positives "
+         << stats.falsePositives << " (" << 100.0 * stats.falsePositives / absent
+         << "% of misses), cache hits " << stats.cacheHits << ", store hits " << stats.storeHits
+         << "; filter " << cached.store().nameFilter().memoryBytes() / 1024 << " KB" << endl;
+
+    // An update must be visible even though the old number is cached
+    const string& hot = listing[0].first;
+    cached.addNumber(hot, "90xxxx00");
+    cout << "  after addNumber: " << hot << " -> " << cached.find(hot).value_or("?") << endl;
+}
+
+/* The Q3 / Q7 counters on large inputs */
+void benchmark_frequency()
+{
+    auto ms_since = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); };
+    mt19937_64 rng(5);
+
+    // Bytes: random text, and one long run where a single table stalls on itself
+    const size_t n = 64 << 20;
+    string random_text(n, ' '), run_text(n, 'a');
+    for (char& ch : random_text) ch = char('a' + rng() % 26);
+    cout << "Byte counts over " << (n >> 20) << " MB:" << endl;
+    for (const string* text : {&random_text, &run_text})
+    {
+        auto start = chrono::steady_clock::now();
+        unordered_map<char, int> map_counts;
+        for (char ch : *text) map_counts[ch]++;
+        double map_ms = ms_since(start);
+
+        start = chrono::steady_clock::now();
+        uint64_t single[256] = {};
+        for (char ch : *text) single[static_cast<unsigned char>(ch)]++;
+        double single_ms = ms_since(start);
+
+        start = chrono::steady_clock::now();
+        ByteHistogram histogram;
+        histogram.update(*text);
+        double histogram_ms = ms_since(start);
+        cout << "  " << (text == &random_text ? "random" : "one run") << ": unordered_map "
+             << map_ms << " ms, one table " << single_ms << " ms, ByteHistogram " << histogram_ms
+             << " ms (same counts: " << (histogram.count('a') == single['a']) << ")" << endl;
     }
-    void showContacts() const
+
+    // Integers: skewed stream of 10M values, 1M distinct (value i with weight ~ 1 / i)
+    const size_t m = 10000000;
+    vector<int> values(m);
+    for (auto& v : values)
+        v = static_cast<int>(exp(uniform_real_distribution<double>(0, log(1e6))(rng)));
+    cout << "Integer counts over " << m << " skewed values:" << endl;
+    auto start = chrono::steady_clock::now();
+    map<int, int> tree;
+    for (int v : values) tree[v]++;
+    cout << "  map: " << ms_since(start) << " ms" << endl;
+    for (CountMode mode : {CountMode::exact, CountMode::approximate})
     {
-        cout << "Phonebook:\n";
-        for (const auto& [name, number] : contacts) cout << name << ": " << number << endl;
+        FrequencyOptions options;
+        options.mode = mode;
+        FrequencyCounter<int> counter(options);
+        start = chrono::steady_clock::now();
+        counter.update(values);
+        double elapsed = ms_since(start);
+        uint64_t worst = 0;
+        for (const auto& [value, count] : counter.top(20))
+            worst = max(worst, count - uint64_t(tree[value]));
+        cout << "  " << (mode == CountMode::exact ? "exact" : "approximate") << ": " << elapsed
+             << " ms, " << counter.memoryBytes() / 1024 << " KB, top value "
+             << counter.top(1)[0].first << ", worst top-20 overcount " << worst << endl;
     }
-};
+}
 
-void Q9()
+/* Posting lists: std::set_intersection against each sorted_sets strategy */
+void benchmark_intersection()
 {
-    Phonebook pb;
-    pb.addNumber("Lana", "94xxxx65");
-    pb.search("JETHALAL");
-    pb.showContacts();
+    mt19937_64 rng(11);
+    auto posting_list = [&](size_t n, int universe)
+    {
+        vector<int> list(n);
+        for (auto& x : list) x = static_cast<int>(rng() % universe);
+        sort(list.begin(), list.end());
+        list.erase(unique(list.begin(), list.end()), list.end());
+        return list;
+    };
+    auto time_ns = [](auto&& f)
+    {
+        auto start = chrono::steady_clock::now();
+        size_t found = 0;
+        for (int rep = 0; rep < 5; rep++) found += f();
+        double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        return pair<double, size_t>(ns / 5, found / 5);
+    };
+
+    struct Case
+    {
+        const char* name;
+        vector<int> a, b;
+    };
+    vector<Case> cases;
+    cases.push_back({"1K vs 1M", posting_list(1000, 1 << 24), posting_list(1000000, 1 << 24)});
+    cases.push_back({"1M vs 1M", posting_list(1000000, 1 << 24), posting_list(1000000, 1 << 24)});
+    cout << "Sorted intersection (" << sorted_sets::blockKernelName() << " block kernel):" << endl;
+    vector<int> out(1000000);
+    for (const Case& c : cases)
+    {
+        cout << "  " << c.name << ":";
+        auto [std_ns, std_found] = time_ns(
+            [&]
+            {
+                return size_t(set_intersection(c.a.begin(), c.a.end(), c.b.begin(), c.b.end(),
+                                               out.begin()) -
+                              out.begin());
+            });
+        cout << " std " << std_ns / 1e3 << " us";
+        for (auto [name, method] : {pair{"merge", sorted_sets::Method::merge},
+                                    pair{"gallop", sorted_sets::Method::gallop},
+                                    pair{"simd", sorted_sets::Method::simd},
+                                    pair{"auto", sorted_sets::Method::automatic}})
+        {
+            auto [ns, found] =
+                time_ns([&] { return sorted_sets::intersectInto(c.a, c.b, out.data(), method); });
+            cout << ", " << name << " " << ns / 1e3 << " us" << (found == std_found ? "" : " (!)");
+        }
+        cout << " (" << std_found << " common)" << endl;
+    }
+
+    vector<vector<int>> lists;
+    for (size_t n : {2000000, 500000, 1000000, 20000, 4000000})
+        lists.push_back(posting_list(n, 1 << 23));
+    auto [many_ns, many_found] = time_ns(
+        [&]
+        {
+            vector<sorted_sets::SortedRange> ranges(lists.begin(), lists.end());
+            return sorted_sets::intersectAll(ranges).size();
+        });
+    cout << "  5 lists (20K .. 4M): intersectAll " << many_ns / 1e3 << " us, " << many_found
+         << " common" << endl;
 }
 
-/* Q10. Sort vector of pairs by first element */
-void Q10()
+/* Q1 / Q2 backends on n random ints (100M needs about 1.2 GB) */
+void benchmark_sort(size_t n = 20000000)
 {
-    vector<pair<int, int>> pairs = {{5, 20}, {1, 99}, {3, 50}, {2, 10}};
-    sort(pairs.begin(), pairs.end());
-    cout << "Sorted pairs:\n";
-    for (const auto& [first, second] : pairs) cout << first << " " << second << endl;
+    mt19937 rng(21);
+    vector<int> input(n);
+    for (int& x : input) x = static_cast<int>(rng());
+    auto ms_since = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); };
+
+    cout << "Sorting " << n << " ints (" << thread::hardware_concurrency() << " threads):" << endl;
+    vector<int> expected = input;
+    auto start = chrono::steady_clock::now();
+    sort(expected.begin(), expected.end());
+    cout << "  std::sort " << ms_since(start) << " ms";
+
+    vector<int> work = input;
+    start = chrono::steady_clock::now();
+    integer_sort::radixSort(work);
+    cout << ", radixSort " << ms_since(start) << " ms" << (work == expected ? "" : " (!)");
+
+    work = input;
+    start = chrono::steady_clock::now();
+    integer_sort::parallelSort(work);
+    cout << ", parallelSort " << ms_since(start) << " ms" << (work == expected ? "" : " (!)")
+         << endl;
+
+    // Q2 on a million values with many repeats
+    vector<int> repeats(1000000);
+    for (int& x : repeats) x = static_cast<int>(rng() % 100000);
+    start = chrono::steady_clock::now();
+    set<int> distinct(repeats.begin(), repeats.end());
+    double set_ms = ms_since(start);
+    start = chrono::steady_clock::now();
+    integer_sort::sortUnique(repeats);
+    cout << "  1M values, 100K distinct: std::set " << set_ms << " ms, sortUnique "
+         << ms_since(start) << " ms (same: "
+         << equal(repeats.begin(), repeats.end(), distinct.begin(), distinct.end()) << ")" << endl;
 }
 
-int main()
+/*
+ * Pairs of an int key and a 32-byte record: sorting by key and summing the
+ * keys, as one vector<pair> and as PairArray's two columns
+ */
+void benchmark_pairs(size_t n = 2000000)
 {
+    struct Record
+    {
+        long long fields[4];
+    };
+    mt19937 rng(23);
+    vector<pair<int, Record>> rows(n);
+    PairArray<int, Record> columns;
+    columns.reserve(n);
+    for (size_t i = 0; i < n; i++)
+    {
+        int key = static_cast<int>(rng());
+        long long f = static_cast<long long>(i);
+        rows[i] = {key, Record{{f, f, f, f}}};
+        columns.push_back(key, rows[i].second);
+    }
+    auto ms_since = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count(); };
+
+    cout << n << " (int, 32-byte record) pairs:" << endl;
+    auto start = chrono::steady_clock::now();
+    stable_sort(rows.begin(), rows.end(),
+                [](const auto& a, const auto& b) { return a.first < b.first; });
+    double rows_sort_ms = ms_since(start);
+    start = chrono::steady_clock::now();
+    columns.sortByKey();
+    double columns_sort_ms = ms_since(start);
+    bool same = true;
+    for (size_t i = 0; i < n; i++)
+        same &= rows[i].first == columns.key(i) &&
+                rows[i].second.fields[0] == columns.value(i).fields[0];
+    cout << "  sort by key: vector<pair> " << rows_sort_ms << " ms, PairArray " << columns_sort_ms
+         << " ms (same: " << same << ")" << endl;
+
+    start = chrono::steady_clock::now();
+    long long rows_sum = 0;
+    for (const auto& row : rows) rows_sum += row.first;
+    double rows_scan_ms = ms_since(start);
+    start = chrono::steady_clock::now();
+    long long columns_sum = 0;
+    for (int key : columns.keys()) columns_sum += key;
+    double columns_scan_ms = ms_since(start);
+    cout << "  key scan: vector<pair> " << rows_scan_ms << " ms, PairArray " << columns_scan_ms
+         << " ms (same: " << (rows_sum == columns_sum) << ")" << endl;
+}
+
+// `--benchmarks` runs every benchmark_* below; the questions are enabled by uncommenting them
+int main(int argc, char** argv)
+{
+    bool benchmarks = false;
+    for (int i = 1; i < argc; i++)
+        if (string_view(argv[i]) == "--benchmarks") benchmarks = true;
+
     // Uncomment any question to test:
     // Q1();
     // Q2();
@@ -205,6 +605,19 @@ int main()
     // Q8();
     // Q9();
     // Q10();
+    if (!benchmarks)
+    {
+        cout << "Run with --benchmarks for the input, phonebook, frequency, intersection, sort and "
+                "pair benchmarks\n";
+        return 0;
+    }
+    benchmark_input();
+    benchmark_phonebook();
+    benchmark_phonebook_cache();
+    benchmark_frequency();
+    benchmark_intersection();
+    benchmark_sort();
+    benchmark_pairs();
 
     return 0;
 }
@@ -0,0 +1,279 @@
+#ifndef FAST_INPUT_H
+#define FAST_INPUT_H
+
+#include <cerrno>
+#include <charconv>
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Buffered replacement for `std::cin >> x` followed by `cin.ignore(...)`.
+ *
+ * - Bytes come from one read() of up to buffer_size per refill (ttys and
+ *   pipes hand back what is available, so prompts still work line by line);
+ *   a regular file, including a redirected stdin, is mmapped instead and
+ *   never copied.
+ * - Numbers are parsed with std::from_chars: no locale, no stream state, no
+ *   sync with stdio.
+ * - A bad token is consumed and reported as a ReadStatus; nothing needs to
+ *   be cleared or reset before the next read.
+ *
+ * Tokens and lines are returned as string_views into the buffer and stay
+ * valid only until the next read. POSIX only.
+ */
+
+enum class ReadStatus
+{
+    ok,
+    end_of_input,  // Nothing left to read
+    invalid,       // The token is not a number of the requested type
+    out_of_range,  // A number, but it does not fit the type
+};
+
+/*
+ * Parses all of text as a T (integer or floating point). A leading '+' is
+ * accepted like `cin >>` does; surrounding whitespace is not.
+ */
+template <class T>
+ReadStatus parse_number(std::string_view text, T& value)
+{
+    static_assert(std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+                  "parse_number reads integers and floating point");
+    const char* first = text.data();
+    const char* last = first + text.size();
+    if (first != last && *first == '+')
+    {
+        first++;
+        if (first != last && *first == '-') return ReadStatus::invalid;
+    }
+    if (first == last) return ReadStatus::invalid;
+    std::from_chars_result result = std::from_chars(first, last, value);
+    if (result.ec == std::errc::result_out_of_range) return ReadStatus::out_of_range;
+    if (result.ec != std::errc() || result.ptr != last) return ReadStatus::invalid;
+    return ReadStatus::ok;
+}
+
+class FastInput
+{
+   private:
+    int fd = -1;
+    bool owns_fd = false;
+    std::ostream* tie = nullptr;  // Flushed before every blocking read, like cin.tie()
+    void* mapping = nullptr;
+    std::size_t mapping_size = 0;
+    std::vector<char> buffer;  // Only used when the input is not mapped
+    const char* pos = nullptr;
+    const char* end = nullptr;
+    bool at_eof = false;
+    ReadStatus last_status = ReadStatus::ok;
+    std::string_view token;
+
+    static bool is_space(char c)
+    {
+        return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    // Maps the rest of a regular file; returns false if fd is anything else
+    bool try_map()
+    {
+        struct stat info;
+        if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) return false;
+        off_t offset = ::lseek(fd, 0, SEEK_CUR);
+        if (offset < 0 || offset >= info.st_size)
+        {
+            at_eof = offset >= 0;
+            return at_eof;
+        }
+        off_t page = static_cast<off_t>(::sysconf(_SC_PAGESIZE));
+        off_t aligned = offset - offset % page;
+        mapping_size = static_cast<std::size_t>(info.st_size - aligned);
+        mapping = ::mmap(nullptr, mapping_size, PROT_READ, MAP_PRIVATE, fd, aligned);
+        if (mapping == MAP_FAILED)
+        {
+            mapping = nullptr;
+            return false;
+        }
+        ::madvise(mapping, mapping_size, MADV_SEQUENTIAL);
+        pos = static_cast<const char*>(mapping) + (offset - aligned);
+        end = static_cast<const char*>(mapping) + mapping_size;
+        at_eof = true;  // Everything is already in view
+        ::lseek(fd, 0, SEEK_END);
+        return true;
+    }
+
+    /*
+     * Keeps the unread bytes [pos, end), moves them to the front of the
+     * buffer (growing it if they fill it) and appends one read() worth.
+     * Returns false once the input is exhausted.
+     */
+    bool refill()
+    {
+        if (at_eof) return false;
+        std::size_t keep = static_cast<std::size_t>(end - pos);
+        std::size_t start = static_cast<std::size_t>(pos - buffer.data());
+        if (keep == buffer.size()) buffer.resize(buffer.size() * 2);  // May move the data
+        if (keep > 0) std::memmove(buffer.data(), buffer.data() + start, keep);
+        if (tie) tie->flush();
+        ssize_t got;
+        do
+        {
+            got = ::read(fd, buffer.data() + keep, buffer.size() - keep);
+        } while (got < 0 && errno == EINTR);
+        if (got < 0) throw std::system_error(errno, std::generic_category(), "FastInput: read");
+        if (got == 0) at_eof = true;
+        pos = buffer.data();
+        end = buffer.data() + keep + got;
+        return got > 0;
+    }
+
+    // Skips whitespace; false if the input ends first
+    bool skip_space()
+    {
+        while (true)
+        {
+            while (pos != end && is_space(*pos)) pos++;
+            if (pos != end) return true;
+            if (!refill()) return false;
+        }
+    }
+
+    // Next whitespace-separated token into `token`; false at end of input
+    bool next_token()
+    {
+        if (!skip_space()) return false;
+        std::size_t length = 0;
+        while (true)
+        {
+            while (pos + length != end && !is_space(pos[length])) length++;
+            if (pos + length != end || !refill()) break;  // refill() moves pos, not length
+        }
+        token = std::string_view(pos, length);
+        pos += length;
+        return true;
+    }
+
+   public:
+    /*
+     * Reads from an already open descriptor (0 for stdin) without taking
+     * ownership. Regular files are mapped unless map_regular_files is false.
+     */
+    explicit FastInput(int descriptor, std::ostream* tied = nullptr,
+                       std::size_t buffer_size = 1 << 16, bool map_regular_files = true)
+        : fd(descriptor), tie(tied), buffer(buffer_size > 0 ? buffer_size : 1)
+    {
+        if (!map_regular_files || !try_map()) pos = end = buffer.data();
+    }
+
+    // Opens and maps path; throws std::system_error if it cannot be opened
+    explicit FastInput(const std::string& path) : buffer(1 << 16)
+    {
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "open " + path);
+        owns_fd = true;
+        if (!try_map()) pos = end = buffer.data();
+    }
+
+    FastInput(const FastInput&) = delete;
+    FastInput& operator=(const FastInput&) = delete;
+
+    ~FastInput()
+    {
+        if (mapping) ::munmap(mapping, mapping_size);
+        if (owns_fd) ::close(fd);
+    }
+
+    // Next whitespace-separated number; status() and last_token() describe the outcome
+    template <class T>
+    ReadStatus read(T& value)
+    {
+        if (!next_token())
+        {
+            token = std::string_view();
+            return last_status = ReadStatus::end_of_input;
+        }
+        return last_status = parse_number(token, value);
+    }
+
+    /*
+     * Reads up to count numbers into out and returns how many succeeded;
+     * stops at the first failure, which status() then reports.
+     */
+    template <class T>
+    std::size_t read_values(T* out, std::size_t count)
+    {
+        std::size_t i = 0;
+        while (i < count && read(out[i]) == ReadStatus::ok) i++;
+        return i;
+    }
+
+    // The rest of the current line without '\n' (or "\r\n"); false at end of input
+    bool read_line(std::string_view& line)
+    {
+        if (pos == end && !refill()) return false;
+        std::size_t length = 0;
+        const void* newline;
+        while (true)
+        {
+            newline = std::memchr(pos + length, '\n', static_cast<std::size_t>(end - pos) - length);
+            if (newline) break;
+            length = static_cast<std::size_t>(end - pos);
+            if (!refill()) break;
+        }
+        if (newline) length = static_cast<std::size_t>(static_cast<const char*>(newline) - pos);
+        line = std::string_view(pos, length);
+        pos += newline ? length + 1 : length;
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        return true;
+    }
+
+    /*
+     * Reads one whole line holding exactly one number (blanks around it are
+     * fine): the prompt-and-answer pattern, with no ignore() needed after.
+     */
+    template <class T>
+    ReadStatus read_line_value(T& value)
+    {
+        std::string_view line;
+        if (!read_line(line))
+        {
+            token = std::string_view();
+            return last_status = ReadStatus::end_of_input;
+        }
+        while (!line.empty() && is_space(line.front())) line.remove_prefix(1);
+        while (!line.empty() && is_space(line.back())) line.remove_suffix(1);
+        token = line;
+        return last_status = parse_number(line, value);
+    }
+
+    // Drops the rest of the current line, like cin.ignore(max, '\n')
+    void skip_line()
+    {
+        std::string_view ignored;
+        read_line(ignored);
+    }
+
+    ReadStatus status() const { return last_status; }
+    std::string_view last_token() const { return token; }
+    bool eof() { return !skip_space(); }  // True if only whitespace is left
+    bool mapped() const { return mapping != nullptr; }
+};
+
+// Shared reader for standard input, tied to std::cout so prompts appear before it blocks
+inline FastInput& stdin_reader()
+{
+    static FastInput reader(STDIN_FILENO, &std::cout);
+    return reader;
+}
+
+#endif
@@ -0,0 +1,496 @@
+#ifndef FREQUENCY_COUNTER_H
+#define FREQUENCY_COUNTER_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+ * Streaming frequency counting (Q3 and Q7 in 02-STL-questions.cpp).
+ *
+ * ByteHistogram      exact counts of the 256 byte values. Four interleaved
+ *                    tables: consecutive bytes go to different tables, so a
+ *                    run of equal bytes does not make every increment wait
+ *                    for the store of the one before it.
+ * CountMinSketch<T>  fixed-memory counts of any integers: estimate(x) is
+ *                    never below the true count and, with probability
+ *                    1 - delta, at most epsilon * total above it.
+ * SpaceSaving<T>     the k heaviest values of a stream in k counters.
+ * FrequencyCounter<T> one interface over an exact hash map or, for
+ *                    unbounded streams, the sketch plus its top values.
+ *
+ * Everything is fed with update(pointer, count), update(container) or
+ * add(value); counts are 64-bit.
+ */
+
+namespace frequency_detail
+{
+inline std::uint64_t mix64(std::uint64_t x)
+{
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+template <typename T>
+std::uint64_t keyBits(T value)
+{
+    static_assert(std::is_integral<T>::value, "sketches count integer values");
+    return static_cast<std::uint64_t>(static_cast<std::make_unsigned_t<T>>(value));
+}
+}  // namespace frequency_detail
+
+class ByteHistogram
+{
+   private:
+    std::array<std::uint64_t, 256> totals{};
+    std::uint64_t bytes = 0;
+
+    // Each table sees a quarter of a chunk, so its 32-bit counters cannot overflow
+    static constexpr std::size_t kChunk = std::size_t(1) << 30;
+
+    void countChunk(const unsigned char* p, std::size_t n)
+    {
+        std::uint32_t tables[4][256] = {};
+        std::size_t i = 0;
+        for (; i + 4 <= n; i += 4)
+        {
+            tables[0][p[i]]++;
+            tables[1][p[i + 1]]++;
+            tables[2][p[i + 2]]++;
+            tables[3][p[i + 3]]++;
+        }
+        for (; i < n; i++) tables[i & 3][p[i]]++;
+        for (int c = 0; c < 256; c++)
+            totals[c] += std::uint64_t(tables[0][c]) + tables[1][c] + tables[2][c] + tables[3][c];
+    }
+
+   public:
+    void update(const void* data, std::size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        bytes += size;
+        while (size > 0)
+        {
+            std::size_t chunk = std::min(size, kChunk);
+            countChunk(p, chunk);
+            p += chunk;
+            size -= chunk;
+        }
+    }
+
+    // Any contiguous container of bytes: string, string_view, vector<char>, ...
+    template <typename Range>
+    void update(const Range& range)
+    {
+        static_assert(sizeof(*std::data(range)) == 1, "ByteHistogram counts bytes");
+        update(std::data(range), std::size(range));
+    }
+
+    void add(unsigned char byte)
+    {
+        totals[byte]++;
+        bytes++;
+    }
+
+    std::uint64_t count(unsigned char byte) const { return totals[byte]; }
+    const std::array<std::uint64_t, 256>& counts() const { return totals; }
+    std::uint64_t total() const { return bytes; }
+
+    void reset()
+    {
+        totals.fill(0);
+        bytes = 0;
+    }
+};
+
+/*
+ * depth rows of width counters; a value adds to one counter per row and its
+ * estimate is the smallest of them. width = e / epsilon (rounded up to a
+ * power of two), depth = ln(1 / delta). Updates are conservative: only the
+ * counters that are below the new estimate are raised, which keeps the
+ * same guarantee with a much smaller error on skewed streams.
+ */
+template <typename T>
+class CountMinSketch
+{
+   private:
+    std::vector<std::uint64_t> cells;
+    std::vector<std::uint64_t> seeds;  // Odd multiplier per row
+    std::size_t width = 1;
+    unsigned shift = 64;  // 64 - log2(width)
+    std::uint64_t totalCount = 0;
+
+    std::uint64_t* row(std::size_t r, std::uint64_t hash)
+    {
+        return &cells[r * width + static_cast<std::size_t>((hash * seeds[r]) >> shift)];
+    }
+    const std::uint64_t* row(std::size_t r, std::uint64_t hash) const
+    {
+        return &cells[r * width + static_cast<std::size_t>((hash * seeds[r]) >> shift)];
+    }
+
+   public:
+    CountMinSketch(double epsilon, double delta)
+    {
+        if (!(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1))
+            throw std::invalid_argument("epsilon and delta must be in (0, 1)");
+        double wanted = std::ceil(std::exp(1.0) / epsilon);
+        if (wanted > double(std::size_t(1) << 40)) throw std::length_error("sketch too wide");
+        unsigned bits = 0;
+        while ((std::size_t(1) << bits) < static_cast<std::size_t>(wanted)) bits++;
+        width = std::size_t(1) << bits;
+        shift = 64 - bits;
+        std::size_t depth = static_cast<std::size_t>(std::ceil(std::log(1 / delta)));
+        depth = std::clamp<std::size_t>(depth, 1, 16);
+        cells.assign(depth * width, 0);
+        for (std::size_t r = 0; r < depth; r++)
+            seeds.push_back(frequency_detail::mix64(0x9E3779B97F4A7C15ull * (r + 1)) | 1);
+    }
+
+    // Adds count occurrences and returns the new estimate
+    std::uint64_t add(T value, std::uint64_t count = 1)
+    {
+        const std::uint64_t hash = frequency_detail::mix64(frequency_detail::keyBits(value));
+        std::uint64_t* slots[16] = {};  // Rows are clamped to 16 in the constructor
+        std::uint64_t smallest = UINT64_MAX;
+        for (std::size_t r = 0; r < seeds.size(); r++)
+        {
+            slots[r] = row(r, hash);
+            smallest = std::min(smallest, *slots[r]);
+        }
+        const std::uint64_t raised = smallest + count;
+        for (std::size_t r = 0; r < seeds.size(); r++) *slots[r] = std::max(*slots[r], raised);
+        totalCount += count;
+        return raised;
+    }
+
+    void update(const T* data, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++) add(data[i]);
+    }
+
+    // Upper bound on the count of value
+    std::uint64_t estimate(T value) const
+    {
+        const std::uint64_t hash = frequency_detail::mix64(frequency_detail::keyBits(value));
+        std::uint64_t smallest = UINT64_MAX;
+        for (std::size_t r = 0; r < seeds.size(); r++) smallest = std::min(smallest, *row(r, hash));
+        return smallest;
+    }
+
+    std::size_t sketchWidth() const { return width; }
+    std::size_t sketchDepth() const { return seeds.size(); }
+    std::uint64_t total() const { return totalCount; }
+    std::size_t memoryBytes() const { return cells.size() * sizeof(std::uint64_t); }
+};
+
+namespace frequency_detail
+{
+struct CounterBase
+{
+    std::uint64_t count;
+    std::uint64_t error;  // At most this much of count belongs to other values
+};
+
+// Min-heap of counters by count, with the heap index of every value
+template <typename T>
+class CounterHeap
+{
+   public:
+    struct Counter : CounterBase
+    {
+        T value;
+    };
+    static constexpr std::size_t npos = SIZE_MAX;
+
+   private:
+    std::vector<Counter> heap;
+    std::unordered_map<T, std::size_t> position;
+
+    void place(std::size_t i, const Counter& counter)
+    {
+        heap[i] = counter;
+        position[counter.value] = i;
+    }
+
+    void siftDown(std::size_t i)
+    {
+        Counter moving = heap[i];
+        for (;;)
+        {
+            std::size_t child = 2 * i + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && heap[child + 1].count < heap[child].count) child++;
+            if (heap[child].count >= moving.count) break;
+            place(i, heap[child]);
+            i = child;
+        }
+        place(i, moving);
+    }
+
+   public:
+    explicit CounterHeap(std::size_t capacity)
+    {
+        heap.reserve(capacity);
+        position.reserve(capacity);
+    }
+
+    std::size_t find(T value) const
+    {
+        auto found = position.find(value);
+        return found == position.end() ? npos : found->second;
+    }
+
+    const Counter& at(std::size_t i) const { return heap[i]; }
+    const Counter& smallest() const { return heap[0]; }
+
+    // Raises the count of the counter at index i
+    void raise(std::size_t i, std::uint64_t count)
+    {
+        heap[i].count = count;
+        siftDown(i);
+    }
+
+    void push(T value, std::uint64_t count, std::uint64_t error)
+    {
+        Counter counter;
+        counter.value = value;
+        counter.count = count;
+        counter.error = error;
+        std::size_t i = heap.size();
+        heap.push_back(counter);
+        while (i > 0 && heap[(i - 1) / 2].count > count)
+        {
+            place(i, heap[(i - 1) / 2]);
+            i = (i - 1) / 2;
+        }
+        place(i, counter);
+    }
+
+    // Gives the smallest counter to another value
+    void replaceSmallest(T value, std::uint64_t count, std::uint64_t error)
+    {
+        position.erase(heap[0].value);
+        heap[0].value = value;
+        heap[0].count = count;
+        heap[0].error = error;
+        siftDown(0);
+    }
+
+    // The n largest counters, largest first
+    std::vector<Counter> top(std::size_t n) const
+    {
+        std::vector<Counter> sorted(heap);
+        n = std::min(n, sorted.size());
+        std::partial_sort(sorted.begin(), sorted.begin() + n, sorted.end(),
+                          [](const Counter& a, const Counter& b) { return a.count > b.count; });
+        sorted.resize(n);
+        return sorted;
+    }
+
+    std::size_t size() const { return heap.size(); }
+    std::size_t memoryBytes() const
+    {
+        return heap.capacity() * sizeof(Counter) +
+               position.size() * (sizeof(std::pair<T, std::size_t>) + 2 * sizeof(void*)) +
+               position.bucket_count() * sizeof(void*);
+    }
+};
+}  // namespace frequency_detail
+
+/*
+ * Space-Saving (Metwally et al.): k counters in a min-heap by count. A
+ * value that is not counted takes over the smallest counter and inherits
+ * its count as `error`, so every count is an upper bound, count - error a
+ * lower bound, and any value above total / k is guaranteed to be kept.
+ * Every value not counted yet costs an eviction; FrequencyCounter's
+ * approximate mode avoids that with the sketch.
+ */
+template <typename T>
+class SpaceSaving
+{
+   public:
+    using Counter = typename frequency_detail::CounterHeap<T>::Counter;
+
+   private:
+    frequency_detail::CounterHeap<T> counters;
+    std::size_t capacity;
+
+   public:
+    explicit SpaceSaving(std::size_t k) : counters(k), capacity(k)
+    {
+        if (k == 0) throw std::invalid_argument("Space-Saving needs at least one counter");
+    }
+
+    void add(T value, std::uint64_t count = 1)
+    {
+        std::size_t i = counters.find(value);
+        if (i != counters.npos)
+            counters.raise(i, counters.at(i).count + count);
+        else if (counters.size() < capacity)
+            counters.push(value, count, 0);
+        else
+        {
+            std::uint64_t smallest = counters.smallest().count;
+            counters.replaceSmallest(value, smallest + count, smallest);
+        }
+    }
+
+    void update(const T* data, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++) add(data[i]);
+    }
+
+    // Upper bound on the count of value
+    std::uint64_t estimate(T value) const
+    {
+        std::size_t i = counters.find(value);
+        if (i != counters.npos) return counters.at(i).count;
+        return counters.size() < capacity ? 0 : counters.smallest().count;
+    }
+
+    std::vector<Counter> top(std::size_t n) const { return counters.top(n); }
+    std::size_t size() const { return counters.size(); }
+    std::size_t memoryBytes() const { return counters.memoryBytes(); }
+};
+
+enum class CountMode
+{
+    exact,       // Hash map of every distinct value: exact, memory grows with the distinct count
+    approximate  // Count-Min sketch + top values: fixed memory, counts are upper bounds
+};
+
+struct FrequencyOptions
+{
+    CountMode mode = CountMode::exact;
+    double epsilon = 1e-4;           // Approximate: overestimate at most epsilon * total ...
+    double delta = 1e-3;             // ... except with this probability
+    std::size_t heavyHitters = 256;  // Approximate: values tracked for top()
+};
+
+/*
+ * Approximate mode keeps the heavyHitters values with the largest sketch
+ * estimates in a min-heap. A value whose new estimate does not beat the
+ * heap's smallest is skipped without a lookup: if it were in the heap its
+ * count there could not change. So the long tail of rare values costs one
+ * sketch update each, unlike Space-Saving's eviction per new value.
+ */
+template <typename T>
+class FrequencyCounter
+{
+   private:
+    FrequencyOptions options;
+    std::unordered_map<T, std::uint64_t> exact;
+    std::optional<CountMinSketch<T>> sketch;
+    std::optional<frequency_detail::CounterHeap<T>> heavy;
+    std::uint64_t totalCount = 0;
+
+   public:
+    explicit FrequencyCounter(const FrequencyOptions& counterOptions = FrequencyOptions())
+        : options(counterOptions)
+    {
+        if (options.mode == CountMode::approximate)
+        {
+            sketch.emplace(options.epsilon, options.delta);
+            if (options.heavyHitters == 0) throw std::invalid_argument("heavyHitters must be > 0");
+            heavy.emplace(options.heavyHitters);
+        }
+    }
+
+    void add(T value, std::uint64_t count = 1)
+    {
+        totalCount += count;
+        if (options.mode == CountMode::exact)
+        {
+            exact[value] += count;
+            return;
+        }
+        std::uint64_t estimate = sketch->add(value, count);
+        const bool full = heavy->size() >= options.heavyHitters;
+        if (full && estimate <= heavy->smallest().count) return;
+        std::size_t i = heavy->find(value);
+        if (i != heavy->npos)
+            heavy->raise(i, estimate);
+        else if (!full)
+            heavy->push(value, estimate, 0);
+        else
+            heavy->replaceSmallest(value, estimate, 0);
+    }
+
+    void update(const T* data, std::size_t n)
+    {
+        for (std::size_t i = 0; i < n; i++) add(data[i]);
+    }
+
+    // Any contiguous container of T
+    template <typename Range>
+    void update(const Range& range)
+    {
+        update(std::data(range), std::size(range));
+    }
+
+    // Exact count, or in approximate mode an upper bound
+    std::uint64_t count(T value) const
+    {
+        if (options.mode == CountMode::exact)
+        {
+            auto found = exact.find(value);
+            return found == exact.end() ? 0 : found->second;
+        }
+        return sketch->estimate(value);
+    }
+
+    /*
+     * The n most frequent values, most frequent first. Approximate mode
+     * knows at most heavyHitters of them, ranked by their estimates.
+     */
+    std::vector<std::pair<T, std::uint64_t>> top(std::size_t n) const
+    {
+        std::vector<std::pair<T, std::uint64_t>> result;
+        if (options.mode == CountMode::approximate)
+        {
+            for (const auto& counter : heavy->top(n))
+                result.emplace_back(counter.value, counter.count);
+            return result;
+        }
+        result.assign(exact.begin(), exact.end());
+        n = std::min(n, result.size());
+        auto heavier = [](const auto& a, const auto& b)
+        { return a.second > b.second || (a.second == b.second && a.first < b.first); };
+        std::partial_sort(result.begin(), result.begin() + n, result.end(), heavier);
+        result.resize(n);
+        return result;
+    }
+
+    // Every distinct value with its count, by value; exact mode only
+    std::vector<std::pair<T, std::uint64_t>> sortedCounts() const
+    {
+        if (options.mode != CountMode::exact)
+            throw std::logic_error("an approximate counter does not keep every value");
+        std::vector<std::pair<T, std::uint64_t>> result(exact.begin(), exact.end());
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    CountMode mode() const { return options.mode; }
+    std::uint64_t total() const { return totalCount; }
+
+    std::size_t memoryBytes() const
+    {
+        if (options.mode == CountMode::approximate)
+            return sketch->memoryBytes() + heavy->memoryBytes();
+        return exact.size() * (sizeof(std::pair<T, std::uint64_t>) + 2 * sizeof(void*)) +
+               exact.bucket_count() * sizeof(void*);
+    }
+};
+
+#endif
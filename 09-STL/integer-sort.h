@@ -0,0 +1,244 @@
+#ifndef INTEGER_SORT_H
+#define INTEGER_SORT_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+/*
+ * Sorting backends for 32-bit int keys (Q1 / Q2 in 02-STL-questions.cpp,
+ * secondLargestElementBrute in 11-dsa-sheet/01-arrays).
+ *
+ * radixSort      LSD radix sort, four 8-bit digits. One read pass builds
+ *                all four histograms, then each digit is one scatter pass
+ *                between the data and one scratch buffer (ping-pong; after
+ *                four passes the result is back in the data). A digit that
+ *                is the same in every key is skipped.
+ * parallelSort   threads partition the keys by their most significant
+ *                varying digit into 256 buckets, then sort the buckets
+ *                independently with the radix passes for the lower digits.
+ * sortIntegers   picks std::sort, radixSort or parallelSort by size.
+ * sortUnique     sortIntegers followed by std::unique: the sorted distinct
+ *                values, in place of building a std::set.
+ *
+ * The only allocation is the scratch buffer, n ints, once per call.
+ */
+
+namespace integer_sort
+{
+
+// Below this radix passes cost more than they save
+constexpr std::size_t kRadixThreshold = 256;
+// Below this threads cost more than they save
+constexpr std::size_t kParallelThreshold = std::size_t(1) << 20;
+
+namespace detail
+{
+// Flips the sign bit, so negative keys order before positive ones as unsigned
+inline std::uint32_t key(int x) { return static_cast<std::uint32_t>(x) ^ 0x80000000u; }
+
+// How many keys have each value of each of the four digits
+struct Histograms
+{
+    std::size_t digit[4][256];
+};
+
+inline void countDigits(const int* data, std::size_t n, Histograms& counts)
+{
+    std::memset(&counts, 0, sizeof(Histograms));
+    for (std::size_t i = 0; i < n; i++)
+    {
+        std::uint32_t k = key(data[i]);
+        counts.digit[0][k & 0xFF]++;
+        counts.digit[1][k >> 8 & 0xFF]++;
+        counts.digit[2][k >> 16 & 0xFF]++;
+        counts.digit[3][k >> 24]++;
+    }
+}
+
+// True when every key has the same value of this digit (the pass would not move anything)
+inline bool constantDigit(const std::size_t* counts, std::size_t n)
+{
+    return std::find(counts, counts + 256, n) != counts + 256;
+}
+
+// Stable scatter of src into dst by digit d
+inline void scatter(const int* src, int* dst, std::size_t n, unsigned d, const std::size_t* counts)
+{
+    std::size_t offsets[256];
+    std::size_t sum = 0;
+    for (int b = 0; b < 256; b++)
+    {
+        offsets[b] = sum;
+        sum += counts[b];
+    }
+    const unsigned shift = 8 * d;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        int x = src[i];
+        dst[offsets[key(x) >> shift & 0xFF]++] = x;
+    }
+}
+
+/*
+ * LSD passes over digits [0, digits) with given histograms. The keys start
+ * in src; returns the buffer holding the result (src or the other one).
+ */
+inline int* radixPasses(int* src, int* other, std::size_t n, unsigned digits,
+                        const Histograms& counts)
+{
+    for (unsigned d = 0; d < digits; d++)
+    {
+        if (constantDigit(counts.digit[d], n)) continue;
+        scatter(src, other, n, d, counts.digit[d]);
+        std::swap(src, other);
+    }
+    return src;
+}
+}  // namespace detail
+
+// Sorts data[0, n) using scratch[0, n) as the second buffer
+inline void radixSort(int* data, std::size_t n, int* scratch)
+{
+    if (n < kRadixThreshold)
+    {
+        std::sort(data, data + n);
+        return;
+    }
+    detail::Histograms counts;
+    detail::countDigits(data, n, counts);
+    int* result = detail::radixPasses(data, scratch, n, 4, counts);
+    if (result != data) std::memcpy(data, result, n * sizeof(int));
+}
+
+inline void radixSort(std::vector<int>& v)
+{
+    if (v.size() < kRadixThreshold)
+    {
+        std::sort(v.begin(), v.end());
+        return;
+    }
+    std::vector<int> scratch(v.size());
+    radixSort(v.data(), v.size(), scratch.data());
+}
+
+/*
+ * Partition pass in parallel: per-thread histograms of the top varying
+ * digit, one prefix sum over (bucket, thread), then every thread scatters
+ * its own chunk. Buckets are then handed out through an atomic counter,
+ * largest first, and radix-sorted on the digits below. Keys that all share
+ * their top byte split on the next one, but one huge bucket still lands on
+ * one thread.
+ */
+inline void parallelSort(std::vector<int>& v,
+                         unsigned threads = std::thread::hardware_concurrency())
+{
+    const std::size_t n = v.size();
+    if (threads <= 1 || n < kParallelThreshold)
+    {
+        radixSort(v);
+        return;
+    }
+    std::vector<int> scratch(n);
+    int* data = v.data();
+    const std::size_t chunk = (n + threads - 1) / threads;
+    auto run = [threads](auto&& work)
+    {
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads; t++) pool.emplace_back(work, t);
+        work(0u);
+        for (auto& thread : pool) thread.join();
+    };
+
+    // Histograms of every digit, per thread
+    std::vector<detail::Histograms> perThread(threads);
+    run([&](unsigned t)
+        {
+            std::size_t begin = std::min(n, t * chunk), end = std::min(n, begin + chunk);
+            detail::countDigits(data + begin, end - begin, perThread[t]);
+        });
+    detail::Histograms total = {};
+    for (unsigned t = 0; t < threads; t++)
+        for (int d = 0; d < 4; d++)
+            for (int b = 0; b < 256; b++) total.digit[d][b] += perThread[t].digit[d][b];
+    int top = 3;
+    while (top > 0 && detail::constantDigit(total.digit[top], n)) top--;
+
+    // Bucket b of thread t starts after all smaller buckets and after bucket b of threads < t
+    std::vector<std::size_t> start(threads * 256);
+    std::size_t bucketStart[257];
+    std::size_t sum = 0;
+    for (int b = 0; b < 256; b++)
+    {
+        bucketStart[b] = sum;
+        for (unsigned t = 0; t < threads; t++)
+        {
+            start[t * 256 + b] = sum;
+            sum += perThread[t].digit[top][b];
+        }
+    }
+    bucketStart[256] = n;
+    run([&](unsigned t)
+        {
+            std::size_t begin = std::min(n, t * chunk), end = std::min(n, begin + chunk);
+            std::size_t* offsets = &start[t * 256];
+            const unsigned shift = 8 * top;
+            for (std::size_t i = begin; i < end; i++)
+            {
+                int x = data[i];
+                scratch[offsets[detail::key(x) >> shift & 0xFF]++] = x;
+            }
+        });
+
+    // Every bucket now sits in scratch; sort it on the digits below `top`, back into data
+    int order[256];
+    for (int b = 0; b < 256; b++) order[b] = b;
+    auto bucketSize = [&](int b) { return bucketStart[b + 1] - bucketStart[b]; };
+    std::sort(order, order + 256, [&](int a, int b) { return bucketSize(a) > bucketSize(b); });
+    std::atomic<int> next{0};
+    run([&](unsigned)
+        {
+            for (int i = next++; i < 256; i = next++)
+            {
+                int b = order[i];
+                std::size_t first = bucketStart[b], count = bucketStart[b + 1] - first;
+                if (count == 0) continue;
+                int* src = scratch.data() + first;
+                int* dst = data + first;
+                int* result = src;
+                if (count < kRadixThreshold)
+                    std::sort(src, src + count);
+                else
+                {
+                    detail::Histograms counts;
+                    detail::countDigits(src, count, counts);
+                    result = detail::radixPasses(src, dst, count, top, counts);
+                }
+                if (result != dst) std::memcpy(dst, result, count * sizeof(int));
+            }
+        });
+}
+
+// std::sort for small inputs, radixSort up to kParallelThreshold, parallelSort beyond
+inline void sortIntegers(std::vector<int>& v)
+{
+    if (v.size() < kParallelThreshold)
+        radixSort(v);
+    else
+        parallelSort(v);
+}
+
+// Sorts v and drops repeated values; v ends up holding the distinct values in order
+inline void sortUnique(std::vector<int>& v)
+{
+    sortIntegers(v);
+    v.erase(std::unique(v.begin(), v.end()), v.end());
+}
+
+}  // namespace integer_sort
+
+#endif
@@ -0,0 +1,388 @@
+#ifndef PHONEBOOK_CACHE_H
+#define PHONEBOOK_CACHE_H
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "phonebook-stores.h"
+
+/*
+ * A front for any Phonebook store (phonebook-stores.h), for traffic that is
+ * mostly misses and repeats of recently asked names:
+ *
+ * NameFilter         blocked Bloom filter over the names. "No" is always
+ *                    right, so definite misses never reach the store; "maybe"
+ *                    is wrong with the configured false-positive rate.
+ * ShardedLruCache    bounded LRU of recent hits, split into shards with a
+ *                    lock each so concurrent readers rarely meet.
+ * CachedPhoneStore   find() asks the filter, then the cache, then the store,
+ *                    and counts what answered. insert()/load() keep the
+ *                    filter and the cache in step with the store.
+ *
+ * Concurrent find() calls are safe when the underlying store's are (all of
+ * phonebook-stores.h); insert() and load() need exclusive access.
+ */
+
+struct PhoneCacheOptions
+{
+    std::size_t expectedNames = 1 << 20;  // Filter is sized for this many names
+    double falsePositiveRate = 0.01;      // Share of absent names the filter lets through
+    std::size_t cacheEntries = 4096;      // 0 disables the cache
+    std::size_t cacheShards = 16;         // Rounded up to a power of two
+};
+
+/*
+ * Bloom filter whose k bits for one name all sit in one 64-byte block, so a
+ * lookup costs one cache miss instead of k. Blocks fill unevenly, which
+ * costs false positives; the filter takes more bits than the textbook
+ * formula to make up for it (about 6% at 1%, 20% at 0.01%).
+ */
+class NameFilter
+{
+   private:
+    struct alignas(64) Block
+    {
+        std::uint64_t words[8];
+    };
+
+    std::vector<Block> blocks;
+    unsigned hashes = 1;
+
+    static std::uint64_t remix(std::uint64_t x)
+    {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    // Upper 32 bits of a remixed hash scaled to [0, blocks). hashName's own upper bits
+    // are uneven for similar names, and uneven block loads cost more than predictedRate.
+    std::size_t blockIndex(std::uint64_t hash) const
+    {
+        return static_cast<std::size_t>(((remix(~hash) >> 32) * blocks.size()) >> 32);
+    }
+
+    // Calls f(word, mask) for each of the name's bits: 9 fresh bits (of 512) per probe
+    template <typename F>
+    void forEachBit(std::uint64_t hash, F f) const
+    {
+        std::uint64_t source = remix(hash);
+        for (unsigned i = 0; i < hashes; i++, source >>= 9)
+        {
+            // 7 probes use 63 bits; start each group of 7 from a fresh 64-bit value
+            if (i % 7 == 0 && i) source = remix(hash + i * 0x9E3779B97F4A7C15ull);
+            f(source >> 6 & 7, std::uint64_t(1) << (source & 63));
+        }
+    }
+
+   public:
+    /*
+     * Expected false positive rate with `names` names over `blockCount`
+     * blocks: block loads are Poisson, and a block holding j names has a
+     * given bit set with probability 1 - (1 - 1/512)^(k j).
+     */
+    static double predictedRate(std::size_t names, std::size_t blockCount, unsigned k)
+    {
+        double load = static_cast<double>(names) / static_cast<double>(blockCount);
+        double rate = 0;
+        double weight = std::exp(-load);  // Poisson(j; load), from j = 0
+        std::size_t last = static_cast<std::size_t>(load + 12 * std::sqrt(load) + 24);
+        for (std::size_t j = 0; j <= last; j++)
+        {
+            double bitSet = 1 - std::pow(1 - 1.0 / 512, static_cast<double>(k * j));
+            rate += weight * std::pow(bitSet, k);
+            weight *= load / static_cast<double>(j + 1);
+        }
+        return rate;
+    }
+
+    // Sized so predictedRate(expectedNames, ...) is at most falsePositiveRate
+    NameFilter(std::size_t expectedNames, double falsePositiveRate)
+    {
+        if (!(falsePositiveRate > 0 && falsePositiveRate < 1))
+            throw std::invalid_argument("false positive rate must be in (0, 1)");
+        double k = std::round(-std::log2(falsePositiveRate));
+        hashes = static_cast<unsigned>(k < 1 ? 1 : k > 16 ? 16 : k);
+
+        // Start from the textbook size, then add blocks until the uneven loads are paid for
+        const double ln2 = std::log(2.0);
+        std::size_t n = expectedNames > 0 ? expectedNames : 1;
+        double perName = -std::log(falsePositiveRate) / (ln2 * ln2);
+        double bits = std::ceil(static_cast<double>(n) * perName);
+        std::size_t blockCount = static_cast<std::size_t>(std::ceil(bits / 512));
+        while (predictedRate(n, blockCount, hashes) > falsePositiveRate)
+            blockCount += blockCount / 16 + 1;
+        if (blockCount > UINT32_MAX) throw std::length_error("name filter too large");
+        blocks.assign(blockCount, Block{});
+    }
+
+    void add(std::string_view name)
+    {
+        std::uint64_t hash = phonebook_detail::hashName(name);
+        Block& block = blocks[blockIndex(hash)];
+        forEachBit(hash, [&](unsigned word, std::uint64_t mask) { block.words[word] |= mask; });
+    }
+
+    bool mightContain(std::string_view name) const
+    {
+        std::uint64_t hash = phonebook_detail::hashName(name);
+        const Block& block = blocks[blockIndex(hash)];
+        bool all = true;
+        forEachBit(hash, [&](unsigned word, std::uint64_t mask)
+                   { all &= (block.words[word] & mask) != 0; });
+        return all;
+    }
+
+    void clear() { std::fill(blocks.begin(), blocks.end(), Block{}); }
+
+    // Expected false positive rate once `names` names have been added
+    double expectedRate(std::size_t names) const
+    {
+        return predictedRate(names, blocks.size(), hashes);
+    }
+
+    std::size_t bitCount() const { return blocks.size() * 512; }
+    unsigned hashCount() const { return hashes; }
+    std::size_t memoryBytes() const { return blocks.size() * sizeof(Block); }
+};
+
+/*
+ * LRU map from name to number, capacity spread evenly over the shards. A
+ * name always goes to the same shard; each shard has its own lock, list in
+ * recency order and index into the list.
+ */
+class ShardedLruCache
+{
+   private:
+    struct NameHash
+    {
+        std::size_t operator()(std::string_view name) const
+        {
+            return static_cast<std::size_t>(phonebook_detail::hashName(name));
+        }
+    };
+
+    struct Shard
+    {
+        std::mutex lock;
+        std::list<std::pair<std::string, std::string>> recent;  // Most recent first
+        std::unordered_map<std::string_view, decltype(recent)::iterator, NameHash> index;
+    };
+
+    std::vector<Shard> shards;
+    std::size_t perShard = 0;
+
+    Shard& shardOf(std::string_view name)
+    {
+        return shards[(phonebook_detail::hashName(name) >> 40) & (shards.size() - 1)];
+    }
+
+   public:
+    ShardedLruCache(std::size_t capacity, std::size_t shardCount = 16)
+    {
+        std::size_t count = 1;
+        while (count < shardCount && count < capacity) count *= 2;
+        shards = std::vector<Shard>(count);
+        perShard = (capacity + count - 1) / count;
+    }
+
+    std::optional<std::string> get(std::string_view name)
+    {
+        if (perShard == 0) return std::nullopt;
+        Shard& shard = shardOf(name);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto found = shard.index.find(name);
+        if (found == shard.index.end()) return std::nullopt;
+        shard.recent.splice(shard.recent.begin(), shard.recent, found->second);
+        return found->second->second;
+    }
+
+    // Adds or refreshes a name, evicting the shard's least recent one when full
+    void put(std::string_view name, std::string_view number)
+    {
+        if (perShard == 0) return;
+        Shard& shard = shardOf(name);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto found = shard.index.find(name);
+        if (found != shard.index.end())
+        {
+            found->second->second.assign(number);
+            shard.recent.splice(shard.recent.begin(), shard.recent, found->second);
+            return;
+        }
+        if (shard.index.size() >= perShard)
+        {
+            shard.index.erase(shard.recent.back().first);
+            shard.recent.pop_back();
+        }
+        shard.recent.emplace_front(std::string(name), std::string(number));
+        shard.index.emplace(shard.recent.front().first, shard.recent.begin());
+    }
+
+    // Replaces the number of a cached name; names not cached stay out
+    void update(std::string_view name, std::string_view number)
+    {
+        if (perShard == 0) return;
+        Shard& shard = shardOf(name);
+        std::lock_guard<std::mutex> guard(shard.lock);
+        auto found = shard.index.find(name);
+        if (found != shard.index.end()) found->second->second.assign(number);
+    }
+
+    void clear()
+    {
+        for (Shard& shard : shards)
+        {
+            std::lock_guard<std::mutex> guard(shard.lock);
+            shard.index.clear();
+            shard.recent.clear();
+        }
+    }
+
+    std::size_t capacity() const { return perShard * shards.size(); }
+    std::size_t shardCount() const { return shards.size(); }
+};
+
+// How CachedPhoneStore::find() lookups were answered
+struct PhoneCacheStats
+{
+    std::uint64_t lookups = 0;
+    std::uint64_t filterRejects = 0;   // Definite misses, store not touched
+    std::uint64_t cacheHits = 0;
+    std::uint64_t storeHits = 0;       // Found in the store, now cached
+    std::uint64_t falsePositives = 0;  // Filter said maybe, store said no
+};
+
+template <typename Store>
+class CachedPhoneStore
+{
+   private:
+    Store contacts;
+    PhoneCacheOptions options;
+    NameFilter filter;
+    mutable ShardedLruCache cache;
+    std::size_t filterCapacity;
+
+    struct Counters
+    {
+        std::atomic<std::uint64_t> lookups{0}, filterRejects{0}, cacheHits{0}, storeHits{0},
+            falsePositives{0};
+    };
+    mutable Counters counters;
+
+    static void bump(std::atomic<std::uint64_t>& counter)
+    {
+        counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Past twice the expected names the false positive rate climbs fast: resize and refill
+    void growFilter()
+    {
+        filterCapacity = 2 * contacts.size();
+        filter = NameFilter(filterCapacity, options.falsePositiveRate);
+        contacts.forEach([this](std::string_view name, std::string_view) { filter.add(name); });
+    }
+
+   public:
+    explicit CachedPhoneStore(const PhoneCacheOptions& cacheOptions = PhoneCacheOptions())
+        : options(cacheOptions),
+          filter(cacheOptions.expectedNames, cacheOptions.falsePositiveRate),
+          cache(cacheOptions.cacheEntries, cacheOptions.cacheShards),
+          filterCapacity(cacheOptions.expectedNames)
+    {
+    }
+
+    void insert(std::string_view name, std::string_view number)
+    {
+        contacts.insert(name, number);
+        cache.update(name, number);
+        if (contacts.size() > 2 * filterCapacity)
+            growFilter();
+        else
+            filter.add(name);
+    }
+
+    // A copy of the number: a cached one may be evicted by another reader at any time
+    std::optional<std::string> find(std::string_view name) const
+    {
+        bump(counters.lookups);
+        if (!filter.mightContain(name))
+        {
+            bump(counters.filterRejects);
+            return std::nullopt;
+        }
+        if (auto cached = cache.get(name))
+        {
+            bump(counters.cacheHits);
+            return cached;
+        }
+        auto number = contacts.find(name);
+        if (!number)
+        {
+            bump(counters.falsePositives);
+            return std::nullopt;
+        }
+        bump(counters.storeHits);
+        cache.put(name, *number);
+        return std::string(*number);
+    }
+
+    template <typename Range>
+    void load(const Range& range)
+    {
+        contacts.load(range);
+        cache.clear();
+        if (contacts.size() > filterCapacity)
+            growFilter();
+        else
+        {
+            filter.clear();
+            contacts.forEach([this](std::string_view name, std::string_view) { filter.add(name); });
+        }
+    }
+
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        contacts.forEach(std::forward<F>(f));
+    }
+
+    std::size_t size() const { return contacts.size(); }
+
+    // Store plus filter; the cache adds roughly cacheEntries * (names + numbers + ~100 bytes)
+    std::size_t memoryBytes() const { return contacts.memoryBytes() + filter.memoryBytes(); }
+
+    PhoneCacheStats stats() const
+    {
+        PhoneCacheStats s;
+        s.lookups = counters.lookups.load(std::memory_order_relaxed);
+        s.filterRejects = counters.filterRejects.load(std::memory_order_relaxed);
+        s.cacheHits = counters.cacheHits.load(std::memory_order_relaxed);
+        s.storeHits = counters.storeHits.load(std::memory_order_relaxed);
+        s.falsePositives = counters.falsePositives.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void resetStats()
+    {
+        for (auto* counter : {&counters.lookups, &counters.filterRejects, &counters.cacheHits,
+                              &counters.storeHits, &counters.falsePositives})
+            counter->store(0, std::memory_order_relaxed);
+    }
+
+    const Store& store() const { return contacts; }
+    const NameFilter& nameFilter() const { return filter; }
+    const ShardedLruCache& recentCache() const { return cache; }
+};
+
+#endif
@@ -0,0 +1,407 @@
+#ifndef PHONEBOOK_STORES_H
+#define PHONEBOOK_STORES_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/*
+ * Storage backends for Phonebook (02-STL-questions.cpp). Every store offers
+ *   insert(name, number)           add or replace one contact
+ *   find(name)                     optional<string_view> with the number
+ *   load(range)                    replace everything with a range of pairs
+ *   forEach(f)                     f(name, number) for every contact
+ *   size(), memoryBytes()
+ * Names and numbers are returned as string_views into the store; they stay
+ * valid until the store is modified.
+ *
+ * MapPhoneStore      the original std::map<string, string>
+ * SortedPhoneStore   one arena of characters plus a sorted index of 24-byte
+ *                    entries; binary search, prefix search, name order.
+ *                    Meant to be built once with load(); insert() is O(n).
+ * HashPhoneStore     the same arena and entries, found through an
+ *                    open-addressing table of 8-byte slots; exact lookups
+ *                    only, in no particular order.
+ * With 50M contacts of ~10-byte names and numbers the flat stores need
+ * about 1 GB for the characters plus 1.2 GB for the entries (and 0.5-1 GB
+ * of hash slots), against several GB of nodes and strings for the map.
+ */
+
+namespace phonebook_detail
+{
+// All the characters of one store, back to back
+class StringArena
+{
+   private:
+    std::vector<char> bytes;
+
+   public:
+    std::uint64_t append(std::string_view text)
+    {
+        std::uint64_t offset = bytes.size();
+        bytes.insert(bytes.end(), text.begin(), text.end());
+        return offset;
+    }
+
+    std::string_view view(std::uint64_t offset, std::uint32_t length) const
+    {
+        return std::string_view(bytes.data() + offset, length);
+    }
+
+    void reserve(std::size_t n) { bytes.reserve(n); }
+    void clear() { bytes.clear(); }
+    std::size_t size() const { return bytes.size(); }
+    std::size_t capacity() const { return bytes.capacity(); }
+};
+
+// One contact: name bytes at offset, number bytes right after them
+struct Entry
+{
+    std::uint64_t prefix;  // First 8 name bytes, big-endian: compares like the name itself
+    std::uint64_t offset;
+    std::uint32_t nameLength;
+    std::uint32_t numberLength;
+};
+static_assert(sizeof(Entry) == 24, "Entries are packed into 24 bytes");
+
+inline std::uint64_t namePrefix(std::string_view name)
+{
+    std::uint64_t prefix = 0;
+    for (std::size_t i = 0; i < 8; i++)
+    {
+        unsigned char c = i < name.size() ? static_cast<unsigned char>(name[i]) : 0;
+        prefix = prefix << 8 | c;
+    }
+    return prefix;
+}
+
+// 64-bit hash of a string, eight bytes per step
+inline std::uint64_t hashName(std::string_view name)
+{
+    const std::uint64_t k = 0x9E3779B97F4A7C15ull;
+    std::uint64_t h = name.size() * k;
+    std::size_t i = 0;
+    for (; i + 8 <= name.size(); i += 8)
+    {
+        std::uint64_t word;
+        std::memcpy(&word, name.data() + i, 8);
+        h = (h ^ word) * k;
+        h ^= h >> 32;
+    }
+    std::uint64_t tail = 0;
+    if (i < name.size()) std::memcpy(&tail, name.data() + i, name.size() - i);
+    h = (h ^ tail) * k;
+    return h ^ (h >> 29);
+}
+
+// Shared storage of the flat stores: the arena and the entries that point into it
+class FlatContacts
+{
+   protected:
+    StringArena arena;
+    std::vector<Entry> entries;
+
+    Entry makeEntry(std::string_view name, std::string_view number)
+    {
+        if (name.size() > UINT32_MAX || number.size() > UINT32_MAX)
+            throw std::length_error("Phonebook: contact too long");
+        std::uint64_t offset = arena.append(name);
+        arena.append(number);
+        return Entry{namePrefix(name), offset, static_cast<std::uint32_t>(name.size()),
+                     static_cast<std::uint32_t>(number.size())};
+    }
+
+    std::string_view nameOf(const Entry& e) const { return arena.view(e.offset, e.nameLength); }
+
+    std::string_view numberOf(const Entry& e) const
+    {
+        return arena.view(e.offset + e.nameLength, e.numberLength);
+    }
+
+    // Copies a range of (name, number) pairs into the arena, in range order
+    template <typename Range>
+    void copyIn(const Range& contacts)
+    {
+        arena.clear();
+        entries.clear();
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+        for (const auto& contact : contacts)
+        {
+            count++;
+            bytes += std::string_view(contact.first).size();
+            bytes += std::string_view(contact.second).size();
+        }
+        arena.reserve(bytes);
+        entries.reserve(count);
+        for (const auto& contact : contacts)
+            entries.push_back(makeEntry(contact.first, contact.second));
+    }
+
+   public:
+    std::size_t size() const { return entries.size(); }
+
+    std::size_t memoryBytes() const
+    {
+        return arena.capacity() + entries.capacity() * sizeof(Entry);
+    }
+};
+}  // namespace phonebook_detail
+
+// The original backend: one tree node and two std::strings per contact
+class MapPhoneStore
+{
+   private:
+    std::map<std::string, std::string, std::less<>> contacts;
+
+   public:
+    void insert(std::string_view name, std::string_view number)
+    {
+        contacts.insert_or_assign(std::string(name), std::string(number));
+    }
+
+    std::optional<std::string_view> find(std::string_view name) const
+    {
+        auto it = contacts.find(name);
+        if (it == contacts.end()) return std::nullopt;
+        return std::string_view(it->second);
+    }
+
+    template <typename Range>
+    void load(const Range& range)
+    {
+        contacts.clear();
+        for (const auto& contact : range) insert(contact.first, contact.second);
+    }
+
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        for (const auto& [name, number] : contacts)
+            f(std::string_view(name), std::string_view(number));
+    }
+
+    std::size_t size() const { return contacts.size(); }
+
+    // Estimate: red-black node header plus two strings, and their heap buffers when not inline
+    std::size_t memoryBytes() const
+    {
+        std::size_t bytes = contacts.size() * (32 + 2 * sizeof(std::string));
+        for (const auto& [name, number] : contacts)
+        {
+            if (name.capacity() > 15) bytes += name.capacity() + 1;
+            if (number.capacity() > 15) bytes += number.capacity() + 1;
+        }
+        return bytes;
+    }
+};
+
+/*
+ * Frozen, sorted contacts. load() copies the characters into one arena and
+ * sorts 24-byte entries by name: O(n) when the input is already sorted
+ * (checked first), O(n log n) otherwise. Comparisons look at the 8-byte
+ * prefix held in the entry before touching the arena. A repeated name
+ * keeps its last number, as `contacts[name] = number` would.
+ */
+class SortedPhoneStore : public phonebook_detail::FlatContacts
+{
+   private:
+    using Entry = phonebook_detail::Entry;
+
+    bool nameLess(const Entry& a, std::string_view bName, std::uint64_t bPrefix) const
+    {
+        if (a.prefix != bPrefix) return a.prefix < bPrefix;
+        return nameOf(a) < bName;
+    }
+
+    // First entry whose name is not less than name
+    std::vector<Entry>::const_iterator lowerBound(std::string_view name) const
+    {
+        std::uint64_t prefix = phonebook_detail::namePrefix(name);
+        return std::lower_bound(entries.begin(), entries.end(), name,
+                                [&](const Entry& e, std::string_view key)
+                                { return nameLess(e, key, prefix); });
+    }
+
+   public:
+    template <typename Range>
+    void load(const Range& contacts)
+    {
+        copyIn(contacts);
+        auto less = [this](const Entry& a, const Entry& b)
+        { return nameLess(a, nameOf(b), b.prefix); };
+        if (!std::is_sorted(entries.begin(), entries.end(), less))
+            std::stable_sort(entries.begin(), entries.end(), less);
+        // Keep the last of each run of equal names
+        std::size_t kept = 0;
+        for (std::size_t i = 0; i < entries.size(); i++)
+        {
+            bool lastOfRun =
+                i + 1 == entries.size() || nameOf(entries[i]) != nameOf(entries[i + 1]);
+            if (lastOfRun) entries[kept++] = entries[i];
+        }
+        entries.resize(kept);
+    }
+
+    // Adds or replaces one contact in O(n); use load() for many
+    void insert(std::string_view name, std::string_view number)
+    {
+        auto at = lowerBound(name);
+        std::size_t index = static_cast<std::size_t>(at - entries.begin());
+        Entry entry = makeEntry(name, number);
+        if (at != entries.end() && nameOf(*at) == name)
+            entries[index] = entry;  // The old characters stay in the arena until the next load()
+        else
+            entries.insert(entries.begin() + static_cast<std::ptrdiff_t>(index), entry);
+    }
+
+    std::optional<std::string_view> find(std::string_view name) const
+    {
+        auto at = lowerBound(name);
+        if (at == entries.end() || nameOf(*at) != name) return std::nullopt;
+        return numberOf(*at);
+    }
+
+    // f(name, number) for every contact whose name starts with prefix, in name order
+    template <typename F>
+    std::size_t forEachWithPrefix(std::string_view prefix, F&& f) const
+    {
+        std::size_t count = 0;
+        for (auto at = lowerBound(prefix); at != entries.end(); ++at, ++count)
+        {
+            std::string_view name = nameOf(*at);
+            if (name.compare(0, prefix.size(), prefix) != 0) break;
+            f(name, numberOf(*at));
+        }
+        return count;
+    }
+
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        for (const Entry& e : entries) f(nameOf(e), numberOf(e));
+    }
+};
+
+/*
+ * Exact-lookup contacts. A slot is 8 bytes: the high 32 bits of the name's
+ * hash and the entry index + 1 (0 = empty), so most probes reject a slot
+ * without touching the entry. Linear probing, at most half full; load() is
+ * O(n) expected.
+ */
+class HashPhoneStore : public phonebook_detail::FlatContacts
+{
+   private:
+    using Entry = phonebook_detail::Entry;
+
+    std::vector<std::uint64_t> slots;
+    std::size_t mask = 0;
+
+    static std::uint64_t slotOf(std::uint64_t hash, std::size_t index)
+    {
+        return (hash >> 32) << 32 | static_cast<std::uint64_t>(index + 1);
+    }
+
+    // Slot holding name, or the empty slot where it would go
+    std::size_t probe(std::string_view name, std::uint64_t hash) const
+    {
+        const std::uint64_t tag = hash >> 32;
+        for (std::size_t i = static_cast<std::size_t>(hash) & mask;; i = (i + 1) & mask)
+        {
+            std::uint64_t slot = slots[i];
+            if (slot == 0) return i;
+            if (slot >> 32 == tag && nameOf(entries[(slot & 0xFFFFFFFF) - 1]) == name) return i;
+        }
+    }
+
+    void rehash(std::size_t capacity)
+    {
+        std::size_t size = 16;
+        while (size < 2 * capacity) size *= 2;
+        slots.assign(size, 0);
+        mask = size - 1;
+        for (std::size_t index = 0; index < entries.size(); index++)
+        {
+            std::uint64_t hash = phonebook_detail::hashName(nameOf(entries[index]));
+            std::size_t i = probe(nameOf(entries[index]), hash);
+            if (slots[i] != 0)
+                entries[(slots[i] & 0xFFFFFFFF) - 1] = entries[index];  // Later duplicate wins
+            else
+                slots[i] = slotOf(hash, index);
+        }
+    }
+
+    // Drops the entries that later duplicates replaced, so every entry has exactly one slot
+    void compact()
+    {
+        std::vector<Entry> live;
+        live.reserve(entries.size());
+        for (std::uint64_t& slot : slots)
+        {
+            if (slot == 0) continue;
+            live.push_back(entries[(slot & 0xFFFFFFFF) - 1]);
+            slot = (slot >> 32) << 32 | live.size();
+        }
+        entries.swap(live);
+    }
+
+   public:
+    HashPhoneStore() { rehash(0); }
+
+    template <typename Range>
+    void load(const Range& contacts)
+    {
+        copyIn(contacts);
+        if (entries.size() >= 0xFFFFFFFF) throw std::length_error("HashPhoneStore: too many");
+        rehash(entries.size());
+        compact();
+    }
+
+    void insert(std::string_view name, std::string_view number)
+    {
+        if (2 * (entries.size() + 1) > slots.size()) rehash(entries.size() + 1);
+        std::uint64_t hash = phonebook_detail::hashName(name);
+        std::size_t i = probe(name, hash);
+        if (slots[i] != 0)
+        {
+            entries[(slots[i] & 0xFFFFFFFF) - 1] = makeEntry(name, number);
+            return;
+        }
+        if (entries.size() >= 0xFFFFFFFF) throw std::length_error("HashPhoneStore: too many");
+        entries.push_back(makeEntry(name, number));
+        slots[i] = slotOf(hash, entries.size() - 1);
+    }
+
+    std::optional<std::string_view> find(std::string_view name) const
+    {
+        std::size_t i = probe(name, phonebook_detail::hashName(name));
+        if (slots[i] == 0) return std::nullopt;
+        return numberOf(entries[(slots[i] & 0xFFFFFFFF) - 1]);
+    }
+
+    template <typename F>
+    void forEach(F&& f) const
+    {
+        for (std::uint64_t slot : slots)
+        {
+            if (slot == 0) continue;
+            const Entry& e = entries[(slot & 0xFFFFFFFF) - 1];
+            f(nameOf(e), numberOf(e));
+        }
+    }
+
+    std::size_t memoryBytes() const
+    {
+        return FlatContacts::memoryBytes() + slots.capacity() * sizeof(std::uint64_t);
+    }
+};
+
+#endif
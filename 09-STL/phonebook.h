@@ -0,0 +1,67 @@
+#ifndef PHONEBOOK_H
+#define PHONEBOOK_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include "phonebook-stores.h"
+
+/*
+ * Q9. Basic phone book, by default over map<string, string>
+ * The storage is a template parameter (phonebook-stores.h): MapPhoneStore is
+ * the original map, SortedPhoneStore a frozen sorted array with prefix
+ * search, HashPhoneStore a flat hash table for exact lookups.
+ * CachedPhoneStore<Store> (phonebook-cache.h) puts a Bloom filter and an LRU
+ * cache of recent hits in front of any of them.
+ */
+template <typename Store = MapPhoneStore>
+class Phonebook
+{
+   private:
+    Store contacts;
+
+   public:
+    Phonebook() { contacts.insert("JETHALAL", "81xxxx93"); }
+
+    // Passes options (e.g. PhoneCacheOptions) to the store's constructor
+    template <typename Options>
+    explicit Phonebook(const Options& options) : contacts(options)
+    {
+        contacts.insert("JETHALAL", "81xxxx93");
+    }
+
+    // Replaces every contact with a range of (name, number) pairs in one pass
+    template <typename Range>
+    void load(const Range& range)
+    {
+        contacts.load(range);
+    }
+
+    void addNumber(const std::string& name, const std::string& number)
+    {
+        contacts.insert(name, number);
+    }
+
+    // optional<string_view> into the store, or optional<string> from a cached store
+    auto find(std::string_view name) const { return contacts.find(name); }
+
+    void search(const std::string& name) const
+    {
+        auto number = contacts.find(name);
+        if (number)
+            std::cout << name << " found: " << *number << std::endl;
+        else
+            std::cout << "Not found" << std::endl;
+    }
+
+    void showContacts() const
+    {
+        std::cout << "Phonebook:\n";
+        contacts.forEach([](std::string_view name, std::string_view number)
+                         { std::cout << name << ": " << number << std::endl; });
+    }
+
+    const Store& store() const { return contacts; }
+};
+
+#endif
@@ -0,0 +1,328 @@
+#ifndef SORTED_SETS_H
+#define SORTED_SETS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SORTED_SETS_X86 1
+#endif
+
+/*
+ * Intersection, union and difference of sorted int lists (posting lists),
+ * for Q4 in 02-STL-questions.cpp. Results match std::set_intersection,
+ * std::set_union and std::set_difference, duplicates included.
+ *
+ * intersect() picks one of three strategies:
+ * - gallop  when one side is kGallopRatio times longer or more: every
+ *           element of the short side is found in the long one by
+ *           exponential search, O(small * log(large / small));
+ * - simd    for similar sizes when both sides are strictly increasing:
+ *           blocks of 4 (SSE2) or 8 (AVX2, chosen at runtime) are compared
+ *           all-against-all and the block with the smaller maximum moves on;
+ * - merge   the linear two-pointer merge, for everything else.
+ * unite() and subtract() gallop on skewed sizes and merge otherwise;
+ * intersectAll() intersects the shortest lists first.
+ *
+ * Inputs are SortedRange views: making one is the promise that the ints are
+ * already sorted, so nothing is copied or sorted again. sortIfNeeded()
+ * sorts a vector only when it is not sorted yet.
+ */
+
+namespace sorted_sets
+{
+
+// Non-owning view of ints in non-decreasing order (std::span is C++20)
+struct SortedRange
+{
+    const int* data = nullptr;
+    std::size_t size = 0;
+
+    SortedRange() = default;
+    SortedRange(const int* first, std::size_t count) : data(first), size(count) {}
+    SortedRange(const std::vector<int>& v) : data(v.data()), size(v.size()) {}
+
+    const int* begin() const { return data; }
+    const int* end() const { return data + size; }
+};
+
+enum class Method
+{
+    automatic,
+    merge,
+    gallop,
+    simd,  // Falls back to merge unless both sides are strictly increasing
+};
+
+// A side this many times longer than the other makes intersect() gallop
+constexpr std::size_t kGallopRatio = 32;
+
+// Sorts v unless it already is (one linear check), and returns it as a SortedRange
+inline SortedRange sortIfNeeded(std::vector<int>& v)
+{
+    if (!std::is_sorted(v.begin(), v.end())) std::sort(v.begin(), v.end());
+    return SortedRange(v);
+}
+
+inline bool strictlyIncreasing(SortedRange r)
+{
+    std::size_t i = 0;
+#if defined(SORTED_SETS_X86)
+    for (; i + 5 <= r.size; i += 4)
+    {
+        __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.data + i));
+        __m128i next = _mm_loadu_si128(reinterpret_cast<const __m128i*>(r.data + i + 1));
+        if (_mm_movemask_epi8(_mm_cmpgt_epi32(next, cur)) != 0xFFFF) return false;
+    }
+#endif
+    for (; i + 1 < r.size; i++)
+        if (r.data[i] >= r.data[i + 1]) return false;
+    return true;
+}
+
+// First index in [from, n) whose value is >= x, by doubling steps from `from`
+inline std::size_t gallop(const int* a, std::size_t n, std::size_t from, int x)
+{
+    if (from >= n || a[from] >= x) return from;
+    std::size_t below = from, step = 1;  // a[below] < x
+    while (below + step < n && a[below + step] < x)
+    {
+        below += step;
+        step *= 2;
+    }
+    std::size_t limit = std::min(below + step, n);
+    return static_cast<std::size_t>(std::lower_bound(a + below + 1, a + limit, x) - a);
+}
+
+// ---- Intersection kernels: write into out (room for the shorter side), return the count ----
+
+inline std::size_t intersectMerge(const int* a, std::size_t na, const int* b, std::size_t nb,
+                                  int* out)
+{
+    std::size_t i = 0, j = 0, k = 0;
+    while (i < na && j < nb)
+    {
+        int x = a[i], y = b[j];
+        if (x == y) out[k++] = x;
+        i += x <= y;
+        j += y <= x;
+    }
+    return k;
+}
+
+// a is the short side
+inline std::size_t intersectGallop(const int* a, std::size_t na, const int* b, std::size_t nb,
+                                   int* out)
+{
+    std::size_t j = 0, k = 0;
+    for (std::size_t i = 0; i < na; i++)
+    {
+        j = gallop(b, nb, j, a[i]);
+        if (j == nb) break;
+        if (b[j] == a[i])
+        {
+            out[k++] = a[i];
+            j++;
+        }
+    }
+    return k;
+}
+
+#if defined(SORTED_SETS_X86)
+
+// Strictly increasing inputs only: a value of a block can match at most one of the other block
+inline std::size_t intersectSse2(const int* a, std::size_t na, const int* b, std::size_t nb,
+                                 int* out)
+{
+    std::size_t i = 0, j = 0, k = 0;
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + j));
+        __m128i match = _mm_cmpeq_epi32(va, vb);
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x39)));
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x4E)));
+        match = _mm_or_si128(match, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, 0x93)));
+        for (int mask = _mm_movemask_ps(_mm_castsi128_ps(match)); mask; mask &= mask - 1)
+            out[k++] = a[i + __builtin_ctz(mask)];
+        int lastA = a[i + 3], lastB = b[j + 3];
+        i += lastA <= lastB ? 4 : 0;
+        j += lastB <= lastA ? 4 : 0;
+    }
+    return k + intersectMerge(a + i, na - i, b + j, nb - j, out + k);
+}
+
+// Same with 8 lanes: four in-lane rotations of b's block and of its swapped halves
+__attribute__((target("avx2"))) inline std::size_t intersectAvx2(const int* a, std::size_t na,
+                                                                 const int* b, std::size_t nb,
+                                                                 int* out)
+{
+    std::size_t i = 0, j = 0, k = 0;
+    while (i + 8 <= na && j + 8 <= nb)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + j));
+        __m256i swapped = _mm256_permute2x128_si256(vb, vb, 1);
+        __m256i m0 = _mm256_or_si256(_mm256_cmpeq_epi32(va, vb),
+                                     _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, 0x39)));
+        __m256i m1 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, 0x4E)),
+                                     _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(vb, 0x93)));
+        __m256i m2 = _mm256_or_si256(_mm256_cmpeq_epi32(va, swapped),
+                                     _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(swapped, 0x39)));
+        __m256i m3 = _mm256_or_si256(_mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(swapped, 0x4E)),
+                                     _mm256_cmpeq_epi32(va, _mm256_shuffle_epi32(swapped, 0x93)));
+        __m256i match = _mm256_or_si256(_mm256_or_si256(m0, m1), _mm256_or_si256(m2, m3));
+        for (int mask = _mm256_movemask_ps(_mm256_castsi256_ps(match)); mask; mask &= mask - 1)
+            out[k++] = a[i + __builtin_ctz(mask)];
+        int lastA = a[i + 7], lastB = b[j + 7];
+        i += lastA <= lastB ? 8 : 0;
+        j += lastB <= lastA ? 8 : 0;
+    }
+    return k + intersectSse2(a + i, na - i, b + j, nb - j, out + k);
+}
+
+#endif
+
+using IntersectKernel = std::size_t (*)(const int*, std::size_t, const int*, std::size_t, int*);
+
+// Block kernel for strictly increasing inputs, picked once for this CPU
+inline IntersectKernel blockKernel()
+{
+#if defined(SORTED_SETS_X86)
+    static const IntersectKernel best =
+        __builtin_cpu_supports("avx2") ? intersectAvx2 : intersectSse2;
+    return best;
+#else
+    return intersectMerge;
+#endif
+}
+
+inline const char* blockKernelName()
+{
+#if defined(SORTED_SETS_X86)
+    return blockKernel() == intersectAvx2 ? "avx2" : "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+// ---- Public entry points ----
+
+// Writes a ∩ b to out, which needs room for min(a.size, b.size) ints; returns the count
+inline std::size_t intersectInto(SortedRange a, SortedRange b, int* out,
+                                 Method method = Method::automatic)
+{
+    if (a.size > b.size) std::swap(a, b);  // a is the short side from here on
+    if (a.size == 0) return 0;
+    if (method == Method::automatic)
+    {
+        if (b.size / a.size >= kGallopRatio)
+            method = Method::gallop;
+        else
+            method = Method::simd;
+    }
+    switch (method)
+    {
+        case Method::gallop:
+            return intersectGallop(a.data, a.size, b.data, b.size, out);
+        case Method::simd:
+            if (a.size >= 8 && strictlyIncreasing(a) && strictlyIncreasing(b))
+                return blockKernel()(a.data, a.size, b.data, b.size, out);
+            return intersectMerge(a.data, a.size, b.data, b.size, out);
+        default:
+            return intersectMerge(a.data, a.size, b.data, b.size, out);
+    }
+}
+
+inline std::vector<int> intersect(SortedRange a, SortedRange b,
+                                  Method method = Method::automatic)
+{
+    std::vector<int> result(std::min(a.size, b.size));
+    result.resize(intersectInto(a, b, result.data(), method));
+    return result;
+}
+
+inline std::vector<int> unite(SortedRange a, SortedRange b)
+{
+    std::vector<int> result;
+    result.reserve(a.size + b.size);
+    if (a.size > b.size) std::swap(a, b);
+    if (a.size == 0 || b.size / a.size < kGallopRatio)
+    {
+        std::set_union(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+        return result;
+    }
+    // Copy the long side in runs between the short side's values
+    std::size_t j = 0;
+    for (int x : a)
+    {
+        std::size_t next = gallop(b.data, b.size, j, x);
+        result.insert(result.end(), b.data + j, b.data + next);
+        j = next;
+        if (j < b.size && b.data[j] == x) j++;  // x stands for the pair
+        result.push_back(x);
+    }
+    result.insert(result.end(), b.data + j, b.end());
+    return result;
+}
+
+// Elements of a that are not in b (each b value cancels one equal a value)
+inline std::vector<int> subtract(SortedRange a, SortedRange b)
+{
+    std::vector<int> result;
+    result.reserve(a.size);
+    if (b.size > 0 && a.size / b.size >= kGallopRatio)
+    {
+        std::size_t i = 0;
+        for (int y : b)
+        {
+            std::size_t next = gallop(a.data, a.size, i, y);
+            result.insert(result.end(), a.data + i, a.data + next);
+            i = next;
+            if (i < a.size && a.data[i] == y) i++;
+        }
+        result.insert(result.end(), a.data + i, a.end());
+    }
+    else if (a.size > 0 && b.size / a.size >= kGallopRatio)
+    {
+        std::size_t j = 0;
+        for (int x : a)
+        {
+            j = gallop(b.data, b.size, j, x);
+            if (j < b.size && b.data[j] == x)
+                j++;
+            else
+                result.push_back(x);
+        }
+    }
+    else
+        std::set_difference(a.begin(), a.end(), b.begin(), b.end(), std::back_inserter(result));
+    return result;
+}
+
+/*
+ * Intersection of every list. Shortest lists go first, so the running
+ * result is small from the start and meets the long lists by galloping.
+ */
+inline std::vector<int> intersectAll(std::vector<SortedRange> lists)
+{
+    if (lists.empty()) return {};
+    std::sort(lists.begin(), lists.end(),
+              [](const SortedRange& x, const SortedRange& y) { return x.size < y.size; });
+    std::vector<int> result(lists[0].begin(), lists[0].end());
+    std::vector<int> scratch(result.size());
+    for (std::size_t l = 1; l < lists.size() && !result.empty(); l++)
+    {
+        scratch.resize(intersectInto(result, lists[l], scratch.data()));
+        std::swap(result, scratch);
+        scratch.resize(result.size());
+    }
+    return result;
+}
+
+}  // namespace sorted_sets
+
+#endif
@@ -1,4 +1,8 @@
+#include <chrono>
 #include <iostream>
+#include <thread>
+#include <vector>
+#include "fast-math.h"
 using namespace std;
 
 /*
@@ -64,6 +68,66 @@ int powerOfNumber(int a, int p)
     return a * powerOfNumber(a, p - 1);
 }
 
+/*
+ * Times the recursive reference versions against fast_math and checks that
+ * they agree. Build with optimizations, e.g.
+ *   g++ -O2 -std=c++17 -pthread 01-level-1-question-recursion.cpp
+ */
+void benchmarkFastMath()
+{
+    auto secondsSince = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+
+    const int n = 32;
+    auto start = chrono::steady_clock::now();
+    int slow = nthFibonacci(n);
+    double recursive = secondsSince(start);
+
+    const int kRepeats = 1000000;
+    uint64_t checksum = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < kRepeats; i++) checksum += fast_math::fibonacci(i % 94);
+    double doubling = secondsSince(start) / kRepeats;
+
+    cout << "F(" << n << "): recursive " << slow << " in " << recursive * 1e3 << " ms, fast "
+         << fast_math::fibonacci(n) << ", " << doubling * 1e9 << " ns per call (checksum "
+         << checksum << ")" << endl;
+
+    start = chrono::steady_clock::now();
+    long long linear = 0;
+    for (int i = 0; i < kRepeats; i++) linear += powerOfNumber(3, 19 - i % 4);
+    double recursivePower = secondsSince(start) / kRepeats;
+    start = chrono::steady_clock::now();
+    long long squaring = 0;
+    for (int i = 0; i < kRepeats; i++) squaring += fast_math::power<int>(3, 19 - i % 4);
+    double fastPower = secondsSince(start) / kRepeats;
+    cout << "3^16..3^19: recursive " << recursivePower * 1e9 << " ns, squaring "
+         << fastPower * 1e9 << " ns per call, sums " << linear << " / " << squaring << endl;
+
+    // Memo shared by several threads asking overlapping questions
+    fast_math::FibonacciMemo memo;
+    const uint64_t kMod = 1000000007;
+    const uint64_t kQueries = 200000;
+    auto index = [](uint64_t q) { return 1000000000000ull + q % 1000; };  // 1000 distinct n
+    vector<thread> workers;
+    vector<uint64_t> sums(4, 0);
+    start = chrono::steady_clock::now();
+    for (int t = 0; t < 4; t++)
+        workers.emplace_back(
+            [&, t]
+            {
+                for (uint64_t q = 0; q < kQueries; q++) sums[t] += memo.get(index(q), kMod);
+            });
+    for (thread& worker : workers) worker.join();
+    double memoTime = secondsSince(start) / (4 * kQueries);
+    start = chrono::steady_clock::now();
+    uint64_t direct = 0;
+    for (uint64_t q = 0; q < kQueries; q++) direct += fast_math::fibonacciMod(index(q), kMod);
+    double directTime = secondsSince(start) / kQueries;
+    cout << "F(10^12 + q) mod 1e9+7: memo " << memoTime * 1e9 << " ns, direct " << directTime * 1e9
+         << " ns per query, results agree: " << (sums[0] == direct) << endl;
+}
+
 int main()
 {
     cout << "Factorial of 5: " << factorial(5) << endl;
@@ -80,5 +144,24 @@ int main()
     cout << "10th Fibonacci number: " << nthFibonacci(10) << endl;
     cout << "10^3: " << powerOfNumber(10, 3) << endl;
 
+    // Same questions in O(log n), with wider types and a modulus
+    cout << "90th Fibonacci number: " << fast_math::fibonacci(90) << endl;
+    cout << "186th Fibonacci number: " << fast_math::toString(fast_math::fibonacci128(186)) << endl;
+    cout << "10^18th Fibonacci number mod 1e9+7: "
+         << fast_math::fibonacciMod(1000000000000000000ull, 1000000007) << endl;
+    cout << "2^100: " << fast_math::toString(fast_math::power<fast_math::uint128>(2, 100)) << endl;
+    cout << "3^(10^18) mod 1e9+7: " << fast_math::powerMod(3, 1000000000000000000ull, 1000000007)
+         << endl;
+    try
+    {
+        fast_math::power<int>(10, 10);  // powerOfNumber would silently overflow here
+    }
+    catch (const overflow_error& error)
+    {
+        cout << "10^10 as int: " << error.what() << endl;
+    }
+
+    benchmarkFastMath();
+
     return 0;
 }
@@ -18,6 +18,10 @@
 // Find the product of all elements recursively.
 #include <iostream>
 #include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+#include "string-view-algorithms.h"
 using namespace std;
 
 bool checkPalindrome(string str)
@@ -39,11 +43,66 @@ string reverseString(string str)
     return reverseString(str.substr(1)) + str[0];
 }
 
+/*
+ * Copying/recursive versions above vs the string_view versions on large input.
+ * Build with optimizations, e.g.
+ *   g++ -O2 -std=c++17 02-level-2-question-recursion.cpp
+ */
+void benchmarkStringViews()
+{
+    auto secondsSince = [](chrono::steady_clock::time_point start)
+    { return chrono::duration<double>(chrono::steady_clock::now() - start).count(); };
+
+    // 8 MB mixed-case palindrome
+    const size_t half = 4 << 20;
+    string big(2 * half, ' ');
+    for (size_t i = 0; i < half; i++)
+    {
+        char c = static_cast<char>('a' + i % 26);
+        big[i] = c;
+        big[2 * half - 1 - i] = static_cast<char>(i % 3 == 0 ? c - 32 : c);  // Some upper case
+    }
+
+    auto start = chrono::steady_clock::now();
+    bool copied = checkPalindrome(big);
+    double copyTime = secondsSince(start);
+    start = chrono::steady_clock::now();
+    bool viewed = isPalindrome(big);
+    double viewTime = secondsSince(start);
+    cout << "8 MB palindrome: checkPalindrome " << copied << " in " << copyTime * 1e3
+         << " ms, isPalindrome " << viewed << " in " << viewTime * 1e3 << " ms" << endl;
+
+    // reverseString is O(n^2), so give it a much smaller input
+    string small = big.substr(0, 20000);
+    start = chrono::steady_clock::now();
+    string recursive = reverseString(small);
+    double recursiveTime = secondsSince(start);
+
+    vector<char> buffer(big.size());
+    start = chrono::steady_clock::now();
+    string_view reversed = reverseInto(big, buffer.data(), buffer.size());
+    double intoTime = secondsSince(start);
+    start = chrono::steady_clock::now();
+    reverseInPlace(big);
+    double inPlaceTime = secondsSince(start);
+
+    cout << "reverseString 20 KB: " << recursiveTime * 1e3 << " ms; reverseInto 8 MB: "
+         << intoTime * 1e3 << " ms; reverseInPlace 8 MB: " << inPlaceTime * 1e3
+         << " ms, results agree: " << (reversed == big) << endl;
+}
+
 int main()
 {
     checkPalindrome("radar") ? cout << "true" : cout << "false";
     cout << endl;
     cout<<reverseString("reverse");
     cout << endl;
+
+    // Same answers without copies; the literals are viewed, not turned into std::string
+    cout << boolalpha << isPalindrome("Radar") << " " << isPalindrome("Radar", false) << endl;
+    char buffer[16];
+    cout << reverseInto("reverse", buffer, sizeof(buffer)) << endl;
+
+    benchmarkStringViews();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,255 @@
+#ifndef FAST_MATH_H
+#define FAST_MATH_H
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+/*
+ * Logarithmic-time replacements for nthFibonacci and powerOfNumber in
+ * 01-level-1-question-recursion.cpp. The recursive versions there stay as the
+ * reference definitions; these give the same answers in O(log n) steps and
+ * report overflow instead of silently wrapping.
+ *
+ * 128-bit variants need a compiler with __int128 (GCC, Clang).
+ */
+
+namespace fast_math
+{
+#ifdef __SIZEOF_INT128__
+using uint128 = unsigned __int128;
+using int128 = __int128;
+
+// Decimal text of a 128-bit value (iostream cannot print __int128)
+inline std::string toString(uint128 value)
+{
+    std::string digits;
+    do
+    {
+        digits.insert(digits.begin(), static_cast<char>('0' + static_cast<int>(value % 10)));
+        value /= 10;
+    } while (value != 0);
+    return digits;
+}
+
+inline std::string toString(int128 value)
+{
+    if (value >= 0) return toString(static_cast<uint128>(value));
+    return "-" + toString(static_cast<uint128>(0) - static_cast<uint128>(value));
+}
+#endif
+
+// (a * b) % m without overflow, for any 64-bit a, b and m > 0
+inline uint64_t mulMod(uint64_t a, uint64_t b, uint64_t m)
+{
+#ifdef __SIZEOF_INT128__
+    return static_cast<uint64_t>(static_cast<uint128>(a) * b % m);
+#else
+    // Double-and-add fallback, O(64) steps
+    uint64_t result = 0;
+    a %= m;
+    while (b > 0)
+    {
+        if (b & 1) result = (result >= m - a) ? result - (m - a) : result + a;
+        a = (a >= m - a) ? a - (m - a) : a + a;
+        b >>= 1;
+    }
+    return result;
+#endif
+}
+
+// Index of the top set bit of n, -1 for n == 0
+inline int highestBit(uint64_t n) { return n == 0 ? -1 : 63 - __builtin_clzll(n); }
+
+/*
+ * Fast doubling: with F(k) and F(k+1) known,
+ *   F(2k)   = F(k) * (2 F(k+1) - F(k))
+ *   F(2k+1) = F(k)^2 + F(k+1)^2
+ * Walking the bits of n from the top gives F(n) in about log2(n) steps.
+ * Arithmetic is done in T and wraps modulo 2^bits for unsigned T, so callers
+ * check n against the largest exact index first.
+ */
+template <typename T>
+T fibonacciDoubling(uint64_t n)
+{
+    T a = 0;  // F(k)
+    T b = 1;  // F(k+1)
+    for (int bit = highestBit(n); bit >= 0; bit--)
+    {
+        T even = a * (2 * b - a);  // F(2k)
+        T odd = a * a + b * b;     // F(2k+1)
+        if ((n >> bit) & 1)
+        {
+            a = odd;
+            b = even + odd;
+        }
+        else
+        {
+            a = even;
+            b = odd;
+        }
+    }
+    return a;
+}
+
+const uint64_t kMaxFibonacci64 = 93;  // F(93) is the largest Fibonacci number below 2^64
+
+/*
+ * F(n), exact.
+ * Throws std::overflow_error if n > 93 (use fibonacci128 or fibonacciMod).
+ */
+inline uint64_t fibonacci(uint64_t n)
+{
+    if (n > kMaxFibonacci64) throw std::overflow_error("fibonacci: F(n) does not fit in 64 bits");
+    return fibonacciDoubling<uint64_t>(n);
+}
+
+#ifdef __SIZEOF_INT128__
+const uint64_t kMaxFibonacci128 = 186;  // F(186) is the largest below 2^128
+
+/*
+ * F(n), exact in 128 bits.
+ * Throws std::overflow_error if n > 186.
+ */
+inline uint128 fibonacci128(uint64_t n)
+{
+    if (n > kMaxFibonacci128)
+        throw std::overflow_error("fibonacci128: F(n) does not fit in 128 bits");
+    return fibonacciDoubling<uint128>(n);
+}
+#endif
+
+/*
+ * F(n) mod m for any n, m > 0.
+ * Throws std::invalid_argument if m == 0.
+ */
+inline uint64_t fibonacciMod(uint64_t n, uint64_t m)
+{
+    if (m == 0) throw std::invalid_argument("fibonacciMod: modulus must be positive");
+    uint64_t a = 0;
+    uint64_t b = 1 % m;
+    for (int bit = highestBit(n); bit >= 0; bit--)
+    {
+        uint64_t twiceB = (b >= m - b) ? b - (m - b) : b + b;
+        uint64_t diff = (twiceB >= a) ? twiceB - a : twiceB + (m - a);  // 2b - a (mod m)
+        uint64_t even = mulMod(a, diff, m);
+        uint64_t aa = mulMod(a, a, m);
+        uint64_t bb = mulMod(b, b, m);
+        uint64_t odd = (aa >= m - bb) ? aa - (m - bb) : aa + bb;
+        if ((n >> bit) & 1)
+        {
+            a = odd;
+            b = (even >= m - odd) ? even - (m - odd) : even + odd;
+        }
+        else
+        {
+            a = even;
+            b = odd;
+        }
+    }
+    return a;
+}
+
+/*
+ * base^exponent by repeated squaring, O(log exponent) multiplications.
+ * T is any signed or unsigned integer type (including __int128).
+ * Throws std::overflow_error if the result does not fit in T.
+ */
+template <typename T>
+T power(T base, uint64_t exponent)
+{
+    T result = 1;
+    while (true)
+    {
+        if (exponent & 1)
+        {
+            if (__builtin_mul_overflow(result, base, &result))
+                throw std::overflow_error("power: result does not fit in the integer type");
+        }
+        exponent >>= 1;
+        if (exponent == 0) return result;
+        // Squaring can overflow even when the final result would not need the square
+        if (__builtin_mul_overflow(base, base, &base))
+            throw std::overflow_error("power: result does not fit in the integer type");
+    }
+}
+
+/*
+ * base^exponent mod m, for any 64-bit base and exponent, m > 0.
+ * Throws std::invalid_argument if m == 0.
+ */
+inline uint64_t powerMod(uint64_t base, uint64_t exponent, uint64_t m)
+{
+    if (m == 0) throw std::invalid_argument("powerMod: modulus must be positive");
+    uint64_t result = 1 % m;
+    base %= m;
+    while (exponent > 0)
+    {
+        if (exponent & 1) result = mulMod(result, base, m);
+        base = mulMod(base, base, m);
+        exponent >>= 1;
+    }
+    return result;
+}
+
+/*
+ * Thread-safe memo of F(n) mod m for repeated queries.
+ * Lookups take a shared (reader) lock, so concurrent hits do not serialize;
+ * a miss computes outside any lock and then inserts under the exclusive lock.
+ * When the memo reaches its capacity it is cleared, which bounds memory
+ * without the bookkeeping of an LRU.
+ */
+class FibonacciMemo
+{
+   private:
+    struct Key
+    {
+        uint64_t n;
+        uint64_t m;
+        bool operator==(const Key& other) const { return n == other.n && m == other.m; }
+    };
+
+    struct KeyHash
+    {
+        size_t operator()(const Key& key) const
+        {
+            return std::hash<uint64_t>()(key.n * 0x9E3779B97F4A7C15ull ^ key.m);
+        }
+    };
+
+    mutable std::shared_mutex lock;
+    std::unordered_map<Key, uint64_t, KeyHash> values;
+    size_t capacity;
+
+   public:
+    explicit FibonacciMemo(size_t maxEntries = 1 << 16) : capacity(maxEntries) {}
+
+    // F(n) mod m; same contract as fibonacciMod
+    uint64_t get(uint64_t n, uint64_t m)
+    {
+        Key key{n, m};
+        {
+            std::shared_lock<std::shared_mutex> reader(lock);
+            auto found = values.find(key);
+            if (found != values.end()) return found->second;
+        }
+        uint64_t value = fibonacciMod(n, m);
+        std::unique_lock<std::shared_mutex> writer(lock);
+        if (values.size() >= capacity) values.clear();
+        values.emplace(key, value);
+        return value;
+    }
+
+    size_t size() const
+    {
+        std::shared_lock<std::shared_mutex> reader(lock);
+        return values.size();
+    }
+};
+}  // namespace fast_math
+
+#endif
@@ -0,0 +1,143 @@
+#ifndef STRING_VIEW_ALGORITHMS_H
+#define STRING_VIEW_ALGORITHMS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
+/*
+ * Iterative, allocation-free counterparts of checkPalindrome and
+ * reverseString in 02-level-2-question-recursion.cpp. Inputs are taken as
+ * std::string_view (no copy), the two ends are walked toward the middle, and
+ * on x86 16 bytes from each end are handled per step with SSE2.
+ *
+ * Case folding is ASCII only ('A'-'Z'), which matches tolower() in the
+ * default "C" locale.
+ */
+
+namespace string_view_detail
+{
+inline char foldCase(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + 32) : c; }
+
+#if defined(__SSE2__)
+// Bytes of v in reverse order
+inline __m128i reverseBytes(__m128i v)
+{
+#if defined(__SSSE3__)
+    return _mm_shuffle_epi8(v, _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0));
+#else
+    // Reverse the 32-bit lanes, then the 16-bit halves of each, then the bytes of each half
+    v = _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+    v = _mm_shufflelo_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    v = _mm_shufflehi_epi16(v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+}
+
+// ASCII 'A'-'Z' to lower case in all 16 bytes; bytes >= 0x80 compare as negative and stay put
+inline __m128i foldCase(__m128i v)
+{
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_add_epi8(v, _mm_and_si128(upper, _mm_set1_epi8(32)));
+}
+#endif
+}  // namespace string_view_detail
+
+/*
+ * True if text reads the same forwards and backwards.
+ * ignoreCase folds ASCII letters like checkPalindrome does.
+ */
+inline bool isPalindrome(std::string_view text, bool ignoreCase = true)
+{
+    using namespace string_view_detail;
+    size_t left = 0;
+    size_t right = text.size();  // One past the last unchecked byte
+#if defined(__SSE2__)
+    while (right - left >= 32)
+    {
+        __m128i front = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + left));
+        __m128i back = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + right - 16));
+        back = reverseBytes(back);
+        if (ignoreCase)
+        {
+            front = foldCase(front);
+            back = foldCase(back);
+        }
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(front, back)) != 0xFFFF) return false;
+        left += 16;
+        right -= 16;
+    }
+#endif
+    while (right - left >= 2)
+    {
+        char a = text[left];
+        char b = text[right - 1];
+        if (ignoreCase)
+        {
+            a = foldCase(a);
+            b = foldCase(b);
+        }
+        if (a != b) return false;
+        left++;
+        right--;
+    }
+    return true;
+}
+
+// Reverses data[0..length) in place
+inline void reverseInPlace(char* data, size_t length)
+{
+    using namespace string_view_detail;
+    size_t left = 0;
+    size_t right = length;
+#if defined(__SSE2__)
+    while (right - left >= 32)
+    {
+        __m128i* front = reinterpret_cast<__m128i*>(data + left);
+        __m128i* back = reinterpret_cast<__m128i*>(data + right - 16);
+        __m128i a = _mm_loadu_si128(front);
+        __m128i b = _mm_loadu_si128(back);
+        _mm_storeu_si128(front, reverseBytes(b));
+        _mm_storeu_si128(back, reverseBytes(a));
+        left += 16;
+        right -= 16;
+    }
+#endif
+    std::reverse(data + left, data + right);
+}
+
+inline void reverseInPlace(std::string& text) { reverseInPlace(&text[0], text.size()); }
+
+/*
+ * Writes text reversed into buffer and returns a view of the written bytes.
+ * text and buffer must not overlap (use reverseInPlace for that).
+ * Throws std::length_error if bufferSize < text.size().
+ */
+inline std::string_view reverseInto(std::string_view text, char* buffer, size_t bufferSize)
+{
+    using namespace string_view_detail;
+    if (bufferSize < text.size()) throw std::length_error("reverseInto: buffer too small");
+    const size_t n = text.size();
+    size_t i = 0;
+#if defined(__SSE2__)
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + n - i - 16));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + i), reverseBytes(chunk));
+    }
+#endif
+    for (; i < n; i++) buffer[i] = text[n - 1 - i];
+    return std::string_view(buffer, n);
+}
+
+#endif
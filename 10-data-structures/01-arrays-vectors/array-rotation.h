@@ -0,0 +1,184 @@
+#ifndef ARRAY_ROTATION_H
+#define ARRAY_ROTATION_H
+
+// In-place right rotation (the rotate_array_by_kth problem) with several
+// algorithms behind one entry point:
+//   Reversal  - three reverses, every element is moved twice
+//   Juggling  - follows the gcd(n, k) cycles, every element moved once but
+//               with stride-k access, so only good while the array is in cache
+//   BlockSwap - Gries-Mills: swaps equal blocks until the rotation is done,
+//               about one move per element with sequential access
+//   Buffered  - when the shorter side fits in a small stack buffer, copies it
+//               out, shifts the rest once, and copies it back
+//   Parallel  - BlockSwap whose large block swaps are split across a ThreadPool
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <vector>
+#include "parallel-array-algorithms.h"
+
+enum class RotateStrategy
+{
+    Auto,
+    Reversal,
+    Juggling,
+    BlockSwap,
+    Buffered,
+    Parallel
+};
+
+namespace rotation_detail
+{
+const size_t kBufferElements = 4096;           // 16 KB of ints on the stack
+const size_t kInCacheElements = 8192;          // Juggling only below this size
+const size_t kParallelElements = 1 << 22;      // Auto picks Parallel from here (16 MB)
+const size_t kParallelSwapElements = 1 << 16;  // Smaller block swaps stay on one thread
+
+inline void reversal(int* a, size_t n, size_t k)
+{
+    std::reverse(a, a + n);
+    std::reverse(a, a + k);
+    std::reverse(a + k, a + n);
+}
+
+// Left rotation by d, cycle by cycle
+inline void juggling(int* a, size_t n, size_t k)
+{
+    size_t d = n - k;
+    size_t cycles = std::gcd(n, d);
+    for (size_t start = 0; start < cycles; start++)
+    {
+        int carried = a[start];
+        size_t hole = start;
+        while (true)
+        {
+            size_t next = hole + d;
+            if (next >= n) next -= n;
+            if (next == start) break;
+            a[hole] = a[next];
+            hole = next;
+        }
+        a[hole] = carried;
+    }
+}
+
+// Requires min(k, n - k) <= kBufferElements
+inline void buffered(int* a, size_t n, size_t k)
+{
+    int buffer[kBufferElements];
+    if (k <= n - k)
+    {
+        // Last k elements move to the front
+        std::memcpy(buffer, a + n - k, k * sizeof(int));
+        std::memmove(a + k, a, (n - k) * sizeof(int));
+        std::memcpy(a, buffer, k * sizeof(int));
+    }
+    else
+    {
+        // First n - k elements move to the back
+        std::memcpy(buffer, a, (n - k) * sizeof(int));
+        std::memmove(a, a + n - k, k * sizeof(int));
+        std::memcpy(a + k, buffer, (n - k) * sizeof(int));
+    }
+}
+
+// Gries-Mills block swap for a left rotation by d. Invariant: [d - i, d) and
+// [d, d + j) are the two blocks still to exchange; the larger one shrinks by
+// the size of the smaller one each round. swapBlocks(x, y, len) swaps ranges.
+template <typename SwapBlocks>
+void blockSwap(int* a, size_t n, size_t k, SwapBlocks swapBlocks)
+{
+    size_t d = n - k;
+    size_t i = d;
+    size_t j = n - d;
+    while (i != j)
+    {
+        if (i < j)
+        {
+            swapBlocks(a + d - i, a + d + j - i, i);
+            j -= i;
+        }
+        else
+        {
+            swapBlocks(a + d - i, a + d, j);
+            i -= j;
+        }
+    }
+    swapBlocks(a + d - i, a + d, i);
+}
+
+inline void swapSerial(int* x, int* y, size_t len) { std::swap_ranges(x, x + len, y); }
+
+inline void swapParallel(ThreadPool& pool, int* x, int* y, size_t len)
+{
+    if (len < kParallelSwapElements || pool.size() == 1)
+    {
+        swapSerial(x, y, len);
+        return;
+    }
+    parallel_chunks(
+        pool, len,
+        [&](size_t, size_t begin, size_t end) { swapSerial(x + begin, y + begin, end - begin); },
+        kParallelSwapElements);
+}
+}  // namespace rotation_detail
+
+// Strategy the Auto mode uses for an array of n elements rotated by k (0 < k < n)
+inline RotateStrategy chooseRotateStrategy(size_t n, size_t k, const ThreadPool& pool)
+{
+    using namespace rotation_detail;
+    if (std::min(k, n - k) <= kBufferElements) return RotateStrategy::Buffered;
+    if (n <= kInCacheElements) return RotateStrategy::Juggling;
+    if (n >= kParallelElements && pool.size() > 1) return RotateStrategy::Parallel;
+    return RotateStrategy::BlockSwap;
+}
+
+// Rotates a[0..n) right by k steps in place. k may be negative (left rotation)
+// or larger than n.
+inline void rotate_right(int* a, size_t n, long long k,
+                         RotateStrategy strategy = RotateStrategy::Auto,
+                         ThreadPool& pool = ThreadPool::shared())
+{
+    using namespace rotation_detail;
+    if (n == 0) return;
+    long long shift = k % static_cast<long long>(n);
+    if (shift < 0) shift += n;
+    size_t steps = static_cast<size_t>(shift);
+    if (steps == 0) return;
+
+    if (strategy == RotateStrategy::Auto) strategy = chooseRotateStrategy(n, steps, pool);
+    // Buffered needs a short side, fall back to the general algorithm otherwise
+    if (strategy == RotateStrategy::Buffered && std::min(steps, n - steps) > kBufferElements)
+        strategy = RotateStrategy::BlockSwap;
+
+    switch (strategy)
+    {
+        case RotateStrategy::Reversal:
+            reversal(a, n, steps);
+            break;
+        case RotateStrategy::Juggling:
+            juggling(a, n, steps);
+            break;
+        case RotateStrategy::Buffered:
+            buffered(a, n, steps);
+            break;
+        case RotateStrategy::Parallel:
+            blockSwap(a, n, steps,
+                      [&](int* x, int* y, size_t len) { swapParallel(pool, x, y, len); });
+            break;
+        default:
+            blockSwap(a, n, steps, swapSerial);
+            break;
+    }
+}
+
+inline void rotate_right(std::vector<int>& v, long long k,
+                         RotateStrategy strategy = RotateStrategy::Auto,
+                         ThreadPool& pool = ThreadPool::shared())
+{
+    rotate_right(v.data(), v.size(), k, strategy, pool);
+}
+
+#endif
@@ -2,8 +2,10 @@
 #include <vector>     // For dynamic arrays (std::vector)
 #include <numeric>    // For std::accumulate (summing elements)
 #include <algorithm>  // For std::sort, std::min_element, std::max_element, std::reverse, std::find
-#include <map>        // For frequency counting (if needed, though can be done with sort+loop)
 #include <bits/stdc++.h>
+#include "array-rotation.h"
+#include "flat-hash-counter.h"
+#include "parallel-array-algorithms.h"
 // --- Problem 1: Find the largest and smallest elements in an array/vector ---
 // Question: Given an array/vector of integers, find its maximum and minimum elements.
 // Example: Input: [3, 1, 4, 1, 5, 9, 2, 6] Output: Max: 9, Min: 1
@@ -225,27 +227,13 @@ void findDuplicates()
 {
     std::cout << "\n--- Problem 5: Find Duplicates ---" << std::endl;
 
-    // Using std::vector and sorting (modifies original vector)
+    // Using std::vector and a flat hash counter (leaves the vector untouched)
     std::vector<int> vec = {1, 5, 2, 8, 5, 1, 3, 9, 2};
     std::cout << "Original vector: ";
     for (int x : vec) std::cout << x << " ";
     std::cout << std::endl;
 
-    std::sort(vec.begin(), vec.end());  // Sorts the vector
-    std::vector<int> duplicates_vec;
-    for (size_t i = 0; i < vec.size() - 1; ++i)
-    {
-        if (vec[i] == vec[i + 1])
-        {
-            // Add to duplicates_vec only if it's not already added (to avoid multiple same
-            // duplicates)
-            if (duplicates_vec.empty() || duplicates_vec.back() != vec[i])
-            {
-                duplicates_vec.push_back(vec[i]);
-            }
-        }
-    }
-
+    std::vector<int> duplicates_vec = find_duplicates(vec);  // In order of the second copy
     if (duplicates_vec.empty())
     {
         std::cout << "No duplicates found in vector." << std::endl;
@@ -257,38 +245,20 @@ void findDuplicates()
         std::cout << std::endl;
     }
 
-    // Using C-style array and a frequency map (or sorting + checking)
-    int arr[] = {4, 1, 3, 4, 2, 1, 5};
-    int n_arr = sizeof(arr) / sizeof(arr[0]);
-    std::cout << "Original array: ";
-    for (int i = 0; i < n_arr; ++i) std::cout << arr[i] << " ";
-    std::cout << std::endl;
-
-    std::map<int, int> frequency_map;
-    for (int i = 0; i < n_arr; ++i)
-    {
-        frequency_map[arr[i]]++;
-    }
+    // Values spread far apart are no longer dense, so this one goes through the hash table
+    std::vector<int> sparse = {1000000007, 99, -42, 7, 1000000007, 123456789, -42};
+    std::cout << "Original sparse vector: ";
+    for (int x : sparse) std::cout << x << " ";
+    std::cout << "(dense: " << KeyCounter(sparse).isDense() << ")" << std::endl;
 
-    std::vector<int> duplicates_arr;
-    for (auto const& [key, val] : frequency_map)
-    {
-        if (val > 1)
-        {
-            duplicates_arr.push_back(key);
-        }
-    }
+    std::cout << "Duplicates in sparse vector: ";
+    for (int x : find_duplicates(sparse)) std::cout << x << " ";
+    std::cout << std::endl;
 
-    if (duplicates_arr.empty())
-    {
-        std::cout << "No duplicates found in array." << std::endl;
-    }
-    else
-    {
-        std::cout << "Duplicates in array: ";
-        for (int x : duplicates_arr) std::cout << x << " ";
-        std::cout << std::endl;
-    }
+    int first = 0;
+    if (first_unique(sparse, first)) std::cout << "First unique: " << first << std::endl;
+    if (first_unique(sparse, first, UniqueOrder::SmallestKey))
+        std::cout << "Smallest unique: " << first << std::endl;
 }
 
 // --- Problem 6: Rotate an array/vector by k positions ---
@@ -368,6 +338,52 @@ void rotateArrayVector()
     std::cout << "Rotated array (temp array): ";
     for (int i = 0; i < n_arr; ++i) std::cout << arr[i] << " ";
     std::cout << std::endl;
+
+    // Using the rotation engine (in-place, picks the algorithm from n and k)
+    vec = {1, 2, 3, 4, 5};
+    rotate_right(vec, 2);
+    std::cout << "Rotated vector (rotate_right): ";
+    for (int x : vec) std::cout << x << " ";
+    std::cout << std::endl;
+}
+
+// Rotation throughput for each strategy over a range of k/n ratios
+void benchmarkRotation()
+{
+    std::cout << "\n--- Rotation benchmark ---" << std::endl;
+
+    const size_t n = 1 << 24;  // 64 MB of ints
+    std::vector<int> data(n);
+    std::iota(data.begin(), data.end(), 0);
+    const std::pair<const char*, RotateStrategy> strategies[] = {
+        {"reversal", RotateStrategy::Reversal},   {"juggling", RotateStrategy::Juggling},
+        {"blockswap", RotateStrategy::BlockSwap}, {"buffered", RotateStrategy::Buffered},
+        {"parallel", RotateStrategy::Parallel},   {"auto", RotateStrategy::Auto}};
+    const double ratios[] = {0.0001, 0.01, 0.1, 0.25, 0.5, 0.9};
+    std::streamsize oldPrecision = std::cout.precision(3);
+
+    std::cout << "k/n     ";
+    for (const auto& strategy : strategies) std::cout << std::setw(11) << strategy.first;
+    std::cout << "   (GB/s of array rotated)" << std::endl;
+    for (double ratio : ratios)
+    {
+        size_t k = static_cast<size_t>(ratio * n);
+        std::cout << std::left << std::setw(8) << ratio << std::right;
+        for (const auto& strategy : strategies)
+        {
+            auto start = std::chrono::steady_clock::now();
+            rotate_right(data, k, strategy.second);
+            double seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            rotate_right(data, -static_cast<long long>(k));  // Undo for the next run
+            std::cout << std::setw(11) << n * sizeof(int) / seconds / 1e9;
+        }
+        std::cout << std::endl;
+    }
+    std::cout.precision(oldPrecision);
+    bool restored = true;
+    for (size_t i = 0; i < n && restored; i++) restored = data[i] == static_cast<int>(i);
+    std::cout << "array restored after all runs: " << restored << std::endl;
 }
 
 // --- Problem 7: Remove duplicates from a sorted array/vector (in-place) ---
@@ -448,19 +464,9 @@ return -1.
 
 int non_repeating_element(std::vector<int>& v)
 {
-    std::map<int, int> mp;
-    for (int i = 0; i < v.size(); i++)
-    {
-        mp[v[i]]++;  // store element and its frequency
-    }
-    for (const auto& pair : mp)
-    {
-        if (pair.second == 1)
-        {
-            return pair.first;
-        }
-    }
-    return -1;
+    int first = -1;
+    first_unique(v, first);  // Counts with a flat hash table, then scans v in input order
+    return first;
 }
 /*
 🔄 2. Rotate Array by K Positions
@@ -474,12 +480,8 @@ the remaining.
 
 void rotate_array_by_kth(std::vector<int>& v, int k)
 {
-    int n = v.size();
-    if (n == 0) return;
-    k = k % n;  // handle k > n
-    std::reverse(v.begin(), v.end());
-    std::reverse(v.begin(), v.begin() + k);
-    std::reverse(v.begin() + k, v.end());
+    // Reversal, juggling, block swap or a short buffered shift, chosen from n and k
+    rotate_right(v, k);
 }
 /*
 🧩 3. Maximum Subarray Sum (Kadane’s Algorithm)
@@ -501,6 +503,53 @@ int max_sub_sum(std::vector<int>& v)
     }
     return max_sum;
 }
+// --- Problem 8: Parallel reductions ---
+// The same min/max, sum, sorted check and Kadane's algorithm, split across a thread pool.
+void parallelReductions()
+{
+    std::cout << "\n--- Problem 8: Parallel Reductions ---" << std::endl;
+
+    std::vector<int> vec = {-2, 1, -3, 4, -1, 2, 1, -5, 4};
+    MinMax mm = parallel_min_max(vec);
+    std::cout << "Min: " << mm.min << ", Max: " << mm.max << ", Sum: " << parallel_sum(vec)
+              << ", Sorted: " << parallel_is_sorted(vec)
+              << ", Max subarray sum: " << parallel_max_sub_sum(vec) << std::endl;
+
+    // Large input: compare against the single-threaded loops
+    const size_t n = 1 << 24;
+    std::mt19937 rng(3);
+    std::vector<int> big(n);
+    for (int& x : big) x = static_cast<int>(rng() % 2001) - 1000;
+    ThreadPool& pool = ThreadPool::shared();
+
+    auto time = [](auto&& fn)
+    {
+        auto start = std::chrono::steady_clock::now();
+        auto result = fn();
+        double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                              start)
+                        .count();
+        return std::make_pair(result, ms);
+    };
+    auto serialSum = time([&] { return std::accumulate(big.begin(), big.end(), 0LL); });
+    auto parallelSum = time([&] { return parallel_sum(big, pool); });
+    auto serialKadane = time([&] { return static_cast<long long>(max_sub_sum(big)); });
+    auto parallelKadane = time([&] { return parallel_max_sub_sum(big, pool); });
+    std::sort(big.begin(), big.end());
+    auto serialSorted = time([&] { return std::is_sorted(big.begin(), big.end()); });
+    auto parallelSorted = time([&] { return parallel_is_sorted(big, pool); });
+
+    std::cout << pool.size() << " threads, " << n << " ints" << std::endl;
+    std::cout << "sum:      " << serialSum.first << " in " << serialSum.second << " ms, parallel "
+              << parallelSum.first << " in " << parallelSum.second << " ms" << std::endl;
+    std::cout << "kadane:   " << serialKadane.first << " in " << serialKadane.second
+              << " ms, parallel " << parallelKadane.first << " in " << parallelKadane.second
+              << " ms" << std::endl;
+    std::cout << "sorted:   " << serialSorted.first << " in " << serialSorted.second
+              << " ms, parallel " << parallelSorted.first << " in " << parallelSorted.second
+              << " ms" << std::endl;
+}
+
 int main()
 {
     findMinMax();
@@ -509,7 +558,9 @@ int main()
     sumElements();
     findDuplicates();
     rotateArrayVector();
+    benchmarkRotation();
     removeDuplicatesSorted();
+    parallelReductions();
 
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#ifndef FLAT_HASH_COUNTER_H
+#define FLAT_HASH_COUNTER_H
+
+// Frequency counting for the duplicate / non-repeating element problems in
+// basic-question.cpp without sorting and without one tree node per key.
+// Keys that span a small range are counted in a plain array indexed by
+// (key - min); anything else goes into an open-addressing hash table.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Open-addressing (linear probing) hash table from int to a count.
+// Keys and counts live in two contiguous arrays; a count of 0 marks an empty
+// slot. Counts saturate at 255, which is plenty for "seen once / more than once".
+class FlatHashCounter
+{
+   private:
+    std::vector<int> keys;
+    std::vector<uint8_t> counts;
+    size_t mask = 0;  // Slot count - 1, slot count is a power of two
+    int shift = 64;   // 64 - log2(slot count), for Fibonacci hashing
+    size_t used = 0;  // Occupied slots
+
+    // Multiplicative hash: the high bits of key * 2^64/phi spread nearby keys apart
+    size_t slotOf(int key) const
+    {
+        uint64_t mixed = static_cast<uint32_t>(key) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(mixed >> shift);
+    }
+
+    // Slot holding key, or the empty slot where it would go
+    size_t find(int key) const
+    {
+        size_t slot = slotOf(key);
+        while (counts[slot] != 0 && keys[slot] != key) slot = (slot + 1) & mask;
+        return slot;
+    }
+
+    void rehash(size_t slots)
+    {
+        std::vector<int> oldKeys(slots);
+        std::vector<uint8_t> oldCounts(slots, 0);
+        keys.swap(oldKeys);
+        counts.swap(oldCounts);
+        mask = slots - 1;
+        shift = 64;
+        for (size_t s = slots; s > 1; s >>= 1) shift--;
+        for (size_t i = 0; i < oldCounts.size(); i++)
+        {
+            if (oldCounts[i] == 0) continue;
+            size_t slot = find(oldKeys[i]);
+            keys[slot] = oldKeys[i];
+            counts[slot] = oldCounts[i];
+        }
+    }
+
+   public:
+    // Sized so that expectedKeys distinct keys keep the table at most half full
+    explicit FlatHashCounter(size_t expectedKeys = 8)
+    {
+        size_t slots = 16;
+        while (slots < expectedKeys * 2) slots *= 2;
+        rehash(slots);
+    }
+
+    // Counts one more occurrence of key and returns its new count
+    unsigned add(int key)
+    {
+        size_t slot = find(key);
+        if (counts[slot] == 0)
+        {
+            if ((used + 1) * 2 > keys.size())
+            {
+                rehash(keys.size() * 2);
+                slot = find(key);
+            }
+            keys[slot] = key;
+            used++;
+        }
+        if (counts[slot] != UINT8_MAX) counts[slot]++;
+        return counts[slot];
+    }
+
+    unsigned count(int key) const { return counts[find(key)]; }
+
+    // Number of distinct keys seen
+    size_t size() const { return used; }
+};
+
+// Counter over the values of one vector. Picks a count array when the values
+// are dense (range no larger than a few times the element count) and the hash
+// table otherwise; callers only see add() and count().
+class KeyCounter
+{
+   private:
+    bool dense = false;
+    long long base = 0;  // Smallest value, index 0 of denseCounts
+    std::vector<uint8_t> denseCounts;
+    FlatHashCounter hashed;
+
+   public:
+    explicit KeyCounter(const std::vector<int>& values) : hashed(0)
+    {
+        if (values.empty()) return;
+        auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+        long long range = static_cast<long long>(*hi) - *lo + 1;
+        long long denseLimit = std::max<long long>(4096, 4 * static_cast<long long>(values.size()));
+        if (range <= denseLimit)
+        {
+            dense = true;
+            base = *lo;
+            denseCounts.assign(static_cast<size_t>(range), 0);
+        }
+        else
+        {
+            hashed = FlatHashCounter(values.size());
+        }
+    }
+
+    // Only valid for values of the vector given to the constructor
+    unsigned add(int key)
+    {
+        if (!dense) return hashed.add(key);
+        uint8_t& c = denseCounts[static_cast<size_t>(key - base)];
+        if (c != UINT8_MAX) c++;
+        return c;
+    }
+
+    unsigned count(int key) const
+    {
+        return dense ? denseCounts[static_cast<size_t>(key - base)] : hashed.count(key);
+    }
+
+    bool isDense() const { return dense; }
+};
+
+// Every value that occurs more than once, each listed once, in the order in
+// which its second occurrence appears. O(n) expected time.
+inline std::vector<int> find_duplicates(const std::vector<int>& v)
+{
+    KeyCounter counter(v);
+    std::vector<int> duplicates;
+    for (int x : v)
+        if (counter.add(x) == 2) duplicates.push_back(x);
+    return duplicates;
+}
+
+enum class UniqueOrder
+{
+    InputOrder,  // The first value, scanning left to right, that occurs exactly once
+    SmallestKey  // The smallest value that occurs exactly once
+};
+
+// Finds a value that occurs exactly once. Returns false if every value repeats.
+inline bool first_unique(const std::vector<int>& v, int& result,
+                         UniqueOrder order = UniqueOrder::InputOrder)
+{
+    KeyCounter counter(v);
+    for (int x : v) counter.add(x);
+
+    bool found = false;
+    for (int x : v)
+    {
+        if (counter.count(x) != 1) continue;
+        if (order == UniqueOrder::InputOrder)
+        {
+            result = x;
+            return true;
+        }
+        if (!found || x < result) result = x;
+        found = true;
+    }
+    return found;
+}
+
+#endif
@@ -0,0 +1,260 @@
+#ifndef PARALLEL_ARRAY_ALGORITHMS_H
+#define PARALLEL_ARRAY_ALGORITHMS_H
+
+// Multi-threaded versions of the array helpers in basic-question.cpp.
+// The input is cut into contiguous chunks, each chunk is reduced on a pool
+// thread, and the per-chunk results are combined in chunk order, so the
+// result does not depend on scheduling.
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads that run one batch of indexed tasks at a time
+class ThreadPool
+{
+   private:
+    std::vector<std::thread> workers;
+    std::mutex runLock;  // Serializes run() calls from different threads
+    std::mutex lock;
+    std::condition_variable wake;      // Workers wait here for a new batch
+    std::condition_variable finished;  // run() waits here for the batch to drain
+    std::function<void(size_t)> task;  // Current batch
+    size_t taskCount = 0;
+    std::atomic<size_t> nextTask{0};
+    size_t pendingTasks = 0;
+    unsigned activeThreads = 0;  // Threads inside drain(); a new batch waits for zero
+    unsigned generation = 0;     // Bumped for every batch so workers notice it
+    bool stopping = false;
+
+    // Claims indices of the current batch until none are left. The caller must
+    // have counted itself in activeThreads.
+    void drain()
+    {
+        size_t done = 0;
+        for (size_t i = nextTask.fetch_add(1); i < taskCount; i = nextTask.fetch_add(1))
+        {
+            task(i);
+            done++;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        pendingTasks -= done;
+        activeThreads--;
+        if (pendingTasks == 0 && activeThreads == 0) finished.notify_all();
+    }
+
+    void workerLoop()
+    {
+        unsigned seen = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> guard(lock);
+                wake.wait(guard, [&] { return stopping || generation != seen; });
+                if (stopping) return;
+                seen = generation;
+                activeThreads++;
+            }
+            drain();
+        }
+    }
+
+   public:
+    // threads == 0 means one per hardware thread; the caller of run() counts as one
+    explicit ThreadPool(unsigned threads = 0)
+    {
+        if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned i = 1; i < threads; i++) workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Threads that execute work, including the caller
+    unsigned size() const { return static_cast<unsigned>(workers.size()) + 1; }
+
+    // Calls body(i) for every i in [0, count) and returns once all calls are done.
+    // body must not throw, and must not call run() on the same pool.
+    void run(size_t count, std::function<void(size_t)> body)
+    {
+        if (count == 0) return;
+        std::lock_guard<std::mutex> oneBatch(runLock);
+        {
+            // Wait until stragglers from the previous batch have left drain()
+            std::unique_lock<std::mutex> guard(lock);
+            finished.wait(guard, [&] { return activeThreads == 0; });
+            task = std::move(body);
+            taskCount = count;
+            pendingTasks = count;
+            nextTask.store(0);
+            generation++;
+            activeThreads++;  // This thread helps too
+        }
+        wake.notify_all();
+        drain();
+        std::unique_lock<std::mutex> guard(lock);
+        finished.wait(guard, [&] { return pendingTasks == 0 && activeThreads == 0; });
+    }
+
+    // Process-wide pool sized to the machine
+    static ThreadPool& shared()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+};
+
+// Splits [0, n) into at most a few chunks per thread, none smaller than minChunk,
+// and calls body(chunk, begin, end) for each. Returns the number of chunks.
+inline size_t parallel_chunks(ThreadPool& pool, size_t n,
+                              const std::function<void(size_t, size_t, size_t)>& body,
+                              size_t minChunk = 1 << 16)
+{
+    size_t chunks = std::min<size_t>(pool.size() * 4, (n + minChunk - 1) / minChunk);
+    chunks = std::max<size_t>(chunks, 1);
+    size_t step = (n + chunks - 1) / chunks;
+    chunks = n == 0 ? 1 : (n + step - 1) / step;
+    pool.run(chunks,
+             [&](size_t c)
+             {
+                 size_t begin = std::min(n, c * step);
+                 body(c, begin, std::min(n, begin + step));
+             });
+    return chunks;
+}
+
+struct MinMax
+{
+    int min;
+    int max;
+};
+
+// Smallest and largest element. Throws std::invalid_argument on an empty vector.
+inline MinMax parallel_min_max(const std::vector<int>& v, ThreadPool& pool = ThreadPool::shared())
+{
+    if (v.empty()) throw std::invalid_argument("parallel_min_max of an empty vector");
+    std::vector<MinMax> partial(pool.size() * 4);
+    size_t chunks = parallel_chunks(pool, v.size(),
+                                    [&](size_t c, size_t begin, size_t end)
+                                    {
+                                        MinMax local{v[begin], v[begin]};
+                                        for (size_t i = begin + 1; i < end; i++)
+                                        {
+                                            local.min = std::min(local.min, v[i]);
+                                            local.max = std::max(local.max, v[i]);
+                                        }
+                                        partial[c] = local;
+                                    });
+    MinMax result = partial[0];
+    for (size_t c = 1; c < chunks; c++)
+    {
+        result.min = std::min(result.min, partial[c].min);
+        result.max = std::max(result.max, partial[c].max);
+    }
+    return result;
+}
+
+// Sum accumulated in 64 bits, so it cannot overflow for fewer than 2^32 ints
+inline long long parallel_sum(const std::vector<int>& v, ThreadPool& pool = ThreadPool::shared())
+{
+    std::vector<long long> partial(pool.size() * 4, 0);
+    size_t chunks = parallel_chunks(pool, v.size(),
+                                    [&](size_t c, size_t begin, size_t end)
+                                    {
+                                        long long local = 0;
+                                        for (size_t i = begin; i < end; i++) local += v[i];
+                                        partial[c] = local;
+                                    });
+    long long total = 0;
+    for (size_t c = 0; c < chunks; c++) total += partial[c];
+    return total;
+}
+
+// Non-decreasing order check. Each chunk also compares its last element with the
+// first element of the next chunk, and all chunks stop once any of them fails.
+inline bool parallel_is_sorted(const std::vector<int>& v, ThreadPool& pool = ThreadPool::shared())
+{
+    std::atomic<bool> sorted{true};
+    const size_t checkEvery = 4096;  // Elements between looks at the shared flag
+    parallel_chunks(pool, v.size(),
+                    [&](size_t, size_t begin, size_t end)
+                    {
+                        size_t last = std::min(end, v.size() - 1);  // Pairs (i, i+1), i < last
+                        for (size_t i = begin; i < last; i += checkEvery)
+                        {
+                            if (!sorted.load(std::memory_order_relaxed)) return;
+                            size_t stop = std::min(last, i + checkEvery);
+                            for (size_t j = i; j < stop; j++)
+                            {
+                                if (v[j] > v[j + 1])
+                                {
+                                    sorted.store(false, std::memory_order_relaxed);
+                                    return;
+                                }
+                            }
+                        }
+                    });
+    return sorted.load();
+}
+
+// Kadane's algorithm split across chunks. Each chunk is summarised by
+// (total, best prefix, best suffix, best subarray); two adjacent summaries combine
+// associatively, and the best subarray may span the boundary as suffix + prefix.
+struct SubarraySummary
+{
+    long long total;
+    long long prefix;
+    long long suffix;
+    long long best;
+};
+
+inline SubarraySummary combine(const SubarraySummary& left, const SubarraySummary& right)
+{
+    return {left.total + right.total, std::max(left.prefix, left.total + right.prefix),
+            std::max(right.suffix, right.total + left.suffix),
+            std::max({left.best, right.best, left.suffix + right.prefix})};
+}
+
+// Largest sum of a non-empty contiguous subarray, 0 for an empty vector (as max_sub_sum)
+inline long long parallel_max_sub_sum(const std::vector<int>& v,
+                                      ThreadPool& pool = ThreadPool::shared())
+{
+    if (v.empty()) return 0;
+    std::vector<SubarraySummary> partial(pool.size() * 4);
+    size_t chunks = parallel_chunks(pool, v.size(),
+                                    [&](size_t c, size_t begin, size_t end)
+                                    {
+                                        SubarraySummary s{v[begin], v[begin], 0, v[begin]};
+                                        long long running = v[begin];  // Best ending here
+                                        for (size_t i = begin + 1; i < end; i++)
+                                        {
+                                            s.total += v[i];
+                                            s.prefix = std::max(s.prefix, s.total);
+                                            running = std::max<long long>(v[i], running + v[i]);
+                                            s.best = std::max(s.best, running);
+                                        }
+                                        s.suffix = running;
+                                        partial[c] = s;
+                                    });
+    SubarraySummary result = partial[0];
+    for (size_t c = 1; c < chunks; c++) result = combine(result, partial[c]);
+    return result.best;
+}
+
+#endif
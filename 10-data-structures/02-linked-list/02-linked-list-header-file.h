@@ -1,6 +1,10 @@
 #ifndef LINKEDLIST_H
 #define LINKEDLIST_H
 
+#include <cstddef>
+#include <new>
+#include <vector>
+
 class Node
 {
    public:
@@ -10,16 +14,166 @@ class Node
     Node(int val);
 };
 
+// Interface used by LinkedList to obtain and release nodes
+class NodeAllocator
+{
+   public:
+    virtual ~NodeAllocator() = default;
+
+    virtual Node* allocate(int value) = 0;
+    virtual void deallocate(Node* node) = 0;
+};
+
+// Plain new/delete, one heap allocation per node
+class HeapNodeAllocator : public NodeAllocator
+{
+   public:
+    Node* allocate(int value) override;
+    void deallocate(Node* node) override;
+};
+
+// Hands out raw slots for T from contiguous blocks and keeps released slots
+// on a free list (threaded through T::next). All blocks go away together.
+// Blocks honour alignof(T), so over-aligned node types are fine.
+template <typename T>
+class SlabPool
+{
+   private:
+    std::vector<T*> blocks;     // Every block owned by the pool
+    T* freeList;                // Released slots, chained through next
+    T* cursor;                  // Next untouched slot in the newest block
+    T* blockEnd;                // One past the last slot of the newest block
+    std::size_t nodesPerBlock;  // Slots per block
+
+   public:
+    explicit SlabPool(std::size_t nodesPerBlock = 1024)
+        : freeList(nullptr),
+          cursor(nullptr),
+          blockEnd(nullptr),
+          nodesPerBlock(nodesPerBlock > 0 ? nodesPerBlock : 1)
+    {
+    }
+    ~SlabPool() { release(); }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // Uninitialized storage for one T; construct it with placement new
+    void* take()
+    {
+        if (freeList)
+        {
+            T* slot = freeList;
+            freeList = freeList->next;
+            return slot;
+        }
+        if (cursor == blockEnd)
+        {
+            T* block = static_cast<T*>(
+                ::operator new(nodesPerBlock * sizeof(T), std::align_val_t(alignof(T))));
+            blocks.push_back(block);
+            cursor = block;
+            blockEnd = block + nodesPerBlock;
+        }
+        return cursor++;
+    }
+
+    // T must be trivially destructible, it is never destroyed explicitly
+    void give(T* slot)
+    {
+        slot->next = freeList;
+        freeList = slot;
+    }
+
+    // Drops every slot at once; previously taken slots become invalid
+    void release()
+    {
+        for (T* block : blocks) ::operator delete(block, std::align_val_t(alignof(T)));
+        blocks.clear();
+        freeList = cursor = blockEnd = nullptr;
+    }
+
+    // Takes over every block of other, so slots taken from other stay valid until
+    // this pool is released. O(blocks); other's spare slots are kept only when this
+    // pool has none of its own, otherwise they sit unused until release().
+    void absorb(SlabPool& other)
+    {
+        blocks.insert(blocks.end(), other.blocks.begin(), other.blocks.end());
+        if (!freeList) freeList = other.freeList;
+        if (cursor == blockEnd)
+        {
+            cursor = other.cursor;
+            blockEnd = other.blockEnd;
+        }
+        other.blocks.clear();
+        other.freeList = other.cursor = other.blockEnd = nullptr;
+    }
+};
+
+// Default LinkedList allocator backed by a SlabPool
+class NodePool : public NodeAllocator
+{
+   private:
+    SlabPool<Node> slabs;
+
+   public:
+    explicit NodePool(std::size_t nodesPerBlock = 1024);
+
+    Node* allocate(int value) override;
+    void deallocate(Node* node) override;
+
+    // Drops every node at once; previously returned nodes become invalid
+    void release();
+
+    // Takes over other's nodes: they stay valid until this pool is released
+    void absorb(NodePool& other);
+};
+
 class LinkedList
 {
    private:
-    Node* head;  // Pointer to the first node in the list
-    Node* tail;  // Pointer to the last node in the list
-    int length;  // Current number of nodes in the list
+    Node* head;                // Pointer to the first node in the list
+    Node* tail;                // Pointer to the last node in the list
+    int length;                // Current number of nodes in the list
+    NodePool ownPool;          // Default allocator when none is supplied
+    NodeAllocator* allocator;  // Where nodes come from and go back to
+    Node* cursor;              // Last node reached by an indexed walk (nullptr if unset)
+    int cursorIndex;           // Position of cursor in the list
+
+    Node* makeNode(int value);
+    void freeNode(Node* node);
+    Node* nodeAt(int index);  // Walks from the cursor when it is not past index
+
+    // Empties other and returns its nodes as a chain this list's allocator owns
+    void takeAll(LinkedList& other, Node*& first, Node*& last, int& count);
+    // Re-allocates a detached chain of from's nodes here when the allocators differ
+    void adoptChain(LinkedList& from, Node*& first, Node*& last);
+    // Links a detached chain of count nodes in before position index
+    void linkChain(int index, Node* first, Node* last, int count);
+
+    // Calls visit(node) for first and each node after it, and prefetches the next
+    // node while visit runs, so its cache miss overlaps the work on the current
+    // one. visit may free the node it gets.
+    template <typename Visit>
+    static void forEachInChain(Node* first, Visit visit)
+    {
+        for (Node* current = first; current;)
+        {
+            Node* next = current->next;
+            if (next) __builtin_prefetch(next);
+            visit(current);
+            current = next;
+        }
+    }
    public:
-    LinkedList(int value);
+    // Nodes come from allocator if given (it must outlive the list),
+    // otherwise from a pool owned by this list.
+    LinkedList(int value, NodeAllocator* allocator = nullptr);
 
     ~LinkedList();
+    LinkedList(const LinkedList&) = delete;
+    LinkedList& operator=(const LinkedList&) = delete;
+
     void append(int value);
     void prepend(int value);
     void printList() const;
@@ -35,5 +189,79 @@ class LinkedList
     bool deletePosition(int index);
 
     void reverseLinkedList();
+
+    // Front-to-back traversal with the next node prefetched (see forEachInChain)
+    template <typename Visit>
+    void forEachNode(Visit visit) const
+    {
+        forEachInChain(head, [&visit](Node* node) { visit(static_cast<const Node*>(node)); });
+    }
+
+    // Stable bottom-up merge sort: O(n log n) time, relinks the nodes in place
+    // without recursion or allocation
+    void sort();
+
+    // Moves every node of other to the end of this list, leaving other empty.
+    // O(1) when both lists use the same allocator, O(blocks) when each uses its
+    // own pool, and a copy of the values otherwise. False when other is this list.
+    bool concat(LinkedList& other);
+    // Same as concat, but other's nodes go in before position index (0..length)
+    bool splice(int index, LinkedList& other);
+    // Moves the nodes at positions index..length-1 to the end of rest. O(index),
+    // plus a copy unless both lists use the same allocator. False when index is
+    // out of range or rest is this list.
+    bool splitAt(int index, LinkedList& rest);
+
+    // Cycles only appear when nodes are relinked by hand through getHead()
+    bool hasCycle() const;     // Floyd: pointers at speeds 1 and 2 meet inside a cycle
+    Node* cycleStart() const;  // Brent: first node on the cycle, nullptr without one
+};
+
+class DNode
+{
+   public:
+    int value;    // The data stored in the node
+    DNode* prev;  // Pointer to the previous node in the list
+    DNode* next;  // Pointer to the next node in the list
+
+    DNode(int val);
+};
+
+// Same API as LinkedList, but nodes link both ways so deleteLast is O(1) and
+// indexed walks start from whichever of head, tail or the cursor is closest.
+class DoublyLinkedList
+{
+   private:
+    DNode* head;           // Pointer to the first node in the list
+    DNode* tail;           // Pointer to the last node in the list
+    int length;            // Current number of nodes in the list
+    SlabPool<DNode> pool;  // Storage for every node of this list
+    DNode* cursor;         // Last node reached by an indexed walk (nullptr if unset)
+    int cursorIndex;       // Position of cursor in the list
+
+    DNode* makeNode(int value);
+    void freeNode(DNode* node);
+    DNode* nodeAt(int index);
+   public:
+    DoublyLinkedList(int value);
+
+    DoublyLinkedList(const DoublyLinkedList&) = delete;
+    DoublyLinkedList& operator=(const DoublyLinkedList&) = delete;
+
+    void append(int value);
+    void prepend(int value);
+    void printList() const;
+
+    void deleteLast();
+    void deleteFirst();
+
+    int getLength() const;
+    DNode* getHead() { return this->head; };
+
+    bool insert(int value, int index);
+
+    bool deletePosition(int index);
+
+    void reverseLinkedList();
 };
 #endif
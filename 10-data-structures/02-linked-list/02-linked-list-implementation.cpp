@@ -1,32 +1,87 @@
+#include <cstdlib>
 #include <iostream>
+#include <new>
 #include "02-linked-list-header-file.h"
+#include "../instrumentation.h"
 
 Node::Node(int val) : value(val), next(nullptr) {}
 
-LinkedList::LinkedList(int value)
+Node* HeapNodeAllocator::allocate(int value)
 {
-    head = new Node(value);
+    return new Node(value);
+}
+
+void HeapNodeAllocator::deallocate(Node* node)
+{
+    delete node;
+}
+
+NodePool::NodePool(std::size_t nodesPerBlock) : slabs(nodesPerBlock) {}
+
+Node* NodePool::allocate(int value)
+{
+    return new (slabs.take()) Node(value);
+}
+
+void NodePool::deallocate(Node* node)
+{
+    slabs.give(node);
+}
+
+void NodePool::release()
+{
+    slabs.release();
+}
+
+void NodePool::absorb(NodePool& other)
+{
+    slabs.absorb(other.slabs);
+}
+
+LinkedList::LinkedList(int value, NodeAllocator* allocator)
+    : allocator(allocator ? allocator : &ownPool), cursor(nullptr), cursorIndex(0)
+{
+    head = makeNode(value);
     tail = head;
     length = 1;
 }
 
 LinkedList::~LinkedList()
 {
-    Node* current = head;
-    while (current != nullptr)
+    // Nodes from our own pool go away with it; a shared allocator gets them back one by one
+    if (allocator != &ownPool)
     {
-        Node* nextNode = current->next;
-        delete current;
-        current = nextNode;
+        Node* current = head;
+        while (current != nullptr)
+        {
+            Node* nextNode = current->next;
+            freeNode(current);
+            current = nextNode;
+        }
     }
+    else
+        DS_NODES_FREED(LinkedList, length, length * sizeof(Node));
     head = nullptr;
     tail = nullptr;
     length = 0;
 }
 
+Node* LinkedList::makeNode(int value)
+{
+    DS_NODE_ALLOCATED(LinkedList, sizeof(Node));
+    return allocator->allocate(value);
+}
+
+void LinkedList::freeNode(Node* node)
+{
+    DS_NODE_FREED(LinkedList, sizeof(Node));
+    allocator->deallocate(node);
+}
+
 void LinkedList::append(int value)
 {
-    Node* newNode = new Node(value);
+    DS_OPERATION(LinkedList, "append");
+    Node* newNode = makeNode(value);
     if (!head)
     {
         head = tail = newNode;
@@ -41,7 +96,8 @@ void LinkedList::append(int value)
 
 void LinkedList::prepend(int value)
 {
-    Node* newNode = new Node(value);
+    DS_OPERATION(LinkedList, "prepend");
+    Node* newNode = makeNode(value);
     if (!head)
     {
         head = tail = newNode;
@@ -52,32 +108,29 @@ void LinkedList::prepend(int value)
         head = newNode;
     }
     length++;
+    if (cursor) cursorIndex++;
 }
 
 void LinkedList::printList() const
 {
-    Node* temp = head;
-    while (temp)
-    {
-        std::cout << temp->value << " --> ";
-        temp = temp->next;
-    }
+    forEachNode([](const Node* node) { std::cout << node->value << " --> "; });
     std::cout << "nullptr" << std::endl;
 }
 
 void LinkedList::deleteLast()
 {
+    DS_TIMED_OPERATION(LinkedList, "deleteLast");
     if (!head) return;
     if (head == tail)
     {
-        delete head;
+        freeNode(head);
         head = tail = nullptr;
+        cursor = nullptr;
     }
     else
     {
-        Node* temp = head;
-        while (temp->next != tail) temp = temp->next;
-        delete tail;
+        Node* temp = nodeAt(length - 2);
+        freeNode(tail);
         tail = temp;
         tail->next = nullptr;
     }
@@ -86,14 +139,40 @@ void LinkedList::deleteLast()
 
 void LinkedList::deleteFirst()
 {
+    DS_OPERATION(LinkedList, "deleteFirst");
     if (!head) return;
     Node* temp = head;
+    if (cursor == temp)
+        cursor = nullptr;
+    else if (cursor)
+        cursorIndex--;
     head = head->next;
-    delete temp;
+    freeNode(temp);
     if (!head) tail = nullptr;
     length--;
 }
 
+Node* LinkedList::nodeAt(int index)
+{
+    Node* current = head;
+    int position = 0;
+    if (index == length - 1)
+    {
+        current = tail;
+        position = index;
+    }
+    else if (cursor && cursorIndex <= index)
+    {
+        current = cursor;
+        position = cursorIndex;
+    }
+    DS_STEPS(index - position);
+    for (; position < index; position++) current = current->next;
+    cursor = current;
+    cursorIndex = index;
+    return current;
+}
+
 int LinkedList::getLength() const
 {
     return length;
@@ -101,6 +180,7 @@ int LinkedList::getLength() const
 
 bool LinkedList::insert(int value, int index)
 {
+    DS_TIMED_OPERATION(LinkedList, "insert");
     if (index < 0 || index > length) return false;
     if (index == 0)
     {
@@ -113,20 +193,19 @@ bool LinkedList::insert(int value, int index)
         return true;
     }
 
-    Node* newNode = new Node(value);
-    Node* prev = head;
-    for (int i = 0; i < index - 1; i++)
-    {
-        prev = prev->next;
-    }
+    Node* newNode = makeNode(value);
+    Node* prev = nodeAt(index - 1);
     newNode->next = prev->next;
     prev->next = newNode;
     length++;
+    cursor = newNode;
+    cursorIndex = index;
     return true;
 }
 
 bool LinkedList::deletePosition(int index)
 {
+    DS_TIMED_OPERATION(LinkedList, "deletePosition");
     if (index < 0 || index >= length) return false;
     if (index == 0)
     {
@@ -134,24 +213,23 @@ bool LinkedList::deletePosition(int index)
         return true;
     }
 
-    Node* prev = head;
-    for (int i = 0; i < index - 1; i++)
-    {
-        prev = prev->next;
-    }
+    Node* prev = nodeAt(index - 1);
     Node* toDelete = prev->next;
     prev->next = toDelete->next;
     if (toDelete == tail) tail = prev;
-    delete toDelete;
+    freeNode(toDelete);
     length--;
     return true;
 }
 
 void LinkedList::reverseLinkedList()
 {
+    DS_OPERATION(LinkedList, "reverse");
+    DS_STEPS(length);
     Node* prev = nullptr;
     Node* curr = head;
     tail = head;
+    cursor = nullptr;
 
     while (curr)
     {
@@ -162,3 +240,408 @@ void LinkedList::reverseLinkedList()
     }
     head = prev;
 }
+
+namespace
+{
+
+// A sorted chain and its last node
+struct Run
+{
+    Node* first;
+    Node* last;
+};
+
+// Merges two sorted chains, taking a's node on ties so equal values keep their order
+Run merge(Run a, Run b)
+{
+    Node front(0);
+    Node* end = &front;
+    Node* x = a.first;
+    Node* y = b.first;
+    while (x && y)
+    {
+        // One of the two is compared next round; start loading both successors now
+        __builtin_prefetch(x->next);
+        __builtin_prefetch(y->next);
+        if (y->value < x->value)
+        {
+            end->next = y;
+            y = y->next;
+        }
+        else
+        {
+            end->next = x;
+            x = x->next;
+        }
+        end = end->next;
+    }
+    end->next = x ? x : y;
+    return {front.next, x ? a.last : y ? b.last : end};
+}
+
+}  // namespace
+
+void LinkedList::sort()
+{
+    DS_TIMED_OPERATION(LinkedList, "sort");
+    if (length < 2) return;
+    // runs[k] is empty or a sorted run of 2^k nodes, earlier nodes in higher slots. Each
+    // node joins as a run of one and carries upward like a binary counter, so most
+    // merges are small and work on nodes that were just touched (the scheme of Linux's
+    // list_sort). A full pass per run width would walk the whole list log n times.
+    Run runs[64] = {};
+    Node* current = head;
+    while (current)
+    {
+        Run run = {current, current};
+        current = current->next;
+        run.first->next = nullptr;
+        int k = 0;
+        for (; runs[k].first; k++)
+        {
+            DS_STEPS(size_t(1) << k);
+            run = merge(runs[k], run);
+            runs[k] = {nullptr, nullptr};
+        }
+        runs[k] = run;
+    }
+    Run sorted = {nullptr, nullptr};
+    for (const Run& run : runs)
+        if (run.first) sorted = sorted.first ? merge(run, sorted) : run;
+    head = sorted.first;
+    tail = sorted.last;
+    cursor = nullptr;
+}
+
+void LinkedList::adoptChain(LinkedList& from, Node*& first, Node*& last)
+{
+    if (from.allocator == allocator || !first) return;
+    Node copy(0);
+    Node* end = &copy;
+    forEachInChain(first,
+                   [&](Node* node)
+                   {
+                       end->next = makeNode(node->value);
+                       end = end->next;
+                       from.freeNode(node);
+                   });
+    first = copy.next;
+    last = end;
+}
+
+void LinkedList::takeAll(LinkedList& other, Node*& first, Node*& last, int& count)
+{
+    first = other.head;
+    last = other.tail;
+    count = other.length;
+    other.head = other.tail = nullptr;
+    other.length = 0;
+    other.cursor = nullptr;
+    // Each list's own pool holds only that list's nodes, so the blocks can change hands
+    if (allocator == &ownPool && other.allocator == &other.ownPool)
+        ownPool.absorb(other.ownPool);
+    else
+        adoptChain(other, first, last);
+}
+
+void LinkedList::linkChain(int index, Node* first, Node* last, int count)
+{
+    if (count == 0) return;
+    if (index == 0)
+    {
+        last->next = head;
+        head = first;
+        if (!tail) tail = last;
+    }
+    else if (index == length)
+    {
+        tail->next = first;
+        tail = last;
+    }
+    else
+    {
+        Node* prev = nodeAt(index - 1);
+        last->next = prev->next;
+        prev->next = first;
+    }
+    if (cursor && cursorIndex >= index) cursorIndex += count;
+    length += count;
+}
+
+bool LinkedList::concat(LinkedList& other)
+{
+    return splice(length, other);
+}
+
+bool LinkedList::splice(int index, LinkedList& other)
+{
+    DS_OPERATION(LinkedList, "splice");
+    if (&other == this || index < 0 || index > length) return false;
+    Node* first;
+    Node* last;
+    int count;
+    takeAll(other, first, last, count);
+    linkChain(index, first, last, count);
+    return true;
+}
+
+bool LinkedList::splitAt(int index, LinkedList& rest)
+{
+    DS_OPERATION(LinkedList, "splitAt");
+    if (&rest == this || index < 0 || index > length) return false;
+    if (index == length) return true;
+    Node* first;
+    Node* last = tail;
+    int count = length - index;
+    if (index == 0)
+    {
+        first = head;
+        head = tail = nullptr;
+        cursor = nullptr;
+    }
+    else
+    {
+        tail = nodeAt(index - 1);  // Leaves the cursor on the new tail
+        first = tail->next;
+        tail->next = nullptr;
+    }
+    length = index;
+    rest.adoptChain(*this, first, last);
+    rest.linkChain(rest.length, first, last, count);
+    return true;
+}
+
+bool LinkedList::hasCycle() const
+{
+    const Node* slow = head;
+    const Node* fast = head;
+    while (fast && fast->next)
+    {
+        slow = slow->next;
+        fast = fast->next->next;
+        if (slow == fast) return true;
+    }
+    return false;
+}
+
+Node* LinkedList::cycleStart() const
+{
+    // The runner moves one node at a time; the anchor jumps to it whenever the
+    // runner has gone a power of two past it. They meet after about mu + lambda
+    // steps, and the runner is then exactly lambda (the cycle length) ahead.
+    if (!head) return nullptr;
+    Node* anchor = head;
+    Node* runner = head->next;
+    long power = 1;
+    long lambda = 1;
+    while (runner != anchor)
+    {
+        if (!runner) return nullptr;
+        if (power == lambda)
+        {
+            anchor = runner;
+            power *= 2;
+            lambda = 0;
+        }
+        runner = runner->next;
+        lambda++;
+    }
+    // Two pointers lambda apart from the head meet at the first node of the cycle
+    Node* behind = head;
+    Node* ahead = head;
+    for (long i = 0; i < lambda; i++) ahead = ahead->next;
+    while (behind != ahead)
+    {
+        behind = behind->next;
+        ahead = ahead->next;
+    }
+    return behind;
+}
+
+DNode::DNode(int val) : value(val), prev(nullptr), next(nullptr) {}
+
+DoublyLinkedList::DoublyLinkedList(int value) : cursor(nullptr), cursorIndex(0)
+{
+    head = makeNode(value);
+    tail = head;
+    length = 1;
+}
+
+DNode* DoublyLinkedList::makeNode(int value)
+{
+    return new (pool.take()) DNode(value);
+}
+
+void DoublyLinkedList::freeNode(DNode* node)
+{
+    if (cursor == node) cursor = nullptr;
+    pool.give(node);
+}
+
+DNode* DoublyLinkedList::nodeAt(int index)
+{
+    // Start from whichever known position is closest to index
+    DNode* current = head;
+    int position = 0;
+    int best = index;
+    if (length - 1 - index < best)
+    {
+        current = tail;
+        position = length - 1;
+        best = length - 1 - index;
+    }
+    if (cursor && std::abs(cursorIndex - index) < best)
+    {
+        current = cursor;
+        position = cursorIndex;
+    }
+    for (; position < index; position++) current = current->next;
+    for (; position > index; position--) current = current->prev;
+    cursor = current;
+    cursorIndex = index;
+    return current;
+}
+
+void DoublyLinkedList::append(int value)
+{
+    DNode* newNode = makeNode(value);
+    if (!head)
+    {
+        head = tail = newNode;
+    }
+    else
+    {
+        newNode->prev = tail;
+        tail->next = newNode;
+        tail = newNode;
+    }
+    length++;
+}
+
+void DoublyLinkedList::prepend(int value)
+{
+    DNode* newNode = makeNode(value);
+    if (!head)
+    {
+        head = tail = newNode;
+    }
+    else
+    {
+        newNode->next = head;
+        head->prev = newNode;
+        head = newNode;
+    }
+    length++;
+    if (cursor) cursorIndex++;
+}
+
+void DoublyLinkedList::printList() const
+{
+    DNode* temp = head;
+    while (temp)
+    {
+        std::cout << temp->value << " <-> ";
+        temp = temp->next;
+    }
+    std::cout << "nullptr" << std::endl;
+}
+
+void DoublyLinkedList::deleteLast()
+{
+    if (!head) return;
+    DNode* temp = tail;
+    tail = tail->prev;
+    if (tail)
+        tail->next = nullptr;
+    else
+        head = nullptr;
+    freeNode(temp);
+    length--;
+}
+
+void DoublyLinkedList::deleteFirst()
+{
+    if (!head) return;
+    DNode* temp = head;
+    head = head->next;
+    if (head)
+        head->prev = nullptr;
+    else
+        tail = nullptr;
+    freeNode(temp);
+    if (cursor) cursorIndex--;
+    length--;
+}
+
+int DoublyLinkedList::getLength() const
+{
+    return length;
+}
+
+bool DoublyLinkedList::insert(int value, int index)
+{
+    if (index < 0 || index > length) return false;
+    if (index == 0)
+    {
+        prepend(value);
+        return true;
+    }
+    if (index == length)
+    {
+        append(value);
+        return true;
+    }
+
+    DNode* after = nodeAt(index);
+    DNode* newNode = makeNode(value);
+    newNode->prev = after->prev;
+    newNode->next = after;
+    after->prev->next = newNode;
+    after->prev = newNode;
+    length++;
+    cursor = newNode;
+    cursorIndex = index;
+    return true;
+}
+
+bool DoublyLinkedList::deletePosition(int index)
+{
+    if (index < 0 || index >= length) return false;
+    if (index == 0)
+    {
+        deleteFirst();
+        return true;
+    }
+    if (index == length - 1)
+    {
+        deleteLast();
+        return true;
+    }
+
+    DNode* toDelete = nodeAt(index);
+    toDelete->prev->next = toDelete->next;
+    toDelete->next->prev = toDelete->prev;
+    // The successor slides into this position, keep walking from there
+    DNode* successor = toDelete->next;
+    freeNode(toDelete);
+    cursor = successor;
+    cursorIndex = index;
+    length--;
+    return true;
+}
+
+void DoublyLinkedList::reverseLinkedList()
+{
+    DNode* curr = head;
+    while (curr)
+    {
+        DNode* nextNode = curr->next;
+        curr->next = curr->prev;
+        curr->prev = nextNode;
+        curr = nextNode;
+    }
+    DNode* temp = head;
+    head = tail;
+    tail = temp;
+    if (cursor) cursorIndex = length - 1 - cursorIndex;
+}
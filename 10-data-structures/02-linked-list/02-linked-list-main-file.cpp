@@ -1,5 +1,6 @@
 #include <iostream>
 #include "02-linked-list-header-file.h"
+#include "../instrumentation.h"
 using namespace std;
 
 int main()
@@ -7,5 +8,52 @@ int main()
     LinkedList* l1 = new LinkedList(10);
     l1->append(20);
     l1->printList();
+    delete l1;
+
+    // Several lists can share one pool; nodes freed by one list are reused by the other
+    NodePool shared(256);
+    LinkedList a(1, &shared);
+    LinkedList b(100, &shared);
+    for (int i = 2; i <= 5; i++) a.append(i);
+    a.deleteLast();
+    b.append(200);  // Takes the node a just gave back
+    a.printList();
+    b.printList();
+
+    // Doubly linked: deleteLast no longer walks the list, and nearby indexed
+    // calls reuse the position reached by the previous one
+    DoublyLinkedList d(0);
+    for (int i = 1; i < 10; i++) d.append(i);
+    d.insert(42, 5);
+    d.insert(43, 6);
+    d.deletePosition(7);
+    d.printList();
+    while (d.getLength() > 3) d.deleteLast();
+    d.reverseLinkedList();
+    d.printList();
+
+    // Whole-list algorithms: nothing is copied, the nodes are relinked
+    NodePool batch(1024);
+    LinkedList left(5, &batch);
+    for (int v : {3, 9, 1, 7}) left.append(v);
+    LinkedList right(8, &batch);
+    for (int v : {2, 6}) right.append(v);
+    left.concat(right);  // Same allocator: O(1), right is now empty
+    left.sort();
+    left.printList();
+    left.splitAt(4, right);  // right takes 6 7 8 9
+    left.printList();
+    right.printList();
+
+    // A cycle made by hand through getHead(), then undone
+    Node* last = left.getHead();
+    while (last->next) last = last->next;
+    last->next = left.getHead()->next;
+    cout << "cycle: " << left.hasCycle() << ", starts at " << left.cycleStart()->value << endl;
+    last->next = nullptr;
+    cout << "cycle: " << left.hasCycle() << endl;
+
+    // Counters from the DS_* hooks in instrumentation.h (build with -DDS_INSTRUMENTATION)
+    if (instrumentation::kEnabled) cout << "\n" << instrumentation::snapshot().text();
     return 0;
-}
\ No newline at end of file
+}
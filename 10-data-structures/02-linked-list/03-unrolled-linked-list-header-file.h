@@ -0,0 +1,214 @@
+#ifndef UNROLLED_LINKEDLIST_H
+#define UNROLLED_LINKEDLIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include "02-linked-list-header-file.h"
+
+// Linked list that stores several ints per node. Each node is exactly
+// NodeBytes large (one cache line by default), so a traversal touches one
+// line per Capacity values instead of one line per value.
+template <std::size_t NodeBytes = 64>
+class UnrolledLinkedList
+{
+   public:
+    // Number of values that fit next to the link and the count
+    static constexpr int Capacity =
+        static_cast<int>((NodeBytes - sizeof(void*) - sizeof(int)) / sizeof(int));
+
+    static_assert((NodeBytes & (NodeBytes - 1)) == 0, "NodeBytes must be a power of two");
+    static_assert(Capacity >= 2, "NodeBytes too small to hold two values");
+
+    struct alignas(NodeBytes) Block
+    {
+        Block* next;           // Pointer to the next block in the list
+        int count;             // Values used in this block
+        int values[Capacity];  // Values in list order
+    };
+
+   private:
+    Block* head;           // Pointer to the first block in the list
+    Block* tail;           // Pointer to the last block in the list
+    int length;            // Current number of values in the list
+    SlabPool<Block> pool;  // Storage for every block of this list
+
+    Block* makeBlock()
+    {
+        Block* block = static_cast<Block*>(pool.take());
+        block->next = nullptr;
+        block->count = 0;
+        return block;
+    }
+
+    // Block holding position index, with index turned into an offset inside it
+    Block* locate(int& index) const
+    {
+        Block* current = head;
+        while (index >= current->count)
+        {
+            index -= current->count;
+            current = current->next;
+        }
+        return current;
+    }
+
+    // Moves the upper half of a full block into a new block right after it
+    void split(Block* block)
+    {
+        Block* upper = makeBlock();
+        int keep = block->count / 2;
+        upper->count = block->count - keep;
+        std::copy(block->values + keep, block->values + block->count, upper->values);
+        block->count = keep;
+        upper->next = block->next;
+        block->next = upper;
+        if (tail == block) tail = upper;
+    }
+
+    // Removes an empty block, or pulls the next block in when both fit in one
+    void compact(Block* prev, Block* block)
+    {
+        if (block->count == 0)
+        {
+            if (prev)
+                prev->next = block->next;
+            else
+                head = block->next;
+            if (tail == block) tail = prev;
+            pool.give(block);
+            return;
+        }
+        Block* next = block->next;
+        if (next && block->count + next->count <= Capacity)
+        {
+            std::copy(next->values, next->values + next->count, block->values + block->count);
+            block->count += next->count;
+            block->next = next->next;
+            if (tail == next) tail = block;
+            pool.give(next);
+        }
+    }
+
+   public:
+    UnrolledLinkedList(int value) : head(nullptr), tail(nullptr), length(0) { append(value); }
+
+    UnrolledLinkedList(const UnrolledLinkedList&) = delete;
+    UnrolledLinkedList& operator=(const UnrolledLinkedList&) = delete;
+
+    void append(int value)
+    {
+        if (!tail || tail->count == Capacity)
+        {
+            Block* block = makeBlock();
+            if (tail)
+                tail->next = block;
+            else
+                head = block;
+            tail = block;
+        }
+        tail->values[tail->count++] = value;
+        length++;
+    }
+
+    void prepend(int value)
+    {
+        if (!head || head->count == Capacity)
+        {
+            Block* block = makeBlock();
+            block->next = head;
+            head = block;
+            if (!tail) tail = block;
+        }
+        std::copy_backward(head->values, head->values + head->count,
+                           head->values + head->count + 1);
+        head->values[0] = value;
+        head->count++;
+        length++;
+    }
+
+    void printList() const
+    {
+        forEach([](int value) { std::cout << value << " --> "; });
+        std::cout << "nullptr" << std::endl;
+    }
+
+    // Calls f(value) for every value from head to tail
+    template <typename F>
+    void forEach(F f) const
+    {
+        for (Block* block = head; block; block = block->next)
+            for (int i = 0; i < block->count; i++) f(block->values[i]);
+    }
+
+    void deleteLast() { deletePosition(length - 1); }
+    void deleteFirst() { deletePosition(0); }
+
+    int getLength() const { return length; }
+    Block* getHead() { return this->head; };
+
+    bool insert(int value, int index)
+    {
+        if (index < 0 || index > length) return false;
+        if (index == length)
+        {
+            append(value);
+            return true;
+        }
+
+        Block* block = locate(index);
+        if (block->count == Capacity)
+        {
+            split(block);
+            if (index >= block->count)
+            {
+                index -= block->count;
+                block = block->next;
+            }
+        }
+        std::copy_backward(block->values + index, block->values + block->count,
+                           block->values + block->count + 1);
+        block->values[index] = value;
+        block->count++;
+        length++;
+        return true;
+    }
+
+    bool deletePosition(int index)
+    {
+        if (index < 0 || index >= length) return false;
+
+        Block* prev = nullptr;
+        Block* block = head;
+        while (index >= block->count)
+        {
+            index -= block->count;
+            prev = block;
+            block = block->next;
+        }
+        std::copy(block->values + index + 1, block->values + block->count,
+                  block->values + index);
+        block->count--;
+        length--;
+        compact(prev, block);
+        return true;
+    }
+
+    void reverseLinkedList()
+    {
+        Block* prev = nullptr;
+        Block* curr = head;
+        tail = head;
+
+        while (curr)
+        {
+            std::reverse(curr->values, curr->values + curr->count);
+            Block* nextBlock = curr->next;
+            curr->next = prev;
+            prev = curr;
+            curr = nextBlock;
+        }
+        head = prev;
+    }
+};
+#endif
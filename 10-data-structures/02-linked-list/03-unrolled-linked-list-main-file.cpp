@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+#include "02-linked-list-header-file.h"
+#include "03-unrolled-linked-list-header-file.h"
+using namespace std;
+
+// Traversal and insert throughput: LinkedList vs UnrolledLinkedList.
+// Build with optimizations, e.g.
+//   g++ -O2 -std=c++17 02-linked-list-implementation.cpp 03-unrolled-linked-list-main-file.cpp
+
+const int kLength = 1000000;
+const int kTraversals = 20;
+const int kInserts = 2000;
+
+double secondsSince(chrono::steady_clock::time_point start)
+{
+    return chrono::duration<double>(chrono::steady_clock::now() - start).count();
+}
+
+long long sumList(LinkedList& list)
+{
+    long long sum = 0;
+    for (Node* node = list.getHead(); node; node = node->next) sum += node->value;
+    return sum;
+}
+
+template <size_t NodeBytes>
+long long sumList(UnrolledLinkedList<NodeBytes>& list)
+{
+    long long sum = 0;
+    list.forEach([&sum](int value) { sum += value; });
+    return sum;
+}
+
+template <typename List>
+void benchmark(const char* name, const vector<int>& positions)
+{
+    auto start = chrono::steady_clock::now();
+    List list(0);
+    for (int i = 1; i < kLength; i++) list.append(i);
+    double build = secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    long long checksum = 0;
+    for (int i = 0; i < kTraversals; i++) checksum += sumList(list);
+    double traverse = secondsSince(start);
+
+    start = chrono::steady_clock::now();
+    for (int position : positions) list.insert(-1, position);
+    double insert = secondsSince(start);
+
+    double values = double(kLength) * kTraversals;
+    cout << name << "\n"
+         << "  append   " << kLength / build / 1e6 << " M values/s\n"
+         << "  traverse " << values / traverse / 1e6 << " M values/s (checksum " << checksum
+         << ")\n"
+         << "  insert   " << kInserts / insert << " random inserts/s\n";
+}
+
+int main()
+{
+    UnrolledLinkedList<> small(1);
+    for (int i = 2; i <= 20; i++) small.append(i);
+    small.insert(99, 3);
+    small.deletePosition(10);
+    small.reverseLinkedList();
+    small.printList();
+    cout << "values per 64-byte node: " << UnrolledLinkedList<>::Capacity << "\n\n";
+
+    mt19937 rng(42);
+    vector<int> positions;
+    for (int i = 0; i < kInserts; i++)
+        positions.push_back(uniform_int_distribution<int>(0, kLength + i)(rng));
+
+    benchmark<LinkedList>("LinkedList", positions);
+    benchmark<UnrolledLinkedList<64>>("UnrolledLinkedList<64>", positions);
+    benchmark<UnrolledLinkedList<256>>("UnrolledLinkedList<256>", positions);
+    return 0;
+}
@@ -1,111 +1,32 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "stacks.h"
 
 using namespace std;
 
 /**
- * Node structure for the linked list
- * Each node contains an integer data and a pointer to the next node.
+ * Every thread repeatedly pushes a value and pops one back, the free-list pattern.
  */
-struct Node
-{
-    int data;
-    Node* next;
-
-    Node(int value) : data(value), next(nullptr) {}
-};
+const int kThreads = 4;
+const int kOpsPerThread = 500000;
 
-/**
- * Stack class implemented using a singly linked list
- */
-class Stack
+template <typename Worker>
+void reportThroughput(const char* name, Worker worker)
 {
-   private:
-    Node* topNode;  // Pointer to the top of the stack
-
-   public:
-    // Constructor initializes an empty stack.
-
-    Stack() : topNode(nullptr) {}
-
-    // Destructor to clean up memory by popping all elements.
-
-    ~Stack()
-    {
-        while (!isEmpty())
-        {
-            pop();
-        }
-    }
-
-    /**
-     * Push a value onto the stack.
-     * @param value Integer to push.
-     */
-    void push(int value)
-    {
-        Node* newNode = new Node(value);
-        newNode->next = topNode;
-        topNode = newNode;
-        cout << "Pushed " << value << " onto the stack.\n";
-    }
-
-    /**
-     * Remove the top element from the stack.
-     * Prints an error if the stack is empty.
-     */
-    void pop()
-    {
-        if (isEmpty())
-        {
-            cout << "Stack Underflow! Cannot pop from an empty stack.\n";
-            return;
-        }
-        Node* temp = topNode;
-        cout << "Popped " << temp->data << " from the stack.\n";
-        topNode = topNode->next;
-        delete temp;
-    }
-
-    /**
-     * Get the value at the top of the stack.
-     * @return Top value, or -1 if empty (could also throw an exception).
-     */
-    int top()
-    {
-        if (isEmpty())
-        {
-            cout << "Stack is empty. No top element.\n";
-            return -1;
-        }
-        return topNode->data;
-    }
-
-    /**
-     * Check if the stack is empty
-     * @return true if empty, false otherwise.
-     */
-    bool isEmpty() { return topNode == nullptr; }
-
-    /**
-     * Display all elements in the stack from top to bottom.
-     */
-    void display()
-    {
-        if (isEmpty())
-        {
-            cout << "Stack is empty.\n";
-            return;
-        }
-        cout << "Stack contents (top to bottom): ";
-        Node* current = topNode;
-        while (current != nullptr)
-        {
-            cout << current->data << " ";
-            current = current->next;
-        }
-        cout << endl;
-    }
-};
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int t = 0; t < kThreads; t++) threads.emplace_back(worker, t);
+    for (thread& t : threads) t.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << name << ": " << 2.0 * kThreads * kOpsPerThread / seconds / 1e6 << " M ops/s"
+         << endl;
+}
 
 /**
  * Main function to demonstrate stack operations.
@@ -131,5 +52,50 @@ int main()
     // Try popping from empty stack
     myStack.pop();
 
+    ConcurrentStack<int> shared;
+    vector<thread> workers;
+    for (int t = 0; t < kThreads; t++)
+        workers.emplace_back(
+            [&shared, t]
+            {
+                for (int i = 0; i < 1000; i++) shared.push(t * 1000 + i);
+            });
+    for (thread& w : workers) w.join();
+    long long sum = 0;
+    int value, count = 0;
+    while (shared.try_pop(value))
+    {
+        sum += value;
+        count++;
+    }
+    cout << "ConcurrentStack drained " << count << " values, sum " << sum << endl;
+
+    Stack locked(false);
+    mutex lock;
+    reportThroughput("Stack + mutex  ",
+                     [&](int t)
+                     {
+                         for (int i = 0; i < kOpsPerThread; i++)
+                         {
+                             lock_guard<mutex> guard(lock);
+                             locked.push(t);
+                             locked.pop();
+                         }
+                     });
+
+    ConcurrentStack<int> lockFree;
+    reportThroughput("ConcurrentStack",
+                     [&](int t)
+                     {
+                         int out;
+                         for (int i = 0; i < kOpsPerThread; i++)
+                         {
+                             lockFree.push(t);
+                             lockFree.try_pop(out);
+                         }
+                     });
+
+    // Counters from the DS_* hooks in instrumentation.h (build with -DDS_INSTRUMENTATION)
+    if (instrumentation::kEnabled) cout << "\n" << instrumentation::snapshot().text();
     return 0;
 }
@@ -0,0 +1,280 @@
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * Vector-like storage whose first N elements live inside the object itself.
+ * Only when the N+1th element arrives does it move everything to the heap,
+ * so small stacks never allocate.
+ */
+template <typename T, size_t N>
+class SmallBufferStorage
+{
+    static_assert(N > 0, "Inline capacity must be at least one element");
+
+   private:
+    alignas(T) unsigned char inlineBuffer[N * sizeof(T)];
+    T* items;      // inlineBuffer or a heap block
+    size_t count;  // Constructed elements
+    size_t slots;  // Elements that fit in items
+
+    T* inlineItems() { return reinterpret_cast<T*>(inlineBuffer); }
+
+    void destroyAll()
+    {
+        for (size_t i = 0; i < count; i++) items[i].~T();
+        count = 0;
+        if (items != inlineItems()) ::operator delete(items);
+        items = inlineItems();
+        slots = N;
+    }
+
+    // Moves the elements into a heap block of newCapacity slots
+    void relocate(T* larger, size_t newCapacity)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            new (larger + i) T(std::move_if_noexcept(items[i]));
+            items[i].~T();
+        }
+        if (items != inlineItems()) ::operator delete(items);
+        items = larger;
+        slots = newCapacity;
+    }
+
+    // Leaves other empty and inline
+    void takeFrom(SmallBufferStorage& other)
+    {
+        if (other.items != other.inlineItems())
+        {
+            // Steal the heap block
+            items = other.items;
+            count = other.count;
+            slots = other.slots;
+            other.items = other.inlineItems();
+            other.count = 0;
+            other.slots = N;
+        }
+        else
+        {
+            for (size_t i = 0; i < other.count; i++) emplace_back(std::move(other.items[i]));
+            other.clear();
+        }
+    }
+
+   public:
+    using value_type = T;
+
+    SmallBufferStorage() : items(inlineItems()), count(0), slots(N) {}
+
+    SmallBufferStorage(const SmallBufferStorage& other) : SmallBufferStorage()
+    {
+        reserve(other.count);
+        for (size_t i = 0; i < other.count; i++) emplace_back(other.items[i]);
+    }
+
+    SmallBufferStorage(SmallBufferStorage&& other) : SmallBufferStorage() { takeFrom(other); }
+
+    SmallBufferStorage& operator=(SmallBufferStorage other)
+    {
+        destroyAll();
+        takeFrom(other);
+        return *this;
+    }
+
+    ~SmallBufferStorage() { destroyAll(); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if (count < slots)
+        {
+            T* slot = new (items + count) T(std::forward<Args>(args)...);
+            count++;
+            return *slot;
+        }
+        // Build the new element first: args may refer to an element we are about to move
+        size_t newCapacity = slots * 2;
+        T* larger = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+        T* slot;
+        try
+        {
+            slot = new (larger + count) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            ::operator delete(larger);
+            throw;
+        }
+        relocate(larger, newCapacity);
+        count++;
+        return *slot;
+    }
+
+    void pop_back() { items[--count].~T(); }
+
+    void clear()
+    {
+        while (count > 0) pop_back();
+    }
+
+    void reserve(size_t wanted)
+    {
+        if (wanted <= slots) return;
+        relocate(static_cast<T*>(::operator new(wanted * sizeof(T))), wanted);
+    }
+
+    T& back() { return items[count - 1]; }
+    const T& back() const { return items[count - 1]; }
+    T& operator[](size_t i) { return items[i]; }
+    const T& operator[](size_t i) const { return items[i]; }
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    size_t capacity() const { return slots; }
+
+    // True while the elements still live inside the object
+    bool isInline() const { return items == reinterpret_cast<const T*>(inlineBuffer); }
+};
+
+/**
+ * Stack adapter over any vector-like Storage (std::vector by default).
+ *
+ * Nothing is printed, and misuse (top/pop on an empty stack, popping more
+ * elements than exist) throws std::out_of_range instead of returning a
+ * sentinel, so every value of T is a valid element.
+ */
+template <typename T, typename Storage = vector<T>>
+class Stack
+{
+   private:
+    Storage elements;  // Bottom of the stack at index 0
+
+   public:
+    /**
+     * Push a value onto the stack.
+     */
+    void push(const T& value) { elements.emplace_back(value); }
+    void push(T&& value) { elements.emplace_back(std::move(value)); }
+
+    /**
+     * Construct a value in place on top of the stack.
+     * @return Reference to the new top element.
+     */
+    template <typename... Args>
+    T& emplace(Args&&... args)
+    {
+        return elements.emplace_back(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Push every element of values, first element ends up deepest.
+     */
+    template <typename Range>
+    void push_range(const Range& values)
+    {
+        // Grow geometrically so repeated small ranges stay amortized O(1) per element
+        size_t needed = elements.size() + std::size(values);
+        if (needed > elements.capacity()) elements.reserve(max(needed, 2 * elements.size()));
+        for (const auto& value : values) elements.emplace_back(value);
+    }
+
+    /**
+     * Remove the top element.
+     * @throws std::out_of_range if the stack is empty.
+     */
+    void pop()
+    {
+        if (isEmpty()) throw out_of_range("Stack::pop on an empty stack");
+        elements.pop_back();
+    }
+
+    /**
+     * Remove the top count elements.
+     * @throws std::out_of_range (removing nothing) if fewer than count elements exist.
+     */
+    void pop_n(size_t count)
+    {
+        if (count > elements.size()) throw out_of_range("Stack::pop_n past the bottom");
+        for (size_t i = 0; i < count; i++) elements.pop_back();
+    }
+
+    /**
+     * Get the value at the top of the stack.
+     * @throws std::out_of_range if the stack is empty.
+     */
+    T& top()
+    {
+        if (isEmpty()) throw out_of_range("Stack::top on an empty stack");
+        return elements.back();
+    }
+
+    const T& top() const
+    {
+        if (isEmpty()) throw out_of_range("Stack::top on an empty stack");
+        return elements.back();
+    }
+
+    /**
+     * Make room for at least count elements in total.
+     */
+    void reserve(size_t count) { elements.reserve(count); }
+
+    size_t size() const { return elements.size(); }
+    bool isEmpty() const { return elements.empty(); }
+
+    // Read-only access to the underlying storage
+    const Storage& storage() const { return elements; }
+};
+
+// Stack that keeps its first N elements on the stack frame, with no heap allocation
+template <typename T, size_t N>
+using SmallStack = Stack<T, SmallBufferStorage<T, N>>;
+
+/**
+ * Main function to demonstrate stack operations.
+ */
+int main()
+{
+    Stack<int> numbers;
+    numbers.push(-1);  // -1 is an ordinary value now
+    numbers.push_range(vector<int>{10, 20, 30});
+    cout << "size " << numbers.size() << ", top " << numbers.top() << endl;
+
+    numbers.pop_n(3);
+    cout << "after pop_n(3): top " << numbers.top() << endl;
+    numbers.pop();
+
+    try
+    {
+        numbers.top();
+    }
+    catch (const out_of_range& error)
+    {
+        cout << "caught: " << error.what() << endl;
+    }
+
+    SmallStack<string, 4> words;
+    words.emplace(3, 'a');  // Constructs "aaa" in place
+    words.push("inline");
+    cout << "top " << words.top() << ", inline storage: " << words.storage().isInline() << endl;
+
+    for (int i = 0; i < 10; i++) words.push("spill " + to_string(i));
+    cout << "size " << words.size() << ", inline storage: " << words.storage().isInline()
+         << endl;
+
+    SmallStack<string, 4> copy = words;
+    words.push(words.top());  // Argument aliases an element while the storage grows
+    copy.pop_n(copy.size() - 1);
+    cout << "copy bottom: " << copy.top() << ", original top: " << words.top() << endl;
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+#ifndef STACKS_H
+#define STACKS_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include "../instrumentation.h"
+
+/**
+ * Node structure for the linked list
+ * Each node contains an integer data and a pointer to the next node.
+ */
+struct Node
+{
+    int data;
+    Node* next;
+
+    Node(int value) : data(value), next(nullptr) {}
+};
+
+/**
+ * Stack class implemented using a singly linked list
+ */
+class Stack
+{
+   private:
+    Node* topNode;  // Pointer to the top of the stack
+    bool verbose;   // Print a line for every operation
+
+   public:
+    // Constructor initializes an empty stack.
+
+    Stack(bool verbose = true) : topNode(nullptr), verbose(verbose) {}
+
+    // Destructor to clean up memory by popping all elements.
+
+    ~Stack()
+    {
+        while (!isEmpty())
+        {
+            pop();
+        }
+    }
+
+    /**
+     * Push a value onto the stack.
+     * @param value Integer to push.
+     */
+    void push(int value)
+    {
+        DS_OPERATION(Stack, "push");
+        DS_NODE_ALLOCATED(Stack, sizeof(Node));
+        Node* newNode = new Node(value);
+        newNode->next = topNode;
+        topNode = newNode;
+        if (verbose) std::cout << "Pushed " << value << " onto the stack.\n";
+    }
+
+    /**
+     * Remove the top element from the stack.
+     * Prints an error if the stack is empty.
+     */
+    void pop()
+    {
+        DS_OPERATION(Stack, "pop");
+        if (isEmpty())
+        {
+            if (verbose) std::cout << "Stack Underflow! Cannot pop from an empty stack.\n";
+            return;
+        }
+        Node* temp = topNode;
+        if (verbose) std::cout << "Popped " << temp->data << " from the stack.\n";
+        topNode = topNode->next;
+        DS_NODE_FREED(Stack, sizeof(Node));
+        delete temp;
+    }
+
+    /**
+     * Get the value at the top of the stack.
+     * @return Top value, or -1 if empty (could also throw an exception).
+     */
+    int top()
+    {
+        if (isEmpty())
+        {
+            if (verbose) std::cout << "Stack is empty. No top element.\n";
+            return -1;
+        }
+        return topNode->data;
+    }
+
+    /**
+     * Check if the stack is empty
+     * @return true if empty, false otherwise.
+     */
+    bool isEmpty() { return topNode == nullptr; }
+
+    /**
+     * Display all elements in the stack from top to bottom.
+     */
+    void display()
+    {
+        if (isEmpty())
+        {
+            std::cout << "Stack is empty.\n";
+            return;
+        }
+        std::cout << "Stack contents (top to bottom): ";
+        Node* current = topNode;
+        while (current != nullptr)
+        {
+            std::cout << current->data << " ";
+            current = current->next;
+        }
+        std::cout << std::endl;
+    }
+};
+
+// Assumed cache line size, used to keep independently written fields apart
+constexpr size_t kCacheLine = 64;
+
+/**
+ * Lock-free (Treiber) stack: the same linked structure as Stack, but the top
+ * pointer is swapped with compare-and-swap so any number of threads can push
+ * and pop without a mutex.
+ *
+ * - ABA: the top word packs the node pointer with a 16-bit version tag that
+ *   changes on every update, so a CAS based on a stale read always fails.
+ * - Reclamation: popped nodes go to an internal free list (itself a tagged
+ *   Treiber stack) and are only deleted by the destructor, so a thread that
+ *   read a node just before it was popped still reads valid memory.
+ * - Elimination: when the CAS on top fails, a push and a pop can meet in a
+ *   small array of slots and hand the node over without touching top; the
+ *   slots are tagged the same way.
+ *
+ * Assumes 64-bit pointers with at most 48 significant bits (x86-64, AArch64).
+ */
+template <typename T>
+class ConcurrentStack
+{
+    static_assert(sizeof(void*) == 8, "Tagged pointers need a 64-bit address space");
+
+   private:
+    struct LockFreeNode
+    {
+        T data;
+        std::atomic<LockFreeNode*> next{nullptr};
+    };
+
+    static constexpr uint64_t kPointerMask = (uint64_t(1) << 48) - 1;
+    static constexpr size_t kEliminationSlots = 8;
+    static constexpr int kEliminationWait = 64;  // Spins a pusher waits for a partner
+
+    static LockFreeNode* pointerOf(uint64_t word)
+    {
+        return reinterpret_cast<LockFreeNode*>(word & kPointerMask);
+    }
+
+    static uint64_t nextWord(uint64_t old, LockFreeNode* node)
+    {
+        uint64_t tag = (old >> 48) + 1;
+        return (reinterpret_cast<uintptr_t>(node) & kPointerMask) | (tag << 48);
+    }
+
+    // Tagged top pointer of a Treiber stack of nodes
+    class TaggedTop
+    {
+       private:
+        std::atomic<uint64_t> word{0};
+
+       public:
+        // One CAS attempt; false if another thread got in first
+        bool tryPush(LockFreeNode* node)
+        {
+            uint64_t old = word.load(std::memory_order_relaxed);
+            node->next.store(pointerOf(old), std::memory_order_relaxed);
+            return word.compare_exchange_weak(old, nextWord(old, node), std::memory_order_release,
+                                              std::memory_order_relaxed);
+        }
+
+        void push(LockFreeNode* node)
+        {
+            while (!tryPush(node))
+            {
+            }
+        }
+
+        // One CAS attempt; nullptr if empty (contended == false) or if the CAS lost
+        LockFreeNode* tryPop(bool& contended)
+        {
+            uint64_t old = word.load(std::memory_order_acquire);
+            LockFreeNode* node = pointerOf(old);
+            contended = false;
+            if (node == nullptr) return nullptr;
+            LockFreeNode* next = node->next.load(std::memory_order_relaxed);
+            if (word.compare_exchange_weak(old, nextWord(old, next), std::memory_order_acquire,
+                                           std::memory_order_relaxed))
+                return node;
+            contended = true;
+            return nullptr;
+        }
+
+        LockFreeNode* pop()
+        {
+            bool contended = true;
+            LockFreeNode* node = nullptr;
+            while (node == nullptr && contended) node = tryPop(contended);
+            return node;
+        }
+
+        LockFreeNode* peek() const { return pointerOf(word.load(std::memory_order_acquire)); }
+    };
+
+    // Tagged like TaggedTop: a node recycled through freeNodes and offered again gets a new
+    // word, so a pusher cannot mistake a later offer of the same node for its own
+    struct EliminationSlot
+    {
+        alignas(kCacheLine) std::atomic<uint64_t> word{0};
+    };
+
+    alignas(kCacheLine) TaggedTop top;
+    alignas(kCacheLine) TaggedTop freeNodes;
+    EliminationSlot slots[kEliminationSlots];
+
+    static EliminationSlot& randomSlot(EliminationSlot* slots)
+    {
+        // Per-thread xorshift, spreading threads over the slots
+        thread_local uint32_t state =
+            static_cast<uint32_t>(std::hash<std::thread::id>()(std::this_thread::get_id())) | 1;
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return slots[state % kEliminationSlots];
+    }
+
+    // Offer node to a concurrent pop. True if a popper took it.
+    bool eliminatePush(LockFreeNode* node)
+    {
+        EliminationSlot& slot = randomSlot(slots);
+        uint64_t empty = slot.word.load(std::memory_order_relaxed);
+        if (pointerOf(empty) != nullptr) return false;
+        uint64_t offer = nextWord(empty, node);
+        if (!slot.word.compare_exchange_strong(empty, offer, std::memory_order_release,
+                                               std::memory_order_relaxed))
+            return false;
+        for (int i = 0; i < kEliminationWait; i++)
+            if (slot.word.load(std::memory_order_acquire) != offer) return true;
+        // Nobody came: take the offer back, unless a popper grabs it right now
+        return !slot.word.compare_exchange_strong(offer, nextWord(offer, nullptr),
+                                                  std::memory_order_acquire,
+                                                  std::memory_order_relaxed);
+    }
+
+    // Take a node offered by a concurrent push, or nullptr
+    LockFreeNode* eliminatePop()
+    {
+        EliminationSlot& slot = randomSlot(slots);
+        uint64_t offer = slot.word.load(std::memory_order_acquire);
+        LockFreeNode* node = pointerOf(offer);
+        if (node != nullptr && slot.word.compare_exchange_strong(offer, nextWord(offer, nullptr),
+                                                                 std::memory_order_acquire,
+                                                                 std::memory_order_relaxed))
+            return node;
+        return nullptr;
+    }
+
+    static void deleteList(LockFreeNode* node)
+    {
+        while (node != nullptr)
+        {
+            LockFreeNode* next = node->next.load(std::memory_order_relaxed);
+            DS_NODE_FREED(ConcurrentStack, sizeof(LockFreeNode));
+            delete node;
+            node = next;
+        }
+    }
+
+   public:
+    ConcurrentStack() = default;
+    ConcurrentStack(const ConcurrentStack&) = delete;
+    ConcurrentStack& operator=(const ConcurrentStack&) = delete;
+
+    // Must not run concurrently with any other call
+    ~ConcurrentStack()
+    {
+        deleteList(top.peek());
+        deleteList(freeNodes.peek());
+    }
+
+    /**
+     * Push a value onto the stack. Safe to call from any thread.
+     */
+    void push(const T& value)
+    {
+        DS_OPERATION(ConcurrentStack, "push");
+        LockFreeNode* node = freeNodes.pop();
+        if (node == nullptr)
+        {
+            DS_NODE_ALLOCATED(ConcurrentStack, sizeof(LockFreeNode));
+            node = new LockFreeNode;
+        }
+        node->data = value;
+        while (!top.tryPush(node))
+        {
+            DS_STEP();  // Lost a CAS on top
+            if (eliminatePush(node)) return;
+        }
+    }
+
+    /**
+     * Pop the top value into out. Safe to call from any thread.
+     * @return false if the stack was empty.
+     */
+    bool try_pop(T& out)
+    {
+        DS_OPERATION(ConcurrentStack, "try_pop");
+        while (true)
+        {
+            bool contended;
+            LockFreeNode* node = top.tryPop(contended);
+            if (contended) DS_STEP();  // Lost a CAS on top
+            if (node == nullptr && contended) node = eliminatePop();
+            if (node != nullptr)
+            {
+                out = node->data;
+                freeNodes.push(node);
+                return true;
+            }
+            if (!contended) return false;
+        }
+    }
+
+    /**
+     * Snapshot check; another thread may change the answer right away.
+     */
+    bool isEmpty() const { return top.peek() == nullptr; }
+};
+
+#endif
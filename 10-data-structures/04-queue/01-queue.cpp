@@ -1,119 +1,181 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "queues.h"
 using namespace std;
 
 /**
- * Node structure for the linked list
+ * Hand kItems integers from a producer thread to a consumer thread and report items/second.
  */
-class Node
-{
-   public:
-    int data;
-    Node* next;
+const int kItems = 2000000;
 
-    Node(int value) : data(value), next(nullptr) {}
-};
+template <typename Run>
+void reportThroughput(const char* name, Run run)
+{
+    auto start = chrono::steady_clock::now();
+    long long checksum = run();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << name << ": " << kItems / seconds / 1e6 << " M items/s (checksum " << checksum << ")"
+         << endl;
+}
 
-/**
- * Queue class implemented using a singly linked list
- */
-class Queue
+long long benchmarkMutexQueue()
 {
-   private:
-    Node* frontNode;
-    Node* backNode;
-    int length;
-
-   public:
-    /**
-     * Constructor initializes an empty queue.
-     */
-    Queue() : frontNode(nullptr), backNode(nullptr), length(0) {}
-
-    /**
-     * Destructor to free all nodes in the queue.
-     */
-    ~Queue()
-    {
-        while (!isEmpty())
+    Queue queue(false);
+    mutex lock;
+    long long sum = 0;
+    thread consumer(
+        [&]
         {
-            dequeue();
-        }
+            for (int received = 0; received < kItems;)
+            {
+                lock_guard<mutex> guard(lock);
+                if (queue.isEmpty()) continue;
+                sum += queue.front();
+                queue.dequeue();
+                received++;
+            }
+        });
+    for (int i = 0; i < kItems; i++)
+    {
+        lock_guard<mutex> guard(lock);
+        queue.enqueue(i);
     }
+    consumer.join();
+    return sum;
+}
 
-    /**
-     * Add element to the back of the queue.
-     */
-    void enqueue(int value)
-    {
-        Node* newNode = new Node(value);
-        if (isEmpty())
+long long benchmarkRingBuffer()
+{
+    SpscRingBuffer<int, 4096> ring;
+    long long sum = 0;
+    thread consumer(
+        [&]
         {
-            frontNode = backNode = newNode;
-        }
+            int value;
+            for (int received = 0; received < kItems;)
+            {
+                if (ring.try_dequeue(value))
+                {
+                    sum += value;
+                    received++;
+                }
+                else
+                    this_thread::yield();
+            }
+        });
+    for (int i = 0; i < kItems;)
+    {
+        if (ring.try_enqueue(i))
+            i++;
         else
-        {
-            backNode->next = newNode;
-            backNode = newNode;
-        }
-        length++;
-        cout << "Enqueued: " << value << endl;
+            this_thread::yield();
     }
+    consumer.join();
+    return sum;
+}
 
-    /**
-     * Remove element from the front of the queue.
-     */
-    void dequeue()
-    {
-        if (isEmpty())
-        {
-            cout << "Queue is empty! Cannot dequeue.\n";
-            return;
-        }
-
-        Node* temp = frontNode;
-        frontNode = frontNode->next;
-        cout << "Dequeued: " << temp->data << endl;
-        delete temp;
-        length--;
-
-        if (frontNode == nullptr)
+long long benchmarkRingBufferBulk()
+{
+    SpscRingBuffer<int, 4096> ring;
+    const size_t batch = 256;
+    long long sum = 0;
+    thread consumer(
+        [&]
         {
-            backNode = nullptr;
-            cout << "Queue is now empty.\n";
-        }
+            int buffer[batch];
+            for (int received = 0; received < kItems;)
+            {
+                size_t n = ring.dequeue_bulk(buffer, batch);
+                if (n == 0) this_thread::yield();
+                for (size_t i = 0; i < n; i++) sum += buffer[i];
+                received += static_cast<int>(n);
+            }
+        });
+    vector<int> values(batch);
+    for (int next = 0; next < kItems;)
+    {
+        size_t want = min(batch, static_cast<size_t>(kItems - next));
+        for (size_t i = 0; i < want; i++) values[i] = next + static_cast<int>(i);
+        size_t n = ring.enqueue_bulk(values.data(), want);
+        if (n == 0) this_thread::yield();
+        next += static_cast<int>(n);
     }
+    consumer.join();
+    return sum;
+}
 
-    /**
-     * Return the size of the queue.
-     */
-    int size() const { return length; }
-
-    /**
-     * Check if the queue is empty.
-     */
-    bool isEmpty() const { return length == 0; }
-
-    /**
-     * Print all elements of the queue from front to back.
-     */
-    void print_queue() const
-    {
-        if (isEmpty())
-        {
-            cout << "Queue is empty.\n";
-            return;
-        }
+/**
+ * kItems integers split evenly over producer threads, drained by consumer threads.
+ */
+long long benchmarkMutexQueueMpmc(int producers, int consumers)
+{
+    Queue queue(false);
+    mutex lock;
+    atomic<long long> sum{0};
+    vector<thread> threads;
+    for (int c = 0; c < consumers; c++)
+        threads.emplace_back(
+            [&]
+            {
+                long long local = 0;
+                for (int received = 0; received < kItems / consumers;)
+                {
+                    lock_guard<mutex> guard(lock);
+                    if (queue.isEmpty()) continue;
+                    local += queue.front();
+                    queue.dequeue();
+                    received++;
+                }
+                sum += local;
+            });
+    for (int p = 0; p < producers; p++)
+        threads.emplace_back(
+            [&, p]
+            {
+                for (int i = p; i < kItems; i += producers)
+                {
+                    lock_guard<mutex> guard(lock);
+                    queue.enqueue(i);
+                }
+            });
+    for (thread& t : threads) t.join();
+    return sum;
+}
 
-        Node* current = frontNode;
-        cout << "Queue contents (front to back): ";
-        while (current)
-        {
-            cout << current->data << " ";
-            current = current->next;
-        }
-        cout << endl;
-    }
-};
+long long benchmarkMpmcQueue(int producers, int consumers)
+{
+    auto queue = make_unique<MpmcQueue<int, 4096>>();
+    atomic<long long> sum{0};
+    vector<thread> threads;
+    for (int c = 0; c < consumers; c++)
+        threads.emplace_back(
+            [&]
+            {
+                long long local = 0;
+                int value;
+                for (int received = 0; received < kItems / consumers; received++)
+                {
+                    queue->pop(value);
+                    local += value;
+                }
+                sum += local;
+            });
+    for (int p = 0; p < producers; p++)
+        threads.emplace_back(
+            [&, p]
+            {
+                for (int i = p; i < kItems; i += producers) queue->push(i);
+            });
+    for (thread& t : threads) t.join();
+    return sum;
+}
 
 /**
  * Main function to demonstrate queue operations.
@@ -142,5 +204,34 @@ int main()
     // Show final state
     queue.print_queue();
 
+    // Bounded ring buffer: fails instead of allocating when full
+    SpscRingBuffer<int, 4> ring;
+    for (int i = 1; i <= 5; i++)
+        cout << "try_enqueue(" << i << "): " << (ring.try_enqueue(i) ? "ok" : "full") << endl;
+    int value;
+    while (ring.try_dequeue(value)) cout << "try_dequeue: " << value << endl;
+
+    // Producer/consumer throughput
+    reportThroughput("Queue + mutex        ", benchmarkMutexQueue);
+    reportThroughput("SpscRingBuffer       ", benchmarkRingBuffer);
+    reportThroughput("SpscRingBuffer (bulk)", benchmarkRingBufferBulk);
+
+    MpmcQueue<int, 8> mpmc;
+    mpmc.try_push(7);
+    bool popped = mpmc.pop_for(value, chrono::milliseconds(10));
+    cout << "pop_for: " << (popped ? to_string(value) : "timed out");
+    popped = mpmc.pop_for(value, chrono::milliseconds(10));
+    cout << ", then " << (popped ? to_string(value) : "timed out") << endl;
+
+    // Vary producer/consumer counts
+    for (int threads : {1, 2, 4, 8})
+    {
+        cout << threads << " producers / " << threads << " consumers" << endl;
+        reportThroughput("  Queue + mutex        ",
+                         [threads] { return benchmarkMutexQueueMpmc(threads, threads); });
+        reportThroughput("  MpmcQueue            ",
+                         [threads] { return benchmarkMpmcQueue(threads, threads); });
+    }
+
     return 0;
 }
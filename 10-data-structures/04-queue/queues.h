@@ -0,0 +1,421 @@
+#ifndef QUEUES_H
+#define QUEUES_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <thread>
+#include <utility>
+#include "../instrumentation.h"
+
+/**
+ * Node structure for the linked list
+ */
+class Node
+{
+   public:
+    int data;
+    Node* next;
+
+    Node(int value) : data(value), next(nullptr) {}
+};
+
+/**
+ * Queue class implemented using a singly linked list
+ */
+class Queue
+{
+   private:
+    Node* frontNode;
+    Node* backNode;
+    int length;
+    bool verbose;  // Print a line for every operation
+
+   public:
+    /**
+     * Constructor initializes an empty queue.
+     */
+    Queue(bool verbose = true) : frontNode(nullptr), backNode(nullptr), length(0), verbose(verbose)
+    {
+    }
+
+    /**
+     * Destructor to free all nodes in the queue.
+     */
+    ~Queue()
+    {
+        while (!isEmpty())
+        {
+            dequeue();
+        }
+    }
+
+    /**
+     * Add element to the back of the queue.
+     */
+    void enqueue(int value)
+    {
+        DS_OPERATION(Queue, "enqueue");
+        DS_NODE_ALLOCATED(Queue, sizeof(Node));
+        Node* newNode = new Node(value);
+        if (isEmpty())
+        {
+            frontNode = backNode = newNode;
+        }
+        else
+        {
+            backNode->next = newNode;
+            backNode = newNode;
+        }
+        length++;
+        if (verbose) std::cout << "Enqueued: " << value << std::endl;
+    }
+
+    /**
+     * Remove element from the front of the queue.
+     */
+    void dequeue()
+    {
+        DS_OPERATION(Queue, "dequeue");
+        if (isEmpty())
+        {
+            if (verbose) std::cout << "Queue is empty! Cannot dequeue.\n";
+            return;
+        }
+
+        Node* temp = frontNode;
+        frontNode = frontNode->next;
+        if (verbose) std::cout << "Dequeued: " << temp->data << std::endl;
+        DS_NODE_FREED(Queue, sizeof(Node));
+        delete temp;
+        length--;
+
+        if (frontNode == nullptr)
+        {
+            backNode = nullptr;
+            if (verbose) std::cout << "Queue is now empty.\n";
+        }
+    }
+
+    /**
+     * Return the element at the front of the queue (queue must not be empty).
+     */
+    int front() const { return frontNode->data; }
+
+    /**
+     * Return the size of the queue.
+     */
+    int size() const { return length; }
+
+    /**
+     * Check if the queue is empty.
+     */
+    bool isEmpty() const { return length == 0; }
+
+    /**
+     * Print all elements of the queue from front to back.
+     */
+    void print_queue() const
+    {
+        if (isEmpty())
+        {
+            std::cout << "Queue is empty.\n";
+            return;
+        }
+
+        Node* current = frontNode;
+        std::cout << "Queue contents (front to back): ";
+        while (current)
+        {
+            std::cout << current->data << " ";
+            current = current->next;
+        }
+        std::cout << std::endl;
+    }
+};
+
+// Assumed cache line size, used to keep independently written fields apart
+constexpr size_t kCacheLine = 64;
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Elements live in a fixed array of Capacity slots. The producer only writes tail,
+ * the consumer only writes head, and each side keeps a private copy of the other
+ * index so it reads the shared one only when the buffer looks full/empty.
+ * Every index sits on its own cache line so the two threads never false-share.
+ */
+template <typename T, size_t Capacity>
+class SpscRingBuffer
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+   private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    // Consumer side
+    alignas(kCacheLine) std::atomic<size_t> head{0};
+    size_t cachedTail = 0;
+
+    // Producer side
+    alignas(kCacheLine) std::atomic<size_t> tail{0};
+    size_t cachedHead = 0;
+
+    alignas(kCacheLine) T slots[Capacity];
+
+   public:
+    /**
+     * Producer: add one element. Returns false if the buffer is full.
+     */
+    bool try_enqueue(const T& value)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        if (t - cachedHead == Capacity)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (t - cachedHead == Capacity) return false;
+        }
+        slots[t & kMask] = value;
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Consumer: take one element into out. Returns false if the buffer is empty.
+     */
+    bool try_dequeue(T& out)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        if (h == cachedTail)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (h == cachedTail) return false;
+        }
+        out = std::move(slots[h & kMask]);
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Producer: add up to count elements with a single index publish.
+     * @return Number of elements actually enqueued.
+     */
+    size_t enqueue_bulk(const T* values, size_t count)
+    {
+        size_t t = tail.load(std::memory_order_relaxed);
+        size_t space = Capacity - (t - cachedHead);
+        if (space < count)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            space = Capacity - (t - cachedHead);
+        }
+        size_t n = count < space ? count : space;
+        for (size_t i = 0; i < n; i++) slots[(t + i) & kMask] = values[i];
+        if (n > 0) tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Consumer: take up to maxCount elements into out with a single index publish.
+     * @return Number of elements actually dequeued.
+     */
+    size_t dequeue_bulk(T* out, size_t maxCount)
+    {
+        size_t h = head.load(std::memory_order_relaxed);
+        size_t available = cachedTail - h;
+        if (available < maxCount)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            available = cachedTail - h;
+        }
+        size_t n = maxCount < available ? maxCount : available;
+        for (size_t i = 0; i < n; i++) out[i] = std::move(slots[(h + i) & kMask]);
+        if (n > 0) head.store(h + n, std::memory_order_release);
+        return n;
+    }
+
+    /**
+     * Approximate number of stored elements (exact when called by either side while idle).
+     */
+    size_t size() const
+    {
+        return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire);
+    }
+
+    bool isEmpty() const { return size() == 0; }
+};
+
+/**
+ * Escalating wait used by the blocking calls: spin briefly, then yield, then sleep.
+ */
+class Backoff
+{
+   private:
+    int rounds = 0;
+
+   public:
+    void pause()
+    {
+        if (rounds < 16)
+        {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        }
+        else if (rounds < 64)
+            std::this_thread::yield();
+        else
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        rounds++;
+    }
+};
+
+/**
+ * Bounded lock-free queue for any number of producer and consumer threads.
+ *
+ * Each slot carries a sequence number that says whose turn it is: a producer may
+ * fill slot i when its sequence equals the claimed position, a consumer may empty
+ * it when the sequence is one past that. Threads only contend on the CAS that
+ * claims a position, never on a lock, and the two claim counters live on separate
+ * cache lines.
+ */
+template <typename T, size_t Capacity>
+class MpmcQueue
+{
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+
+   private:
+    static constexpr size_t kMask = Capacity - 1;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    alignas(kCacheLine) std::atomic<size_t> enqueuePos{0};
+    alignas(kCacheLine) std::atomic<size_t> dequeuePos{0};
+    alignas(kCacheLine) Cell cells[Capacity];
+
+   public:
+    MpmcQueue()
+    {
+        for (size_t i = 0; i < Capacity; i++) cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * Add one element without waiting. Returns false if the queue is full.
+     */
+    bool try_push(const T& value)
+    {
+        DS_OPERATION(MpmcQueue, "try_push");
+        size_t pos = enqueuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            DS_STEP();  // One claim attempt; more than one per call means contention
+            cell = &cells[pos & kMask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;  // Slot still holds an element from the previous lap
+            else
+                pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+        cell->data = value;
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Take one element into out without waiting. Returns false if the queue is empty.
+     */
+    bool try_pop(T& out)
+    {
+        DS_OPERATION(MpmcQueue, "try_pop");
+        size_t pos = dequeuePos.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true)
+        {
+            DS_STEP();  // One claim attempt; more than one per call means contention
+            cell = &cells[pos & kMask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            ptrdiff_t diff = static_cast<ptrdiff_t>(seq) - static_cast<ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    break;
+            }
+            else if (diff < 0)
+                return false;  // Producer has not filled this slot yet
+            else
+                pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+        out = std::move(cell->data);
+        cell->sequence.store(pos + Capacity, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * Add one element, waiting as long as it takes for space.
+     */
+    void push(const T& value)
+    {
+        Backoff backoff;
+        while (!try_push(value)) backoff.pause();
+    }
+
+    /**
+     * Take one element, waiting as long as it takes for data.
+     */
+    void pop(T& out)
+    {
+        Backoff backoff;
+        while (!try_pop(out)) backoff.pause();
+    }
+
+    /**
+     * Add one element, giving up after timeout. Returns false on timeout.
+     */
+    template <typename Rep, typename Period>
+    bool push_for(const T& value, std::chrono::duration<Rep, Period> timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        Backoff backoff;
+        while (!try_push(value))
+        {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            backoff.pause();
+        }
+        return true;
+    }
+
+    /**
+     * Take one element, giving up after timeout. Returns false on timeout.
+     */
+    template <typename Rep, typename Period>
+    bool pop_for(T& out, std::chrono::duration<Rep, Period> timeout)
+    {
+        auto deadline = std::chrono::steady_clock::now() + timeout;
+        Backoff backoff;
+        while (!try_pop(out))
+        {
+            if (std::chrono::steady_clock::now() >= deadline) return false;
+            backoff.pause();
+        }
+        return true;
+    }
+};
+
+#endif
@@ -1,76 +1,13 @@
+#include <chrono>
 #include <iostream>
+#include <random>
+#include <vector>
+#include "binary-search-tree.h"
 using namespace std;
 
-// Node of a Binary Search Tree
-class TreeNode
-{
-   public:
-    int data;
-    TreeNode* left;
-    TreeNode* right;
-
-    // Constructor
-    TreeNode(int data)
-    {
-        this->data = data;
-        left = nullptr;
-        right = nullptr;
-    }
-};
-
-// Binary Search Tree class
-class BinarySearchTree
-{
-   private:
-    TreeNode* root;
-
-   public:
-    // Constructor to initialize tree with root node
-    BinarySearchTree(int rootValue) { root = new TreeNode(rootValue); }
-
-    // Insert a new value into the BST
-    bool insert(int newValue)
-    {
-        TreeNode* current = root;
-
-        while (true)
-        {
-            if (newValue == current->data)
-            {
-                // Value already exists, insertion not allowed
-                return false;
-            }
-
-            if (newValue < current->data)
-            {
-                // Go to left subtree
-                if (current->left == nullptr)
-                {
-                    current->left = new TreeNode(newValue);
-                    return true;
-                }
-                current = current->left;
-            }
-            else
-            {
-                // Go to right subtree
-                if (current->right == nullptr)
-                {
-                    current->right = new TreeNode(newValue);
-                    return true;
-                }
-                current = current->right;
-            }
-        }
-    }
-
-    // Getter for root node (for traversal/debugging)
-    TreeNode* getRoot() { return root; }
-};
-
 int main()
 {
-    BinarySearchTree bst(10);
+    BinarySearchTree<> bst(10);
     bst.insert(5);
     bst.insert(2);
 
@@ -109,5 +46,66 @@ int main()
             cout << "right grandchild: nullptr ";
         cout << endl;
     }
+
+    cout << "in-order:    ";
+    for (const TreeNode& node : bst.inOrder()) cout << node.data << " ";
+    cout << endl << "pre-order:   ";
+    for (const TreeNode& node : bst.preOrder()) cout << node.data << " ";
+    cout << endl << "level-order: ";
+    for (const TreeNode& node : bst.levelOrder()) cout << node.data << " ";
+    cout << endl << "keys in [4, 16]: ";
+    bst.range(4, 16, [](int key) { cout << key << " "; });
+    cout << endl;
+
+    // Sorted input degenerates a plain BST into a list; the AVL tree stays shallow
+    BinarySearchTree<> plain;
+    AVLTree balanced;
+    for (int key = 1; key <= 1000; key++)
+    {
+        plain.insert(key);
+        balanced.insert(key);
+    }
+    cout << "height after 1000 sorted inserts: plain " << plain.height() << ", AVL "
+         << balanced.height() << endl;
+    long long plainSum = 0;
+    for (const TreeNode& node : plain.inOrder()) plainSum += node.data;  // 1000 deep, no recursion
+    cout << "sum of plain BST keys: " << plainSum << endl;
+
+    for (int key = 1; key <= 1000; key += 2) balanced.erase(key);
+    cout << "AVL after erasing odd keys: height " << balanced.height() << ", contains(500) "
+         << balanced.contains(500) << ", contains(501) " << balanced.contains(501) << endl;
+
+    vector<int> sorted;
+    for (int key = 0; key < 1023; key++) sorted.push_back(key * 3);
+    plain.buildFromSorted(sorted);
+    cout << "plain BST rebuilt from 1023 sorted keys: height " << plain.height() << endl;
+
+    // Point-query throughput: pointer tree vs frozen Eytzinger layout
+    const int keyCount = 1 << 20;
+    const int queryCount = 1 << 22;
+    mt19937 rng(7);
+    AVLTree big;
+    for (int i = 0; i < keyCount; i++) big.insert(static_cast<int>(rng() >> 1));
+    FrozenBST frozen = big.freeze();
+    vector<int> queries(queryCount);
+    for (int& q : queries) q = static_cast<int>(rng() >> 1);
+
+    auto start = chrono::steady_clock::now();
+    long long hits = 0;
+    for (int q : queries) hits += big.contains(q);
+    double treeSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    long long frozenHits = 0;
+    for (int q : queries) frozenHits += frozen.contains(q);
+    double frozenSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << "AVL tree:   " << queryCount / treeSeconds / 1e6 << " M lookups/s (" << hits
+         << " hits)" << endl;
+    cout << "FrozenBST:  " << queryCount / frozenSeconds / 1e6 << " M lookups/s (" << frozenHits
+         << " hits)" << endl;
+
+    // Counters from the DS_* hooks in instrumentation.h (build with -DDS_INSTRUMENTATION)
+    if (instrumentation::kEnabled) cout << "\n" << instrumentation::snapshot().text();
     return 0;
 }
@@ -0,0 +1,495 @@
+#ifndef BINARY_SEARCH_TREE_H
+#define BINARY_SEARCH_TREE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "../instrumentation.h"
+
+// Node of a Binary Search Tree
+class TreeNode
+{
+   public:
+    int data;
+    int height;  // Levels in the subtree rooted here (a leaf has height 1)
+    TreeNode* left;
+    TreeNode* right;
+
+    // Constructor
+    TreeNode(int data)
+    {
+        this->data = data;
+        height = 1;
+        left = nullptr;
+        right = nullptr;
+    }
+};
+
+inline int heightOf(TreeNode* node) { return node ? node->height : 0; }
+
+inline void updateHeight(TreeNode* node)
+{
+    node->height = 1 + std::max(heightOf(node->left), heightOf(node->right));
+}
+
+// Balance policies. After every insert/erase the tree calls rebalance() on each
+// node of the changed path, bottom-up, and stores the returned subtree root.
+
+// Plain BST: keeps heights up to date but never restructures
+struct NoBalance
+{
+    static TreeNode* rebalance(TreeNode* node)
+    {
+        updateHeight(node);
+        return node;
+    }
+};
+
+// AVL: rotates whenever one subtree gets two levels taller than the other
+struct AVLBalance
+{
+    static TreeNode* rotateRight(TreeNode* node)
+    {
+        TreeNode* pivot = node->left;
+        node->left = pivot->right;
+        pivot->right = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    static TreeNode* rotateLeft(TreeNode* node)
+    {
+        TreeNode* pivot = node->right;
+        node->right = pivot->left;
+        pivot->left = node;
+        updateHeight(node);
+        updateHeight(pivot);
+        return pivot;
+    }
+
+    static TreeNode* rebalance(TreeNode* node)
+    {
+        updateHeight(node);
+        int balance = heightOf(node->left) - heightOf(node->right);
+        if (balance > 1)
+        {
+            // Left-right case: turn it into left-left first
+            if (heightOf(node->left->left) < heightOf(node->left->right))
+                node->left = rotateLeft(node->left);
+            return rotateRight(node);
+        }
+        if (balance < -1)
+        {
+            // Right-left case: turn it into right-right first
+            if (heightOf(node->right->right) < heightOf(node->right->left))
+                node->right = rotateRight(node->right);
+            return rotateLeft(node);
+        }
+        return node;
+    }
+};
+
+// Read-only snapshot of a BST stored as an Eytzinger array: the node at index
+// k has its children at 2k and 2k+1, so a lookup walks one contiguous array
+// instead of chasing pointers, and the descent is branch-free.
+// Uses the GCC/Clang builtins __builtin_prefetch and __builtin_ffs.
+class FrozenBST
+{
+   private:
+    std::vector<int> storage;  // Backing memory, over-allocated so keys can start on a cache line
+    size_t offset;             // keys() starts here in storage; an index, so copies stay valid
+    int count;
+
+    // keys()[1..count], root at keys()[1]. A copy keeps the offset, and its keys are
+    // then merely not line-aligned.
+    int* keys() { return storage.data() + offset; }
+    const int* keys() const { return storage.data() + offset; }
+
+    // Fills keys[k] and its subtree with the next values of sorted, in order
+    void fill(const std::vector<int>& sorted, size_t& next, int k)
+    {
+        if (k > count) return;
+        fill(sorted, next, 2 * k);
+        keys()[k] = sorted[next++];
+        fill(sorted, next, 2 * k + 1);
+    }
+
+    // Eytzinger index of the first key >= value, or 0 if there is none
+    int search(int value) const
+    {
+        const int* base = keys();
+        int k = 1;
+        while (k <= count)
+        {
+            // 16 ints are one cache line: fetch the line holding our descendants four levels down
+            __builtin_prefetch(base + 16 * k);
+            k = 2 * k + (base[k] < value);
+        }
+        // Undo the trailing right turns (and the last left turn) to land on the answer
+        k >>= __builtin_ffs(~k);
+        return k;
+    }
+
+   public:
+    // sorted must be strictly increasing
+    explicit FrozenBST(const std::vector<int>& sorted) : count(static_cast<int>(sorted.size()))
+    {
+        const size_t perLine = 64 / sizeof(int);
+        storage.resize(count + 1 + perLine);
+        uintptr_t address = reinterpret_cast<uintptr_t>(storage.data());
+        size_t skip = (64 - address % 64) % 64 / sizeof(int);
+        // Index 0 is unused, so shift by one more slot and put keys[1] on a line boundary
+        offset = skip == 0 ? perLine - 1 : skip - 1;
+        keys()[0] = 0;
+        size_t next = 0;
+        fill(sorted, next, 1);
+    }
+
+    bool contains(int value) const
+    {
+        int k = search(value);
+        return k != 0 && keys()[k] == value;
+    }
+
+    // Smallest key >= value; returns false when every key is smaller
+    bool lowerBound(int value, int& result) const
+    {
+        int k = search(value);
+        if (k == 0) return false;
+        result = keys()[k];
+        return true;
+    }
+
+    // Answers several point queries in one call; out[i] is contains(values[i])
+    void containsBatch(const std::vector<int>& values, std::vector<bool>& out) const
+    {
+        out.resize(values.size());
+        for (size_t i = 0; i < values.size(); i++) out[i] = contains(values[i]);
+    }
+
+    int size() const { return count; }
+};
+
+// Traversal iterators. The depth-first ones keep an explicit stack reserved to
+// the tree height up front, so they never recurse and allocate at most once.
+// Use them through BinarySearchTree::inOrder()/preOrder()/levelOrder().
+
+// End marker shared by all traversals
+struct TraversalEnd
+{
+};
+
+class InOrderIterator
+{
+   private:
+    std::vector<TreeNode*> pending;  // Ancestors whose left subtree is being visited
+
+    void pushLeft(TreeNode* node)
+    {
+        for (; node != nullptr; node = node->left) pending.push_back(node);
+    }
+
+   public:
+    InOrderIterator(TreeNode* root, int height)
+    {
+        pending.reserve(height);
+        pushLeft(root);
+    }
+
+    const TreeNode& operator*() const { return *pending.back(); }
+    const TreeNode* operator->() const { return pending.back(); }
+
+    InOrderIterator& operator++()
+    {
+        TreeNode* node = pending.back();
+        pending.pop_back();
+        pushLeft(node->right);
+        return *this;
+    }
+
+    bool operator!=(TraversalEnd) const { return !pending.empty(); }
+};
+
+class PreOrderIterator
+{
+   private:
+    std::vector<TreeNode*> pending;  // Next node on top, right siblings below it
+
+   public:
+    PreOrderIterator(TreeNode* root, int height)
+    {
+        pending.reserve(height + 1);
+        if (root != nullptr) pending.push_back(root);
+    }
+
+    const TreeNode& operator*() const { return *pending.back(); }
+    const TreeNode* operator->() const { return pending.back(); }
+
+    PreOrderIterator& operator++()
+    {
+        TreeNode* node = pending.back();
+        pending.pop_back();
+        if (node->right != nullptr) pending.push_back(node->right);
+        if (node->left != nullptr) pending.push_back(node->left);
+        return *this;
+    }
+
+    bool operator!=(TraversalEnd) const { return !pending.empty(); }
+};
+
+// Breadth-first, so it needs a queue as wide as the widest level
+class LevelOrderIterator
+{
+   private:
+    std::deque<TreeNode*> pending;
+
+   public:
+    LevelOrderIterator(TreeNode* root, int)
+    {
+        if (root != nullptr) pending.push_back(root);
+    }
+
+    const TreeNode& operator*() const { return *pending.front(); }
+    const TreeNode* operator->() const { return pending.front(); }
+
+    LevelOrderIterator& operator++()
+    {
+        TreeNode* node = pending.front();
+        pending.pop_front();
+        if (node->left != nullptr) pending.push_back(node->left);
+        if (node->right != nullptr) pending.push_back(node->right);
+        return *this;
+    }
+
+    bool operator!=(TraversalEnd) const { return !pending.empty(); }
+};
+
+// begin()/end() pair so a traversal can drive a range-based for loop
+template <typename Iterator>
+class Traversal
+{
+   private:
+    TreeNode* root;
+    int height;
+
+   public:
+    Traversal(TreeNode* root, int height) : root(root), height(height) {}
+
+    Iterator begin() const { return Iterator(root, height); }
+    TraversalEnd end() const { return TraversalEnd(); }
+};
+
+// Binary Search Tree class
+template <typename Balance = NoBalance>
+class BinarySearchTree
+{
+   private:
+    TreeNode* root;
+
+    // Links from the root down to the last visited node, used to rebalance bottom-up
+    std::vector<TreeNode**> path;
+
+    void rebalancePath()
+    {
+        for (auto link = path.rbegin(); link != path.rend(); ++link)
+            **link = Balance::rebalance(**link);
+        path.clear();
+    }
+
+    // Builds a perfectly balanced subtree from sorted[lo, hi)
+    static TreeNode* build(const std::vector<int>& sorted, size_t lo, size_t hi)
+    {
+        if (lo >= hi) return nullptr;
+        size_t mid = lo + (hi - lo) / 2;
+        DS_NODE_ALLOCATED(BinarySearchTree, sizeof(TreeNode));
+        TreeNode* node = new TreeNode(sorted[mid]);
+        node->left = build(sorted, lo, mid);
+        node->right = build(sorted, mid + 1, hi);
+        updateHeight(node);
+        return node;
+    }
+
+    void clear()
+    {
+        // Delete without recursion so degenerate trees cannot overflow the stack
+        std::vector<TreeNode*> pending;
+        if (root) pending.push_back(root);
+        while (!pending.empty())
+        {
+            TreeNode* node = pending.back();
+            pending.pop_back();
+            if (node->left) pending.push_back(node->left);
+            if (node->right) pending.push_back(node->right);
+            DS_NODE_FREED(BinarySearchTree, sizeof(TreeNode));
+            delete node;
+        }
+        root = nullptr;
+    }
+
+   public:
+    // Constructor for an empty tree
+    BinarySearchTree() : root(nullptr) {}
+
+    // Constructor to initialize tree with root node
+    BinarySearchTree(int rootValue)
+    {
+        DS_NODE_ALLOCATED(BinarySearchTree, sizeof(TreeNode));
+        root = new TreeNode(rootValue);
+    }
+
+    ~BinarySearchTree() { clear(); }
+
+    BinarySearchTree(const BinarySearchTree&) = delete;
+    BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+    // Insert a new value into the BST
+    bool insert(int newValue)
+    {
+        DS_TIMED_OPERATION(BinarySearchTree, "insert");
+        TreeNode** link = &root;
+
+        while (*link != nullptr)
+        {
+            TreeNode* current = *link;
+            if (newValue == current->data)
+            {
+                // Value already exists, insertion not allowed
+                path.clear();
+                return false;
+            }
+
+            path.push_back(link);
+            // Go to left or right subtree
+            link = newValue < current->data ? &current->left : &current->right;
+        }
+
+        DS_STEPS(path.size());  // Depth the new node lands at
+        DS_NODE_ALLOCATED(BinarySearchTree, sizeof(TreeNode));
+        *link = new TreeNode(newValue);
+        rebalancePath();
+        return true;
+    }
+
+    // Check whether a value is stored in the tree
+    bool contains(int value) const
+    {
+        // Calls only: a per-level step count keeps GCC from making this loop branch-free
+        DS_OPERATION(BinarySearchTree, "contains");
+        TreeNode* current = root;
+        while (current != nullptr)
+        {
+            if (value == current->data) return true;
+            current = value < current->data ? current->left : current->right;
+        }
+        return false;
+    }
+
+    // Remove a value from the BST, returns false if it was not present
+    bool erase(int value)
+    {
+        DS_TIMED_OPERATION(BinarySearchTree, "erase");
+        TreeNode** link = &root;
+        while (*link != nullptr && (*link)->data != value)
+        {
+            path.push_back(link);
+            link = value < (*link)->data ? &(*link)->left : &(*link)->right;
+        }
+        if (*link == nullptr)
+        {
+            path.clear();
+            return false;
+        }
+
+        TreeNode* target = *link;
+        if (target->left != nullptr && target->right != nullptr)
+        {
+            // Two children: take over the in-order successor's value, then unlink the successor
+            path.push_back(link);
+            link = &target->right;
+            while ((*link)->left != nullptr)
+            {
+                path.push_back(link);
+                link = &(*link)->left;
+            }
+            target->data = (*link)->data;
+            target = *link;
+        }
+
+        *link = target->left != nullptr ? target->left : target->right;
+        DS_STEPS(path.size());  // Depth of the node actually unlinked
+        DS_NODE_FREED(BinarySearchTree, sizeof(TreeNode));
+        delete target;
+        rebalancePath();
+        return true;
+    }
+
+    // Replace the contents with a perfectly balanced tree built in O(n).
+    // Returns false (and leaves the tree alone) unless sorted is strictly increasing.
+    bool buildFromSorted(const std::vector<int>& sorted)
+    {
+        if (std::adjacent_find(sorted.begin(), sorted.end(), std::greater_equal<int>()) !=
+            sorted.end())
+            return false;
+        clear();
+        root = build(sorted, 0, sorted.size());
+        return true;
+    }
+
+    // Copy the keys into a FrozenBST for fast read-only lookups. The tree itself is unchanged.
+    FrozenBST freeze() const
+    {
+        std::vector<int> sorted;
+        for (const TreeNode& node : inOrder()) sorted.push_back(node.data);
+        return FrozenBST(sorted);
+    }
+
+    Traversal<InOrderIterator> inOrder() const { return {root, height()}; }
+    Traversal<PreOrderIterator> preOrder() const { return {root, height()}; }
+    Traversal<LevelOrderIterator> levelOrder() const { return {root, height()}; }
+
+    // Calls callback(key) for every key in [lo, hi], in ascending order.
+    // Subtrees that lie entirely outside the range are never entered.
+    template <typename F>
+    void range(int lo, int hi, F callback) const
+    {
+        std::vector<TreeNode*> pending;
+        pending.reserve(height());
+        TreeNode* current = root;
+        while (current != nullptr || !pending.empty())
+        {
+            while (current != nullptr)
+            {
+                if (current->data < lo)
+                {
+                    // This node and its left subtree are below the range
+                    current = current->right;
+                    continue;
+                }
+                pending.push_back(current);
+                current = current->left;
+            }
+            if (pending.empty()) return;
+            current = pending.back();
+            pending.pop_back();
+            if (current->data > hi) return;
+            callback(current->data);
+            current = current->right;
+        }
+    }
+
+    // Number of levels in the tree (0 when empty)
+    int height() const { return heightOf(root); }
+
+    // Getter for root node (for traversal/debugging)
+    TreeNode* getRoot() { return root; }
+};
+
+// Tree that stays O(log n) deep whatever order keys arrive in
+using AVLTree = BinarySearchTree<AVLBalance>;
+
+#endif
@@ -0,0 +1,570 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+#if defined(__GNUG__)
+#include <cxxabi.h>
+#endif
+
+/*
+ * Opt-in counters for the data structures in 10-data-structures. Define
+ * DS_INSTRUMENTATION (CMake: -DCPP_NOTES_INSTRUMENT=ON) to turn them on;
+ * without it every DS_* macro below expands to nothing, and the snapshot API
+ * still compiles but reports nothing.
+ *
+ * Counters are kept per (type, operation) and per thread:
+ *   calls          times the operation ran
+ *   steps          nodes walked, levels descended or CAS retries inside it
+ *                  (total and the longest single call), where it reports them
+ *   ticks          time-stamp counter ticks spent inside a timed operation
+ *   nodes, bytes   node allocations and frees reported by the type
+ * A thread only ever writes its own counters, with plain relaxed loads and
+ * stores (no locked instructions); snapshot() adds up the live threads and
+ * whatever exited threads left behind.
+ *
+ * Inside a function body:
+ *   DS_OPERATION(Stack, "push");          count this call
+ *   DS_TIMED_OPERATION(Stack, "push");    count it and time it with RDTSC
+ *                                         (two reads, tens of cycles: keep it
+ *                                         for operations that walk)
+ *   DS_STEP(); DS_STEPS(n);               steps of the innermost operation
+ *                                         running on this thread
+ *   DS_NODE_ALLOCATED(Stack, bytes); DS_NODE_FREED(Stack, bytes);
+ *   DS_NODES_FREED(Stack, count, bytes);  many nodes released at once
+ * and from anywhere:
+ *   instrumentation::snapshot().text(), .json(); instrumentation::reset()
+ */
+
+namespace instrumentation
+{
+
+#ifdef DS_INSTRUMENTATION
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+// Distinct (type, operation) pairs a program may use
+constexpr std::size_t kMaxSites = 256;
+
+// Counter values of one (type, operation) pair, summed over some threads
+struct Totals
+{
+    std::uint64_t calls = 0;
+    std::uint64_t steps = 0;
+    std::uint64_t maxSteps = 0;
+    std::uint64_t timedCalls = 0;
+    std::uint64_t ticks = 0;
+    std::uint64_t nodesAllocated = 0;
+    std::uint64_t nodesFreed = 0;
+    std::uint64_t bytesAllocated = 0;
+    std::uint64_t bytesFreed = 0;
+
+    void add(const Totals& other)
+    {
+        calls += other.calls;
+        steps += other.steps;
+        maxSteps = std::max(maxSteps, other.maxSteps);
+        timedCalls += other.timedCalls;
+        ticks += other.ticks;
+        nodesAllocated += other.nodesAllocated;
+        nodesFreed += other.nodesFreed;
+        bytesAllocated += other.bytesAllocated;
+        bytesFreed += other.bytesFreed;
+    }
+
+    bool empty() const { return calls == 0 && nodesAllocated == 0 && nodesFreed == 0; }
+};
+
+struct OperationReport
+{
+    std::string type;
+    std::string operation;
+    Totals total;
+    std::vector<std::pair<std::size_t, Totals>> threads;  // (thread number, counters)
+    Totals exitedThreads;                                 // Threads that have finished
+};
+
+class Snapshot
+{
+   private:
+    static std::string quoted(const std::string& text)
+    {
+        std::string out = "\"";
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\') out += '\\';
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    static void writeTotals(std::ostringstream& out, const Totals& t)
+    {
+        out << "\"calls\": " << t.calls << ", \"steps\": " << t.steps
+            << ", \"max_steps\": " << t.maxSteps << ", \"timed_calls\": " << t.timedCalls
+            << ", \"ticks\": " << t.ticks << ", \"nodes_allocated\": " << t.nodesAllocated
+            << ", \"nodes_freed\": " << t.nodesFreed
+            << ", \"bytes_allocated\": " << t.bytesAllocated
+            << ", \"bytes_freed\": " << t.bytesFreed;
+    }
+
+    static void writeRow(std::ostringstream& out, const std::string& label, const Totals& t)
+    {
+        out.width(28);
+        out << std::left << label << std::right;
+        out.width(12);
+        out << t.calls;
+        out.width(12);
+        if (t.calls > 0 && t.steps > 0)
+            out << static_cast<double>(t.steps) / t.calls;
+        else
+            out << "-";
+        out.width(11);
+        if (t.steps > 0)
+            out << t.maxSteps;
+        else
+            out << "-";
+        out.width(12);
+        if (t.timedCalls > 0)
+            out << static_cast<double>(t.ticks) / t.timedCalls;
+        else
+            out << "-";
+        out << "\n";
+    }
+
+   public:
+    bool enabled = kEnabled;
+    std::size_t threadsSeen = 0;  // Threads that ever recorded anything
+    std::vector<OperationReport> operations;
+
+    // Everything about one type: all of its operations added together
+    Totals typeTotals(const std::string& type) const
+    {
+        Totals sum;
+        for (const OperationReport& report : operations)
+            if (report.type == type) sum.add(report.total);
+        return sum;
+    }
+
+    std::vector<std::string> types() const
+    {
+        std::vector<std::string> names;
+        for (const OperationReport& report : operations)
+            if (std::find(names.begin(), names.end(), report.type) == names.end())
+                names.push_back(report.type);
+        return names;
+    }
+
+    // One block per type: its operations, then its nodes; threads listed when more than one ran it
+    std::string text() const
+    {
+        std::ostringstream out;
+        if (!enabled) return "instrumentation disabled (build with -DDS_INSTRUMENTATION)\n";
+        out.setf(std::ios::fixed);
+        out.precision(2);
+        out << "operation                          calls  steps/call  max steps  ticks/call\n";
+        for (const std::string& type : types())
+        {
+            out << type << "\n";
+            for (const OperationReport& report : operations)
+            {
+                if (report.type != type || report.total.calls == 0) continue;
+                writeRow(out, "  " + report.operation, report.total);
+                if (report.threads.size() + (report.exitedThreads.calls > 0) < 2) continue;
+                for (const auto& thread : report.threads)
+                    writeRow(out, "    thread " + std::to_string(thread.first), thread.second);
+                if (report.exitedThreads.calls > 0)
+                    writeRow(out, "    exited threads", report.exitedThreads);
+            }
+            Totals sum = typeTotals(type);
+            if (sum.nodesAllocated > 0 || sum.nodesFreed > 0)
+                out << "  nodes: " << sum.nodesAllocated << " allocated, " << sum.nodesFreed
+                    << " freed, "
+                    << static_cast<std::int64_t>(sum.bytesAllocated - sum.bytesFreed)
+                    << " bytes live\n";
+        }
+        return out.str();
+    }
+
+    std::string json() const
+    {
+        std::ostringstream out;
+        out << "{\n  \"enabled\": " << (enabled ? "true" : "false")
+            << ",\n  \"threads\": " << threadsSeen << ",\n  \"types\": [";
+        const char* separator = "\n";
+        for (const std::string& type : types())
+        {
+            Totals sum = typeTotals(type);
+            out << separator << "    {\"type\": " << quoted(type)
+                << ", \"nodes_allocated\": " << sum.nodesAllocated
+                << ", \"nodes_freed\": " << sum.nodesFreed << ", \"bytes_live\": "
+                << static_cast<std::int64_t>(sum.bytesAllocated - sum.bytesFreed) << "}";
+            separator = ",\n";
+        }
+        out << "\n  ],\n  \"operations\": [";
+        separator = "\n";
+        for (const OperationReport& report : operations)
+        {
+            out << separator << "    {\"type\": " << quoted(report.type)
+                << ", \"operation\": " << quoted(report.operation) << ", ";
+            writeTotals(out, report.total);
+            out << ",\n     \"per_thread\": [";
+            const char* threadSeparator = "";
+            for (const auto& thread : report.threads)
+            {
+                out << threadSeparator << "{\"thread\": " << thread.first << ", ";
+                writeTotals(out, thread.second);
+                out << "}";
+                threadSeparator = ", ";
+            }
+            out << "],\n     \"exited_threads\": {";
+            writeTotals(out, report.exitedThreads);
+            out << "}}";
+            separator = ",\n";
+        }
+        out << "\n  ]\n}\n";
+        return out.str();
+    }
+};
+
+namespace detail
+{
+
+// Only the owning thread writes, so a load and a store are enough (no lock prefix)
+inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t by)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+}
+
+// One thread's counters for one (type, operation) pair
+struct Counters
+{
+    std::atomic<std::uint64_t> calls{0};
+    std::atomic<std::uint64_t> steps{0};
+    std::atomic<std::uint64_t> maxSteps{0};
+    std::atomic<std::uint64_t> timedCalls{0};
+    std::atomic<std::uint64_t> ticks{0};
+    std::atomic<std::uint64_t> nodesAllocated{0};
+    std::atomic<std::uint64_t> nodesFreed{0};
+    std::atomic<std::uint64_t> bytesAllocated{0};
+    std::atomic<std::uint64_t> bytesFreed{0};
+
+    Totals read() const
+    {
+        Totals t;
+        t.calls = calls.load(std::memory_order_relaxed);
+        t.steps = steps.load(std::memory_order_relaxed);
+        t.maxSteps = maxSteps.load(std::memory_order_relaxed);
+        t.timedCalls = timedCalls.load(std::memory_order_relaxed);
+        t.ticks = ticks.load(std::memory_order_relaxed);
+        t.nodesAllocated = nodesAllocated.load(std::memory_order_relaxed);
+        t.nodesFreed = nodesFreed.load(std::memory_order_relaxed);
+        t.bytesAllocated = bytesAllocated.load(std::memory_order_relaxed);
+        t.bytesFreed = bytesFreed.load(std::memory_order_relaxed);
+        return t;
+    }
+
+    void clear()
+    {
+        for (std::atomic<std::uint64_t>* counter :
+             {&calls, &steps, &maxSteps, &timedCalls, &ticks, &nodesAllocated, &nodesFreed,
+              &bytesAllocated, &bytesFreed})
+            counter->store(0, std::memory_order_relaxed);
+    }
+};
+
+class ThreadCounters;
+
+// Every site and every thread's counters. Sites are added, never removed.
+class Registry
+{
+   private:
+    struct Site
+    {
+        std::string type;
+        std::string operation;
+    };
+
+    std::mutex lock;
+    std::vector<Site> sites;
+    std::vector<Totals> exited;         // Per site, from threads that have finished
+    std::vector<ThreadCounters*> live;  // Threads currently running
+    std::size_t threadsSeen = 0;
+
+    friend class ThreadCounters;
+
+   public:
+    static Registry& instance()
+    {
+        static Registry registry;
+        return registry;
+    }
+
+    std::size_t addSite(const std::string& type, const char* operation)
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        for (std::size_t i = 0; i < sites.size(); i++)
+            if (sites[i].type == type && sites[i].operation == operation) return i;
+        if (sites.size() == kMaxSites)
+            throw std::length_error("instrumentation: more than kMaxSites operations");
+        sites.push_back({type, operation});
+        exited.emplace_back();
+        return sites.size() - 1;
+    }
+
+    Snapshot snapshot();
+    void reset();
+};
+
+// This thread's counters, one per site, registered for as long as the thread runs
+class ThreadCounters
+{
+   private:
+    std::unique_ptr<Counters[]> counters;
+    std::size_t number;
+
+    friend class Registry;
+
+   public:
+    ThreadCounters() : counters(new Counters[kMaxSites])
+    {
+        Registry& registry = Registry::instance();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        number = registry.threadsSeen++;
+        registry.live.push_back(this);
+    }
+
+    ~ThreadCounters()
+    {
+        Registry& registry = Registry::instance();
+        std::lock_guard<std::mutex> guard(registry.lock);
+        for (std::size_t i = 0; i < registry.sites.size(); i++)
+            registry.exited[i].add(counters[i].read());
+        registry.live.erase(std::find(registry.live.begin(), registry.live.end(), this));
+    }
+
+    ThreadCounters(const ThreadCounters&) = delete;
+    ThreadCounters& operator=(const ThreadCounters&) = delete;
+
+    Counters& at(std::size_t site) { return counters[site]; }
+
+    static ThreadCounters& local()
+    {
+        // The plain pointer needs no per-access initialization check, unlike mine
+        thread_local ThreadCounters* cached = nullptr;
+        if (cached == nullptr)
+        {
+            thread_local ThreadCounters mine;
+            cached = &mine;
+        }
+        return *cached;
+    }
+};
+
+inline Snapshot Registry::snapshot()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    Snapshot result;
+    result.threadsSeen = threadsSeen;
+    for (std::size_t i = 0; i < sites.size(); i++)
+    {
+        OperationReport report;
+        report.type = sites[i].type;
+        report.operation = sites[i].operation;
+        report.exitedThreads = exited[i];
+        report.total = exited[i];
+        for (ThreadCounters* thread : live)
+        {
+            Totals t = thread->counters[i].read();
+            if (t.empty()) continue;
+            report.total.add(t);
+            report.threads.emplace_back(thread->number, t);
+        }
+        if (!report.total.empty()) result.operations.push_back(std::move(report));
+    }
+    return result;
+}
+
+inline void Registry::reset()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (Totals& t : exited) t = Totals();
+    for (ThreadCounters* thread : live)
+        for (std::size_t i = 0; i < sites.size(); i++) thread->counters[i].clear();
+}
+
+// Readable name of Type, e.g. "BinarySearchTree<AVLBalance>"
+template <typename Type>
+std::string typeName()
+{
+    const char* mangled = typeid(Type).name();
+#if defined(__GNUG__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+    if (status == 0 && demangled != nullptr)
+    {
+        std::string name(demangled);
+        std::free(demangled);
+        return name;
+    }
+#endif
+    return mangled;
+}
+
+template <typename Type>
+std::size_t addSite(const char* operation)
+{
+    return Registry::instance().addSite(typeName<Type>(), operation);
+}
+
+inline std::uint64_t readTicks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+#endif
+}
+
+class Operation;
+
+// Innermost operation running on this thread, where DS_STEP() counts
+inline Operation*& currentOperation()
+{
+    thread_local Operation* current = nullptr;
+    return current;
+}
+
+// Counts one call of a site, and the steps reported while it runs
+class Operation
+{
+   private:
+    Counters& counters;
+    Operation* outer;
+    std::uint64_t steps = 0;
+
+   public:
+    explicit Operation(std::size_t site)
+        : counters(ThreadCounters::local().at(site)), outer(currentOperation())
+    {
+        currentOperation() = this;
+    }
+
+    ~Operation()
+    {
+        currentOperation() = outer;
+        bump(counters.calls, 1);
+        if (steps == 0) return;
+        bump(counters.steps, steps);
+        if (steps > counters.maxSteps.load(std::memory_order_relaxed))
+            counters.maxSteps.store(steps, std::memory_order_relaxed);
+    }
+
+    Operation(const Operation&) = delete;
+    Operation& operator=(const Operation&) = delete;
+
+    void addSteps(std::uint64_t n) { steps += n; }
+    Counters& sink() { return counters; }
+};
+
+// Operation that also adds the ticks between construction and destruction
+class TimedOperation : public Operation
+{
+   private:
+    std::uint64_t start;
+
+   public:
+    explicit TimedOperation(std::size_t site) : Operation(site), start(readTicks()) {}
+
+    ~TimedOperation()
+    {
+        bump(sink().ticks, readTicks() - start);
+        bump(sink().timedCalls, 1);
+    }
+};
+
+inline void addSteps(std::uint64_t n)
+{
+    if (Operation* operation = currentOperation()) operation->addSteps(n);
+}
+
+inline void nodeAllocated(std::size_t site, std::uint64_t bytes)
+{
+    Counters& counters = ThreadCounters::local().at(site);
+    bump(counters.nodesAllocated, 1);
+    bump(counters.bytesAllocated, bytes);
+}
+
+inline void nodesFreed(std::size_t site, std::uint64_t count, std::uint64_t bytes)
+{
+    Counters& counters = ThreadCounters::local().at(site);
+    bump(counters.nodesFreed, count);
+    bump(counters.bytesFreed, bytes);
+}
+
+}  // namespace detail
+
+// Counters of every thread so far (empty when instrumentation is disabled)
+inline Snapshot snapshot()
+{
+    if (!kEnabled) return Snapshot();
+    return detail::Registry::instance().snapshot();
+}
+
+// Zeroes every counter; call it while no instrumented operation is running
+inline void reset()
+{
+    if (kEnabled) detail::Registry::instance().reset();
+}
+
+}  // namespace instrumentation
+
+#ifdef DS_INSTRUMENTATION
+#define DS_SITE_(name, Type, operation) \
+    static const std::size_t name = ::instrumentation::detail::addSite<Type>(operation)
+#define DS_OPERATION(Type, operation)             \
+    DS_SITE_(dsOperationSite_, Type, operation); \
+    ::instrumentation::detail::Operation dsOperation_(dsOperationSite_)
+#define DS_TIMED_OPERATION(Type, operation)       \
+    DS_SITE_(dsOperationSite_, Type, operation); \
+    ::instrumentation::detail::TimedOperation dsOperation_(dsOperationSite_)
+#define DS_STEPS(n) ::instrumentation::detail::addSteps(static_cast<std::uint64_t>(n))
+#define DS_NODE_ALLOCATED(Type, bytes)                                \
+    do                                                                \
+    {                                                                 \
+        DS_SITE_(dsNodeSite_, Type, "nodes");                         \
+        ::instrumentation::detail::nodeAllocated(dsNodeSite_, bytes); \
+    } while (0)
+#define DS_NODES_FREED(Type, count, bytes)                                 \
+    do                                                                    \
+    {                                                                     \
+        DS_SITE_(dsNodeSite_, Type, "nodes");                             \
+        ::instrumentation::detail::nodesFreed(dsNodeSite_, count, bytes); \
+    } while (0)
+#else
+#define DS_OPERATION(Type, operation) static_cast<void>(0)
+#define DS_TIMED_OPERATION(Type, operation) static_cast<void>(0)
+#define DS_STEPS(n) static_cast<void>(0)
+#define DS_NODE_ALLOCATED(Type, bytes) static_cast<void>(0)
+#define DS_NODES_FREED(Type, count, bytes) static_cast<void>(0)
+#endif
+#define DS_STEP() DS_STEPS(1)
+#define DS_NODE_FREED(Type, bytes) DS_NODES_FREED(Type, 1, bytes)
+
+#endif
@@ -1,98 +1,57 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-#include <climits>
+#include <chrono>
+#include <random>
+#include "simd_reductions.h"
+#include "solution.h"
 using namespace std;
 
-class Solution
+// Throughput of every kernel set this CPU supports, checked against the scalar loops
+void benchmarkKernels()
 {
-   public:
-    int largestElement(vector<int>& nums)
-    {
-        int largestElement = INT_MIN;
+    using namespace simd_reductions;
+    const size_t n = 1 << 23;  // 32 MB of ints
+    mt19937 rng(1);
+    vector<int> values(n), sorted(n);
+    for (int& x : values) x = static_cast<int>(rng());
+    for (size_t i = 0; i < n; i++) sorted[i] = static_cast<int>(i / 3);
+    vector<int> work;
 
-        for (int i = 0; i < nums.size(); i++)
-        {
-            if (largestElement < nums[i]) largestElement = nums[i];
-        }
-        return largestElement;
-    }
+    int expectedLargest = largestScalar(values.data(), n);
+    int expectedSecond = secondLargestScalar(values.data(), n);
+    work = sorted;
+    size_t expectedUnique = dedupScalar(work.data(), n);
+    vector<int> expectedPrefix(work.begin(), work.begin() + expectedUnique);
 
-   public:
-    int secondLargestElementBrute(vector<int>& nums)
+    Kernels all[8];
+    int count = availableKernels(all);
+    auto gbPerSecond = [n](chrono::steady_clock::time_point start)
     {
-        sort(nums.begin(), nums.end());
-        int largest = nums[nums.size() - 1];
-        for (int i = nums.size() - 2; i >= 0; i--)
-        {
-            if (nums[i] != largest) return nums[i];
-        }
-        return -1;
-    }
-
-    int secondLargestElementBetter(vector<int>& nums)
-    {
-        int largest = INT_MIN;
-        for (int i = 0; i < nums.size(); i++)
-        {
-            if (nums[i] > largest)
-            {
-                largest = nums[i];
-            }
-        }
-
-        int second_largest = INT_MIN;
-        for (int i = 0; i < nums.size(); i++)
-        {
-            if (nums[i] != largest && nums[i] > second_largest)
-            {
-                second_largest = nums[i];
-            }
-        }
-
-        // If second_largest was never updated, return -1
-        return (second_largest == INT_MIN) ? -1 : second_largest;
-    }
-
-    int secondLargestElementOptimal(vector<int>& nums)
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return n * sizeof(int) / seconds / 1e9;
+    };
+    for (int k = 0; k < count; k++)
     {
-        int largest = nums[0];
-        int second_largest = INT_MIN;
+        auto start = chrono::steady_clock::now();
+        bool ok = all[k].largest(values.data(), n) == expectedLargest;
+        double maxRate = gbPerSecond(start);
 
-        for (int i = 1; i < nums.size(); i++)
-        {
-            if (nums[i] > largest)
-            {
-                second_largest = largest;
-                largest = nums[i];
-            }
-            if (nums[i] < largest && nums[i] > second_largest)
-            {
-                second_largest = nums[i];
-            }
-        }
+        start = chrono::steady_clock::now();
+        ok = ok && all[k].secondLargest(values.data(), n) == expectedSecond;
+        double secondRate = gbPerSecond(start);
 
-        return (second_largest == INT_MIN ? -1 : second_largest);
-    }
+        work = sorted;
+        start = chrono::steady_clock::now();
+        size_t unique = all[k].dedup(work.data(), n);
+        double dedupRate = gbPerSecond(start);
+        ok = ok && unique == expectedUnique &&
+             equal(expectedPrefix.begin(), expectedPrefix.end(), work.begin());
 
-    // Leetcode 26
-   public:
-    int removeDuplicates(vector<int>& nums)
-    {
-        if (nums.size() == 0) return 0;
-
-        int i = 0;  // pointer for position of last unique element
-        for (int j = 1; j < nums.size(); j++)
-        {
-            if (nums[j] != nums[i])
-            {
-                i++;
-                nums[i] = nums[j];  // shift unique value forward
-            }
-        }
-        return i + 1;  // i is index, so +1 is the count
+        cout << all[k].name << ": max " << maxRate << " GB/s, second-max " << secondRate
+             << " GB/s, dedup " << dedupRate << " GB/s" << (ok ? "" : "  MISMATCH") << endl;
     }
-};
+}
 
 int main()
 {
@@ -105,5 +64,12 @@ int main()
     cout << sol.secondLargestElementOptimal(v) << endl;
     cout << sol.removeDuplicates(v) << endl;
 
+    vector<int> w = {4, 9, 9, 2, 9, 7};
+    cout << sol.largestElementSimd(w) << " " << sol.secondLargestElementSimd(w) << endl;
+    vector<int> d = {1, 1, 2, 3, 3, 3, 4};
+    cout << sol.removeDuplicatesSimd(d) << endl;
+
+    benchmarkKernels();
+
     return 0;
 }
\ No newline at end of file
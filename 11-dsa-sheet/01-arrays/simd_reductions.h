@@ -0,0 +1,388 @@
+#ifndef SIMD_REDUCTIONS_H
+#define SIMD_REDUCTIONS_H
+
+// Vectorized max, second-max and sorted-dedup kernels over int arrays.
+//
+// Every kernel returns exactly what the matching scalar loop in Solution
+// returns. On x86-64 the best of AVX-512 / AVX2 / SSE2 is picked at runtime
+// (GCC/Clang target attributes, no special compiler flags needed); on AArch64
+// the NEON kernels are used.
+
+#include <climits>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define SIMD_REDUCTIONS_X86 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SIMD_REDUCTIONS_NEON 1
+#endif
+
+namespace simd_reductions
+{
+
+// ---- Scalar building blocks, shared by every kernel for lane merging and tails ----
+
+// The update step of secondLargestElementOptimal: keeps the largest value
+// and the largest value strictly below it
+inline void top2Update(int x, int& largest, int& second)
+{
+    if (x > largest)
+    {
+        second = largest;
+        largest = x;
+    }
+    if (x < largest && x > second) second = x;
+}
+
+inline int largestScalar(const int* a, size_t n)
+{
+    int largest = INT_MIN;
+    for (size_t i = 0; i < n; i++)
+        if (largest < a[i]) largest = a[i];
+    return largest;
+}
+
+inline int secondLargestScalar(const int* a, size_t n)
+{
+    int largest = INT_MIN, second = INT_MIN;
+    for (size_t i = 0; i < n; i++) top2Update(a[i], largest, second);
+    return second == INT_MIN ? -1 : second;
+}
+
+// Compacts a[from, n) assuming a[0, write) already holds the unique prefix
+inline size_t dedupScalarFrom(int* a, size_t n, size_t from, size_t write)
+{
+    for (size_t j = from; j < n; j++)
+        if (a[j] != a[write - 1]) a[write++] = a[j];
+    return write;
+}
+
+inline size_t dedupScalar(int* a, size_t n)
+{
+    return n == 0 ? 0 : dedupScalarFrom(a, n, 1, 1);
+}
+
+// Feeds every lane's (largest, second) pair through the scalar update
+inline int mergeTop2Lanes(const int* largest, const int* second, int lanes, int tailLargest,
+                          int tailSecond)
+{
+    int best = tailLargest, next = tailSecond;
+    for (int l = 0; l < lanes; l++)
+    {
+        top2Update(largest[l], best, next);
+        top2Update(second[l], best, next);
+    }
+    return next == INT_MIN ? -1 : next;
+}
+
+#if defined(SIMD_REDUCTIONS_X86)
+
+// ---- SSE2 (baseline on x86-64; it has no 32-bit signed max, so blend by hand) ----
+
+inline __m128i select128(__m128i mask, __m128i a, __m128i b)  // mask ? a : b
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+inline __m128i max128(__m128i a, __m128i b)
+{
+    return select128(_mm_cmpgt_epi32(a, b), a, b);
+}
+
+inline int largestSse2(const int* a, size_t n)
+{
+    __m128i m0 = _mm_set1_epi32(INT_MIN), m1 = m0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        m0 = max128(m0, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i)));
+        m1 = max128(m1, _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i + 4)));
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), max128(m0, m1));
+    int largest = largestScalar(a + i, n - i);
+    for (int lane : lanes)
+        if (largest < lane) largest = lane;
+    return largest;
+}
+
+inline int secondLargestSse2(const int* a, size_t n)
+{
+    __m128i m1 = _mm_set1_epi32(INT_MIN), m2 = m1;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i above = _mm_cmpgt_epi32(x, m1);
+        __m128i below = _mm_cmpgt_epi32(m1, x);
+        m2 = select128(below, max128(m2, x), m2);
+        m2 = select128(above, m1, m2);
+        m1 = max128(m1, x);
+    }
+    alignas(16) int largest[4], second[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(largest), m1);
+    _mm_store_si128(reinterpret_cast<__m128i*>(second), m2);
+    int tailLargest = INT_MIN, tailSecond = INT_MIN;
+    for (; i < n; i++) top2Update(a[i], tailLargest, tailSecond);
+    return mergeTop2Lanes(largest, second, 4, tailLargest, tailSecond);
+}
+
+// SSE2 has no compress, so it only skips blocks that are entirely duplicates
+inline size_t dedupSse2(int* a, size_t n)
+{
+    if (n == 0) return 0;
+    size_t write = 1, i = 1;
+    for (; i + 4 <= n; i += 4)
+    {
+        __m128i cur = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+        __m128i prev = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i - 1));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(cur, prev)) == 0xFFFF) continue;
+        write = dedupScalarFrom(a, i + 4, i, write);
+    }
+    return dedupScalarFrom(a, n, i, write);
+}
+
+// ---- AVX2 ----
+
+__attribute__((target("avx2"))) inline int largestAvx2(const int* a, size_t n)
+{
+    __m256i m0 = _mm256_set1_epi32(INT_MIN), m1 = m0;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        m0 = _mm256_max_epi32(m0, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i)));
+        m1 = _mm256_max_epi32(m1,
+                              _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i + 8)));
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_max_epi32(m0, m1));
+    int largest = largestScalar(a + i, n - i);
+    for (int lane : lanes)
+        if (largest < lane) largest = lane;
+    return largest;
+}
+
+__attribute__((target("avx2"))) inline int secondLargestAvx2(const int* a, size_t n)
+{
+    __m256i m1 = _mm256_set1_epi32(INT_MIN), m2 = m1;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i above = _mm256_cmpgt_epi32(x, m1);
+        __m256i below = _mm256_cmpgt_epi32(m1, x);
+        m2 = _mm256_blendv_epi8(m2, _mm256_max_epi32(m2, x), below);
+        m2 = _mm256_blendv_epi8(m2, m1, above);
+        m1 = _mm256_max_epi32(m1, x);
+    }
+    alignas(32) int largest[8], second[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(largest), m1);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(second), m2);
+    int tailLargest = INT_MIN, tailSecond = INT_MIN;
+    for (; i < n; i++) top2Update(a[i], tailLargest, tailSecond);
+    return mergeTop2Lanes(largest, second, 8, tailLargest, tailSecond);
+}
+
+// For every 8-bit "keep" mask, the lane indices of the kept lanes packed to the front
+struct CompressTable
+{
+    alignas(32) int lanes[256][8];
+
+    CompressTable()
+    {
+        for (int mask = 0; mask < 256; mask++)
+        {
+            int out = 0;
+            for (int lane = 0; lane < 8; lane++)
+                if (mask & (1 << lane)) lanes[mask][out++] = lane;
+            while (out < 8) lanes[mask][out++] = 0;
+        }
+    }
+};
+
+// Compress emulated with a permute from the table plus a masked store, so only
+// the kept lanes are written (the tail past the result matches the scalar loop)
+__attribute__((target("avx2,popcnt"))) inline size_t dedupAvx2(int* a, size_t n)
+{
+    static const CompressTable table;
+    if (n == 0) return 0;
+    const __m256i laneIndex = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    size_t write = 1, i = 1;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i cur = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i prev = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i - 1));
+        int same = _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(cur, prev)));
+        int keep = ~same & 0xFF;
+        if (keep == 0) continue;
+        __m256i order = _mm256_load_si256(reinterpret_cast<const __m256i*>(table.lanes[keep]));
+        __m256i packed = _mm256_permutevar8x32_epi32(cur, order);
+        int count = __builtin_popcount(keep);
+        __m256i storeMask = _mm256_cmpgt_epi32(_mm256_set1_epi32(count), laneIndex);
+        _mm256_maskstore_epi32(a + write, storeMask, packed);
+        write += count;
+    }
+    return dedupScalarFrom(a, n, i, write);
+}
+
+// ---- AVX-512 ----
+
+// GCC 12's avx512fintrin.h builds _mm512_set1_epi32 and _mm512_reduce_max_epi32 from a
+// deliberately undefined vector and then warns that it is uninitialized (a false positive)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#ifndef __clang__
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+__attribute__((target("avx512f"))) inline int largestAvx512(const int* a, size_t n)
+{
+    __m512i m0 = _mm512_set1_epi32(INT_MIN), m1 = m0;
+    size_t i = 0;
+    for (; i + 32 <= n; i += 32)
+    {
+        m0 = _mm512_max_epi32(m0, _mm512_loadu_si512(a + i));
+        m1 = _mm512_max_epi32(m1, _mm512_loadu_si512(a + i + 16));
+    }
+    int largest = _mm512_reduce_max_epi32(_mm512_max_epi32(m0, m1));
+    int tail = largestScalar(a + i, n - i);
+    return largest < tail ? tail : largest;
+}
+
+__attribute__((target("avx512f"))) inline int secondLargestAvx512(const int* a, size_t n)
+{
+    __m512i m1 = _mm512_set1_epi32(INT_MIN), m2 = m1;
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512i x = _mm512_loadu_si512(a + i);
+        __mmask16 above = _mm512_cmpgt_epi32_mask(x, m1);
+        __mmask16 below = _mm512_cmplt_epi32_mask(x, m1);
+        m2 = _mm512_mask_max_epi32(m2, below, m2, x);
+        m2 = _mm512_mask_mov_epi32(m2, above, m1);
+        m1 = _mm512_max_epi32(m1, x);
+    }
+    alignas(64) int largest[16], second[16];
+    _mm512_store_si512(largest, m1);
+    _mm512_store_si512(second, m2);
+    int tailLargest = INT_MIN, tailSecond = INT_MIN;
+    for (; i < n; i++) top2Update(a[i], tailLargest, tailSecond);
+    return mergeTop2Lanes(largest, second, 16, tailLargest, tailSecond);
+}
+
+#pragma GCC diagnostic pop
+
+__attribute__((target("avx512f,popcnt"))) inline size_t dedupAvx512(int* a, size_t n)
+{
+    if (n == 0) return 0;
+    size_t write = 1, i = 1;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512i cur = _mm512_loadu_si512(a + i);
+        __m512i prev = _mm512_loadu_si512(a + i - 1);
+        __mmask16 keep = _mm512_cmpneq_epi32_mask(cur, prev);
+        _mm512_mask_compressstoreu_epi32(a + write, keep, cur);
+        write += __builtin_popcount(keep);
+    }
+    return dedupScalarFrom(a, n, i, write);
+}
+
+#elif defined(SIMD_REDUCTIONS_NEON)
+
+// ---- NEON ----
+
+inline int largestNeon(const int* a, size_t n)
+{
+    int32x4_t m0 = vdupq_n_s32(INT_MIN), m1 = m0;
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        m0 = vmaxq_s32(m0, vld1q_s32(a + i));
+        m1 = vmaxq_s32(m1, vld1q_s32(a + i + 4));
+    }
+    int largest = vmaxvq_s32(vmaxq_s32(m0, m1));
+    int tail = largestScalar(a + i, n - i);
+    return largest < tail ? tail : largest;
+}
+
+inline int secondLargestNeon(const int* a, size_t n)
+{
+    int32x4_t m1 = vdupq_n_s32(INT_MIN), m2 = m1;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        int32x4_t x = vld1q_s32(a + i);
+        uint32x4_t above = vcgtq_s32(x, m1);
+        uint32x4_t below = vcltq_s32(x, m1);
+        m2 = vbslq_s32(below, vmaxq_s32(m2, x), m2);
+        m2 = vbslq_s32(above, m1, m2);
+        m1 = vmaxq_s32(m1, x);
+    }
+    int largest[4], second[4];
+    vst1q_s32(largest, m1);
+    vst1q_s32(second, m2);
+    int tailLargest = INT_MIN, tailSecond = INT_MIN;
+    for (; i < n; i++) top2Update(a[i], tailLargest, tailSecond);
+    return mergeTop2Lanes(largest, second, 4, tailLargest, tailSecond);
+}
+
+// Skips blocks that are entirely duplicates, compacts the rest with scalar code
+inline size_t dedupNeon(int* a, size_t n)
+{
+    if (n == 0) return 0;
+    size_t write = 1, i = 1;
+    for (; i + 4 <= n; i += 4)
+    {
+        uint32x4_t same = vceqq_s32(vld1q_s32(a + i), vld1q_s32(a + i - 1));
+        if (vminvq_u32(same) == 0xFFFFFFFFu) continue;
+        write = dedupScalarFrom(a, i + 4, i, write);
+    }
+    return dedupScalarFrom(a, n, i, write);
+}
+
+#endif
+
+// ---- Runtime dispatch ----
+
+struct Kernels
+{
+    const char* name;
+    int (*largest)(const int*, size_t);
+    int (*secondLargest)(const int*, size_t);
+    size_t (*dedup)(int*, size_t);
+};
+
+// Every kernel set this build and this CPU can run, slowest (scalar) first
+inline int availableKernels(Kernels* out)
+{
+    int count = 0;
+    out[count++] = {"scalar", largestScalar, secondLargestScalar, dedupScalar};
+#if defined(SIMD_REDUCTIONS_X86)
+    out[count++] = {"sse2", largestSse2, secondLargestSse2, dedupSse2};
+    if (__builtin_cpu_supports("avx2"))
+        out[count++] = {"avx2", largestAvx2, secondLargestAvx2, dedupAvx2};
+    if (__builtin_cpu_supports("avx512f"))
+        out[count++] = {"avx512", largestAvx512, secondLargestAvx512, dedupAvx512};
+#elif defined(SIMD_REDUCTIONS_NEON)
+    out[count++] = {"neon", largestNeon, secondLargestNeon, dedupNeon};
+#endif
+    return count;
+}
+
+// Fastest kernel set for this CPU, detected once
+inline const Kernels& bestKernels()
+{
+    static const Kernels best = []
+    {
+        Kernels all[8];
+        int count = availableKernels(all);
+        return all[count - 1];
+    }();
+    return best;
+}
+
+}  // namespace simd_reductions
+
+#endif
@@ -0,0 +1,117 @@
+#ifndef SOLUTION_H
+#define SOLUTION_H
+
+#include <climits>
+#include <vector>
+#include "simd_reductions.h"
+#include "../../09-STL/integer-sort.h"
+
+class Solution
+{
+   public:
+    int largestElement(std::vector<int>& nums)
+    {
+        int largestElement = INT_MIN;
+
+        for (size_t i = 0; i < nums.size(); i++)
+        {
+            if (largestElement < nums[i]) largestElement = nums[i];
+        }
+        return largestElement;
+    }
+
+   public:
+    // Sorts with the radix / parallel backend instead of std::sort
+    int secondLargestElementBrute(std::vector<int>& nums)
+    {
+        integer_sort::sortIntegers(nums);
+        int largest = nums[nums.size() - 1];
+        for (int i = nums.size() - 2; i >= 0; i--)
+        {
+            if (nums[i] != largest) return nums[i];
+        }
+        return -1;
+    }
+
+    int secondLargestElementBetter(std::vector<int>& nums)
+    {
+        int largest = INT_MIN;
+        for (size_t i = 0; i < nums.size(); i++)
+        {
+            if (nums[i] > largest)
+            {
+                largest = nums[i];
+            }
+        }
+
+        int second_largest = INT_MIN;
+        for (size_t i = 0; i < nums.size(); i++)
+        {
+            if (nums[i] != largest && nums[i] > second_largest)
+            {
+                second_largest = nums[i];
+            }
+        }
+
+        // If second_largest was never updated, return -1
+        return (second_largest == INT_MIN) ? -1 : second_largest;
+    }
+
+    int secondLargestElementOptimal(std::vector<int>& nums)
+    {
+        int largest = nums[0];
+        int second_largest = INT_MIN;
+
+        for (size_t i = 1; i < nums.size(); i++)
+        {
+            if (nums[i] > largest)
+            {
+                second_largest = largest;
+                largest = nums[i];
+            }
+            if (nums[i] < largest && nums[i] > second_largest)
+            {
+                second_largest = nums[i];
+            }
+        }
+
+        return (second_largest == INT_MIN ? -1 : second_largest);
+    }
+
+    // Leetcode 26
+   public:
+    int removeDuplicates(std::vector<int>& nums)
+    {
+        if (nums.size() == 0) return 0;
+
+        int i = 0;  // pointer for position of last unique element
+        for (size_t j = 1; j < nums.size(); j++)
+        {
+            if (nums[j] != nums[i])
+            {
+                i++;
+                nums[i] = nums[j];  // shift unique value forward
+            }
+        }
+        return i + 1;  // i is index, so +1 is the count
+    }
+
+    // Vectorized versions, same results as the loops above (kernel picked for this CPU)
+   public:
+    int largestElementSimd(const std::vector<int>& nums)
+    {
+        return simd_reductions::bestKernels().largest(nums.data(), nums.size());
+    }
+
+    int secondLargestElementSimd(const std::vector<int>& nums)
+    {
+        return simd_reductions::bestKernels().secondLargest(nums.data(), nums.size());
+    }
+
+    int removeDuplicatesSimd(std::vector<int>& nums)
+    {
+        return static_cast<int>(simd_reductions::bestKernels().dedup(nums.data(), nums.size()));
+    }
+};
+
+#endif
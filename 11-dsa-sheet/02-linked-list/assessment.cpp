@@ -1,5 +1,9 @@
 #include <iostream>
 #include <cstring>
+#include <chrono>
+#include <string>
+#include "../../02-strings/string-builder.h"
+#include "../../02-strings/string-kernels.h"
 
 // Q1: Reference variable usage
 void q1()
@@ -85,6 +89,32 @@ char* q7(char* str, int len)
     return str;
 }
 
+// Q7 swaps one pair of chars per step; string_kernels::reverse swaps 16 or 32 byte blocks from
+// both ends, reversing each block with byte shuffles
+void benchmark_q7()
+{
+    std::string text(1 << 24, ' ');
+    for (size_t i = 0; i < text.size(); i++) text[i] = static_cast<char>('a' + i * 7 % 26);
+    std::string expected = text, fast = text;
+    auto ms_since = [](std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    q7(&expected[0], expected.size());
+    double q7_ms = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    string_kernels::reverse(&fast[0], fast.size());
+    double kernel_ms = ms_since(start);
+
+    std::cout << "Q7 reversing 16 MB: " << q7_ms << " ms, string_kernels::reverse ("
+              << string_kernels::bestKernels().name << ") " << kernel_ms
+              << " ms (same: " << (expected == fast) << ")" << std::endl;
+}
+
 // Q8: Create and print a dynamic 2D array
 void q8()
 {
@@ -134,14 +164,47 @@ char* q10(const char* source, const char* dest)
     int len2 = strlen(dest);
     char* newArray = new char[len1 + len2 + 1];  // +1 for '\0'
 
-    int i = 0;
-    while (*source) newArray[i++] = *source++;
-    while (*dest) newArray[i++] = *dest++;
-    newArray[i] = '\0';
+    // Both lengths are known, so copy each part in one block instead of a char per iteration
+    std::memcpy(newArray, source, len1);
+    std::memcpy(newArray + len1, dest, len2);
+    newArray[len1 + len2] = '\0';
 
     return newArray;
 }
 
+// Building one string from many pieces with q10 copies everything built so far on every step
+// (quadratic); StringBuilder appends into one buffer that doubles when full (linear)
+void benchmark_q10()
+{
+    const int pieces = 20000;
+    const char* piece = "row-17;";
+    auto ms_since = [](std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    char* chained = q10("", "");
+    for (int i = 0; i < pieces; i++)
+    {
+        char* longer = q10(chained, piece);
+        delete[] chained;
+        chained = longer;
+    }
+    double q10_ms = ms_since(start);
+
+    start = std::chrono::steady_clock::now();
+    StringBuilder sb;
+    for (int i = 0; i < pieces; i++) sb.append(piece);
+    double builder_ms = ms_since(start);
+
+    std::cout << "Q10 chained " << pieces << " times: " << q10_ms << " ms, StringBuilder "
+              << builder_ms << " ms (same: " << (std::strcmp(chained, sb.c_str()) == 0) << ")"
+              << std::endl;
+    delete[] chained;
+}
+
 int main()
 {
     q1();  // Reference test
@@ -158,6 +221,8 @@ int main()
     char str7[] = "hello";
     std::cout << "Q7 Output (Reversed): " << q7(str7, strlen(str7)) << std::endl;
 
+    benchmark_q7();
+
     q8();  // Dynamic 2D array
 
     int x = 10, y = 20;
@@ -168,5 +233,7 @@ int main()
     std::cout << "Q10 Output (Concatenated): " << result << std::endl;
     delete[] result;  // free memory
 
+    benchmark_q10();
+
     return 0;
 }
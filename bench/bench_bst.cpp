@@ -0,0 +1,171 @@
+// BinarySearchTree, AVLTree and FrozenBST (10-data-structures/05-trees)
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "harness.h"
+#include "../10-data-structures/05-trees/binary-search-tree.h"
+
+namespace
+{
+
+const std::vector<std::size_t> kSizes = {1000, 100000, 1000000};
+const std::size_t kQueries = 100000;
+const std::uint64_t kSeed = 17;
+
+template <typename Tree>
+std::unique_ptr<Tree> makeTree(const std::vector<int>& keys)
+{
+    auto tree = std::make_unique<Tree>();
+    for (int key : keys) tree->insert(key);
+    return tree;
+}
+
+template <typename Tree>
+std::shared_ptr<Tree> sharedTree(const std::vector<int>& keys)
+{
+    return makeTree<Tree>(keys);
+}
+
+/*
+ * Random keys are the usual case for a plain BST; ascending keys (ids, times)
+ * are its worst case, one level per key, which is why the plain sizes stop
+ * at 10000.
+ */
+template <typename Tree>
+void registerBuild(const std::string& name, const std::vector<std::size_t>& sortedSizes)
+{
+    bench::add(name + "/insert_random", kSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto keys = bench::distinctKeys(state.size(), kSeed);
+                   state.resumeTiming();
+                   auto tree = makeTree<Tree>(keys);
+                   bench::keep(tree->height());
+                   state.pauseTiming();
+               });
+    bench::add(name + "/insert_ascending", sortedSizes,
+               [](bench::State& state)
+               {
+                   auto tree = std::make_unique<Tree>();
+                   for (std::size_t i = 0; i < state.size(); i++)
+                       tree->insert(static_cast<int>(i));
+                   bench::keep(tree->height());
+                   state.pauseTiming();
+               });
+    bench::add(name + "/erase_random", kSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto keys = bench::distinctKeys(state.size(), kSeed);
+                   auto tree = makeTree<Tree>(keys);
+                   auto order = bench::distinctKeys(state.size(), kSeed + 1);
+                   for (std::size_t i = 0; i < keys.size(); i++)
+                       std::swap(keys[i], keys[static_cast<std::size_t>(order[i]) % (i + 1)]);
+                   state.resumeTiming();
+                   for (int key : keys) tree->erase(key);
+                   bench::keep(tree->height());
+               });
+}
+
+/*
+ * kQueries lookups against a tree of size() random keys: hits spread
+ * uniformly over the keys, hits that follow a Zipf(0.99) popularity (a few
+ * hot keys take most queries, as in a cache or a symbol table), and misses.
+ */
+struct Queries
+{
+    std::vector<int> uniform, zipf, misses;
+
+    Queries(const std::vector<int>& keys)
+    {
+        for (std::size_t i : bench::uniformIndices(kQueries, keys.size(), kSeed + 2))
+            uniform.push_back(keys[i]);
+        for (std::size_t i : bench::zipfIndices(kQueries, keys.size(), 0.99, kSeed + 3))
+            zipf.push_back(keys[i]);
+        // Keys number seed + n onward are distinct from the first n
+        misses = bench::distinctKeys(kQueries, kSeed + keys.size());
+    }
+};
+
+template <typename Index>
+void registerLookups(const std::string& name, Index build)
+{
+    auto lookups = [build](std::vector<int> Queries::*pattern)
+    {
+        return [build, pattern](std::size_t n)
+        {
+            auto keys = bench::distinctKeys(n, kSeed);
+            auto queries = std::make_shared<Queries>(keys);
+            auto index = build(keys);
+            return [index, queries, pattern](bench::State& state)
+            {
+                std::size_t found = 0;
+                for (int key : (*queries).*pattern) found += index->contains(key);
+                bench::keep(found);
+                state.setItems(kQueries);
+            };
+        };
+    };
+    bench::addFixture(name + "/contains_uniform_hits", kSizes, lookups(&Queries::uniform));
+    bench::addFixture(name + "/contains_zipf_hits", kSizes, lookups(&Queries::zipf));
+    bench::addFixture(name + "/contains_misses", kSizes, lookups(&Queries::misses));
+}
+
+// Full in-order walks, and range queries that each report about 100 keys
+void registerScans()
+{
+    bench::addFixture("AVLTree/in_order_traversal", kSizes,
+                      [](std::size_t n)
+                      {
+                          std::shared_ptr<AVLTree> tree =
+                              makeTree<AVLTree>(bench::distinctKeys(n, kSeed));
+                          return [tree](bench::State&)
+                          {
+                              long long sum = 0;
+                              for (const TreeNode& node : tree->inOrder()) sum += node.data;
+                              bench::keep(sum);
+                          };
+                      });
+    bench::addFixture(
+        "AVLTree/range_about_100_keys", kSizes,
+        [](std::size_t n)
+        {
+            std::shared_ptr<AVLTree> tree = makeTree<AVLTree>(bench::distinctKeys(n, kSeed));
+            // Keys are spread over [0, 2^31), so a span of 100 * 2^31 / n holds about 100
+            long long span = 100 * (2147483648LL / static_cast<long long>(n));
+            auto starts =
+                std::make_shared<std::vector<int>>(bench::distinctKeys(1000, kSeed + 4));
+            return [tree, starts, span](bench::State& state)
+            {
+                std::size_t reported = 0;
+                for (int lo : *starts)
+                {
+                    long long hi = std::min<long long>(lo + span, 2147483647LL);
+                    tree->range(lo, static_cast<int>(hi), [&reported](int) { reported++; });
+                }
+                state.setItems(reported);
+            };
+        });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    registerBuild<BinarySearchTree<>>("BinarySearchTree", {1000, 10000});
+    registerBuild<AVLTree>("AVLTree", kSizes);
+    registerLookups("BinarySearchTree", sharedTree<BinarySearchTree<>>);
+    registerLookups("AVLTree", sharedTree<AVLTree>);
+    registerLookups("FrozenBST",
+                    [](const std::vector<int>& keys)
+                    {
+                        std::vector<int> sorted = keys;
+                        std::sort(sorted.begin(), sorted.end());
+                        return std::make_shared<FrozenBST>(sorted);
+                    });
+    registerScans();
+    return bench::run(argc, argv, "bst");
+}
@@ -0,0 +1,284 @@
+// LinkedList, DoublyLinkedList and UnrolledLinkedList (10-data-structures/02-linked-list)
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+#include "harness.h"
+#include "../10-data-structures/02-linked-list/02-linked-list-header-file.h"
+#include "../10-data-structures/02-linked-list/03-unrolled-linked-list-header-file.h"
+
+namespace
+{
+
+const std::vector<std::size_t> kBuildSizes = {1000, 100000, 1000000};
+const std::vector<std::size_t> kListSizes = {1000, 10000, 100000};
+const std::size_t kInserts = 1000;
+
+long long sum(LinkedList& list)
+{
+    long long total = 0;
+    for (Node* node = list.getHead(); node; node = node->next) total += node->value;
+    return total;
+}
+
+long long sum(DoublyLinkedList& list)
+{
+    long long total = 0;
+    for (DNode* node = list.getHead(); node; node = node->next) total += node->value;
+    return total;
+}
+
+template <std::size_t NodeBytes>
+long long sum(UnrolledLinkedList<NodeBytes>& list)
+{
+    long long total = 0;
+    list.forEach([&total](int value) { total += value; });
+    return total;
+}
+
+// The list 0, 1, ..., n - 1
+template <typename List>
+std::unique_ptr<List> makeList(std::size_t n)
+{
+    auto list = std::make_unique<List>(0);
+    for (std::size_t i = 1; i < n; i++) list->append(static_cast<int>(i));
+    return list;
+}
+
+// Builds a list of n values; destroying it is not measured
+template <typename List>
+void registerBuild(const std::string& name)
+{
+    bench::add(name + "/append", kBuildSizes,
+               [](bench::State& state)
+               {
+                   auto list = makeList<List>(state.size());
+                   bench::keep(list->getLength());
+                   state.pauseTiming();
+               });
+    bench::add(name + "/prepend", kBuildSizes,
+               [](bench::State& state)
+               {
+                   auto list = std::make_unique<List>(0);
+                   for (std::size_t i = 1; i < state.size(); i++)
+                       list->prepend(static_cast<int>(i));
+                   bench::keep(list->getLength());
+                   state.pauseTiming();
+               });
+}
+
+/*
+ * Index-based edits on a list of size(): kInserts inserts at uniformly random
+ * indices (every one walks to its position), and kInserts inserts that move
+ * forward through the list a few nodes at a time, as an editor or a merge
+ * does (the cursor makes each walk short).
+ */
+template <typename List>
+void registerEdits(const std::string& name)
+{
+    bench::add(name + "/insert_random_index", kListSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto list = makeList<List>(state.size());
+                   auto positions = bench::uniformIndices(kInserts, state.size(), 7);
+                   state.resumeTiming();
+                   for (std::size_t p : positions) list->insert(-1, static_cast<int>(p));
+                   state.pauseTiming();
+                   state.setItems(kInserts);
+               });
+    bench::add(name + "/insert_moving_forward", kListSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto list = makeList<List>(state.size());
+                   std::size_t step = state.size() / kInserts;  // Sizes are at least kInserts
+                   state.resumeTiming();
+                   for (std::size_t i = 0; i < kInserts; i++)
+                       list->insert(-1, static_cast<int>(i * (step + 1)));
+                   state.pauseTiming();
+                   state.setItems(kInserts);
+               });
+    bench::add(name + "/delete_random_index", kListSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto list = makeList<List>(state.size() + kInserts);
+                   auto positions = bench::uniformIndices(kInserts, state.size(), 8);
+                   state.resumeTiming();
+                   for (std::size_t p : positions) list->deletePosition(static_cast<int>(p));
+                   state.pauseTiming();
+                   state.setItems(kInserts);
+               });
+}
+
+// Full traversals of one list built once per size
+template <typename List>
+void registerTraversal(const std::string& name)
+{
+    bench::addFixture(name + "/traverse", kBuildSizes,
+                      [](std::size_t n)
+                      {
+                          std::shared_ptr<List> list = makeList<List>(n);
+                          return [list](bench::State&) { bench::keep(sum(*list)); };
+                      });
+}
+
+/*
+ * Traversal after the nodes were allocated one by one from the general heap
+ * between other allocations, so consecutive nodes are not neighbours in
+ * memory (a long-lived list in a busy program), against the pooled default.
+ */
+void registerScatteredTraversal()
+{
+    bench::addFixture(
+        "LinkedList/traverse_heap_scattered", kBuildSizes,
+        [](std::size_t n)
+        {
+            auto heap = std::make_shared<HeapNodeAllocator>();
+            std::shared_ptr<LinkedList> list(new LinkedList(0, heap.get()),
+                                             [heap](LinkedList* l) { delete l; });
+            auto sizes = bench::uniformIndices(n, 512, 9);
+            std::vector<std::unique_ptr<char[]>> noise;
+            for (std::size_t i = 1; i < n; i++)
+            {
+                noise.emplace_back(new char[16 + sizes[i]]);
+                list->append(static_cast<int>(i));
+            }
+            return [list](bench::State&) { bench::keep(sum(*list)); };
+        });
+}
+
+void registerReverse()
+{
+    bench::addFixture("LinkedList/reverse", kBuildSizes,
+                      [](std::size_t n)
+                      {
+                          std::shared_ptr<LinkedList> list = makeList<LinkedList>(n);
+                          return [list](bench::State&) { list->reverseLinkedList(); };
+                      });
+    bench::add("DoublyLinkedList/delete_last_until_empty", kBuildSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto list = makeList<DoublyLinkedList>(state.size());
+                   state.resumeTiming();
+                   while (list->getLength() > 1) list->deleteLast();
+                   state.pauseTiming();
+               });
+}
+
+// A list of size() random values, rebuilt (untimed) before every run
+std::unique_ptr<LinkedList> makeShuffledList(std::size_t n)
+{
+    std::vector<int> keys = bench::distinctKeys(n, 10);
+    auto list = std::make_unique<LinkedList>(keys[0]);
+    for (std::size_t i = 1; i < n; i++) list->append(keys[i]);
+    return list;
+}
+
+/*
+ * LinkedList::sort relinks the nodes in place, against the copy it replaces:
+ * values out into a vector, std::sort, and written back node by node.
+ */
+void registerSort()
+{
+    bench::add("LinkedList/sort", kBuildSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto list = makeShuffledList(state.size());
+                   state.resumeTiming();
+                   list->sort();
+                   state.pauseTiming();
+               });
+    bench::add("LinkedList/sort_via_vector", kBuildSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto list = makeShuffledList(state.size());
+                   state.resumeTiming();
+                   std::vector<int> values;
+                   values.reserve(list->getLength());
+                   for (Node* node = list->getHead(); node; node = node->next)
+                       values.push_back(node->value);
+                   std::sort(values.begin(), values.end());
+                   Node* node = list->getHead();
+                   for (int value : values) node->value = value, node = node->next;
+                   state.pauseTiming();
+               });
+}
+
+/*
+ * splitAt at the middle of a fresh list of size() nodes, so it walks n/2
+ * nodes from the head (items are those nodes), and concat moving the whole
+ * list back and forth between two lists. Both lists share one pool and rest
+ * starts empty. splitAt gets freshly built lists every run, so no cursor is
+ * left over from the previous run.
+ */
+struct SplitLists
+{
+    std::unique_ptr<NodePool> pool = std::make_unique<NodePool>();
+    std::unique_ptr<LinkedList> list;
+    std::unique_ptr<LinkedList> rest;
+
+    explicit SplitLists(std::size_t n)
+        : list(std::make_unique<LinkedList>(0, pool.get())),
+          rest(std::make_unique<LinkedList>(0, pool.get()))
+    {
+        rest->deleteFirst();  // The constructor's node; rest is now empty
+        for (std::size_t i = 1; i < n; i++) list->append(static_cast<int>(i));
+    }
+};
+
+void registerSplice()
+{
+    bench::add("LinkedList/split_at_middle", kBuildSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   auto lists = std::make_unique<SplitLists>(state.size());
+                   state.resumeTiming();
+                   lists->list->splitAt(static_cast<int>(state.size() / 2), *lists->rest);
+                   state.pauseTiming();
+                   bench::keep(lists->rest->getLength());
+                   state.setItems(state.size() / 2);
+               });
+    bench::addFixture("LinkedList/concat_back_and_forth", kBuildSizes,
+                      [](std::size_t n)
+                      {
+                          std::shared_ptr<SplitLists> lists = std::make_shared<SplitLists>(n);
+                          return [lists](bench::State& state)
+                          {
+                              // Each concat moves all n nodes; neither walks the list
+                              for (std::size_t i = 0; i < kInserts; i++)
+                              {
+                                  lists->rest->concat(*lists->list);
+                                  lists->list->concat(*lists->rest);
+                              }
+                              state.setItems(2 * kInserts);
+                          };
+                      });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    registerBuild<LinkedList>("LinkedList");
+    registerBuild<DoublyLinkedList>("DoublyLinkedList");
+    registerBuild<UnrolledLinkedList<64>>("UnrolledLinkedList<64>");
+    registerEdits<LinkedList>("LinkedList");
+    registerEdits<DoublyLinkedList>("DoublyLinkedList");
+    registerEdits<UnrolledLinkedList<64>>("UnrolledLinkedList<64>");
+    registerTraversal<LinkedList>("LinkedList");
+    registerTraversal<DoublyLinkedList>("DoublyLinkedList");
+    registerTraversal<UnrolledLinkedList<64>>("UnrolledLinkedList<64>");
+    registerTraversal<UnrolledLinkedList<256>>("UnrolledLinkedList<256>");
+    registerScatteredTraversal();
+    registerReverse();
+    registerSort();
+    registerSplice();
+    return bench::run(argc, argv, "linked_list");
+}
@@ -0,0 +1,119 @@
+// Phonebook over each store (09-STL/phonebook-stores.h, phonebook-cache.h)
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "harness.h"
+#include "../09-STL/phonebook-stores.h"
+#include "../09-STL/phonebook-cache.h"
+#include "../09-STL/phonebook.h"
+
+namespace
+{
+
+const std::vector<std::size_t> kSizes = {1000, 100000, 1000000};
+const std::size_t kQueries = 100000;
+const std::uint64_t kSeed = 29;
+
+using Contacts = std::vector<std::pair<std::string, std::string>>;
+
+// Names look like "CONTACT-1234567" and share long prefixes, like real surnames
+std::string nameOf(int key) { return "CONTACT-" + std::to_string(key); }
+
+Contacts makeContacts(std::size_t n)
+{
+    Contacts contacts;
+    contacts.reserve(n);
+    for (int key : bench::distinctKeys(n, kSeed))
+        contacts.emplace_back(nameOf(key), "9" + std::to_string(key % 1000000000));
+    return contacts;
+}
+
+/*
+ * Hits spread uniformly over the book, hits that follow a Zipf(0.99)
+ * popularity (a few contacts take most calls), and names not in the book.
+ */
+struct Queries
+{
+    std::vector<std::string> uniform, zipf, misses;
+
+    explicit Queries(const Contacts& contacts)
+    {
+        for (std::size_t i : bench::uniformIndices(kQueries, contacts.size(), kSeed + 1))
+            uniform.push_back(contacts[i].first);
+        for (std::size_t i : bench::zipfIndices(kQueries, contacts.size(), 0.99, kSeed + 2))
+            zipf.push_back(contacts[i].first);
+        // Keys number seed + n onward are distinct from the first n
+        for (int key : bench::distinctKeys(kQueries, kSeed + contacts.size()))
+            misses.push_back(nameOf(key));
+    }
+};
+
+template <typename Store>
+void registerStore(const std::string& name)
+{
+    bench::add(name + "/load", kSizes,
+               [](bench::State& state)
+               {
+                   state.pauseTiming();
+                   Contacts contacts = makeContacts(state.size());
+                   auto book = std::make_unique<Phonebook<Store>>();
+                   state.resumeTiming();
+                   book->load(contacts);
+                   bench::keep(book->store().size());
+                   state.pauseTiming();
+               });
+    auto lookups = [](std::vector<std::string> Queries::*pattern)
+    {
+        return [pattern](std::size_t n)
+        {
+            Contacts contacts = makeContacts(n);
+            auto queries = std::make_shared<Queries>(contacts);
+            auto book = std::make_shared<Phonebook<Store>>();
+            book->load(contacts);
+            return [book, queries, pattern](bench::State& state)
+            {
+                std::size_t found = 0;
+                for (const std::string& query : (*queries).*pattern)
+                    found += book->find(query).has_value();
+                bench::keep(found);
+                state.setItems(kQueries);
+            };
+        };
+    };
+    bench::addFixture(name + "/find_uniform_hits", kSizes, lookups(&Queries::uniform));
+    bench::addFixture(name + "/find_zipf_hits", kSizes, lookups(&Queries::zipf));
+    bench::addFixture(name + "/find_misses", kSizes, lookups(&Queries::misses));
+}
+
+// The 900 prefixes "CONTACT-100" to "CONTACT-999", which together cover most of the book
+void registerPrefixSearch()
+{
+    bench::addFixture("SortedPhoneStore/prefix_search", kSizes,
+                      [](std::size_t n)
+                      {
+                          auto book = std::make_shared<Phonebook<SortedPhoneStore>>();
+                          book->load(makeContacts(n));
+                          return [book](bench::State& state)
+                          {
+                              std::size_t reported = 0;
+                              for (int p = 100; p < 1000; p++)
+                                  reported += book->store().forEachWithPrefix(
+                                      nameOf(p), [](std::string_view, std::string_view) {});
+                              state.setItems(reported);
+                          };
+                      });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    registerStore<MapPhoneStore>("MapPhoneStore");
+    registerStore<SortedPhoneStore>("SortedPhoneStore");
+    registerStore<HashPhoneStore>("HashPhoneStore");
+    registerStore<CachedPhoneStore<HashPhoneStore>>("Cached<HashPhoneStore>");
+    registerPrefixSearch();
+    return bench::run(argc, argv, "phonebook");
+}
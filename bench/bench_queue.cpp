@@ -0,0 +1,218 @@
+// Queue, SpscRingBuffer and MpmcQueue (10-data-structures/04-queue)
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "harness.h"
+#include "../10-data-structures/04-queue/queues.h"
+
+namespace
+{
+
+const std::size_t kRingCapacity = 4096;
+const std::size_t kPairs = 100000;
+const std::size_t kHandOffItems = 1000000;
+
+using Ring = SpscRingBuffer<int, kRingCapacity>;
+using Mpmc = MpmcQueue<int, kRingCapacity>;
+
+/*
+ * Single thread. Fill then drain size() values (a BFS frontier), and a queue
+ * held at depth size() where every step enqueues one value and dequeues one
+ * (a work queue in steady state). The ring buffers are bounded, so their
+ * depths stay below the capacity.
+ */
+void registerSingleThread()
+{
+    bench::add("Queue/enqueue_then_dequeue_all", {16, 1024, 1000000},
+               [](bench::State& state)
+               {
+                   Queue queue(false);
+                   for (std::size_t i = 0; i < state.size(); i++)
+                       queue.enqueue(static_cast<int>(i));
+                   long long sum = 0;
+                   while (!queue.isEmpty())
+                   {
+                       sum += queue.front();
+                       queue.dequeue();
+                   }
+                   bench::keep(sum);
+                   state.setItems(2 * state.size());
+               });
+    bench::addFixture("Queue/enqueue_dequeue_at_depth", {16, 1024, 1000000},
+                      [](std::size_t depth)
+                      {
+                          auto queue = std::make_shared<Queue>(false);
+                          for (std::size_t i = 0; i < depth; i++)
+                              queue->enqueue(static_cast<int>(i));
+                          return [queue](bench::State& state)
+                          {
+                              long long sum = 0;
+                              for (std::size_t i = 0; i < kPairs; i++)
+                              {
+                                  queue->enqueue(static_cast<int>(i));
+                                  sum += queue->front();
+                                  queue->dequeue();
+                              }
+                              bench::keep(sum);
+                              state.setItems(2 * kPairs);
+                          };
+                      });
+    bench::addFixture("SpscRingBuffer/enqueue_dequeue_at_depth", {16, 1024, 4000},
+                      [](std::size_t depth)
+                      {
+                          auto ring = std::make_shared<Ring>();
+                          for (std::size_t i = 0; i < depth; i++)
+                              ring->try_enqueue(static_cast<int>(i));
+                          return [ring](bench::State& state)
+                          {
+                              long long sum = 0;
+                              int value = 0;
+                              for (std::size_t i = 0; i < kPairs; i++)
+                              {
+                                  ring->try_enqueue(static_cast<int>(i));
+                                  ring->try_dequeue(value);
+                                  sum += value;
+                              }
+                              bench::keep(sum);
+                              state.setItems(2 * kPairs);
+                          };
+                      });
+    bench::addFixture("MpmcQueue/push_pop_at_depth", {16, 1024, 4000},
+                      [](std::size_t depth)
+                      {
+                          auto queue = std::make_shared<Mpmc>();
+                          for (std::size_t i = 0; i < depth; i++)
+                              queue->try_push(static_cast<int>(i));
+                          return [queue](bench::State& state)
+                          {
+                              long long sum = 0;
+                              int value = 0;
+                              for (std::size_t i = 0; i < kPairs; i++)
+                              {
+                                  queue->try_push(static_cast<int>(i));
+                                  queue->try_pop(value);
+                                  sum += value;
+                              }
+                              bench::keep(sum);
+                              state.setItems(2 * kPairs);
+                          };
+                      });
+}
+
+/*
+ * One producer thread hands size() values to one consumer thread, the
+ * pattern the ring buffer exists for; the linked Queue needs a mutex.
+ */
+void registerHandOff()
+{
+    const std::vector<std::size_t> items = {100000, kHandOffItems};
+    bench::add("Queue+mutex/producer_to_consumer", items,
+               [](bench::State& state)
+               {
+                   const std::size_t n = state.size();
+                   Queue queue(false);
+                   std::mutex lock;
+                   long long sum = 0;
+                   std::thread consumer(
+                       [&]
+                       {
+                           for (std::size_t received = 0; received < n;)
+                           {
+                               std::lock_guard<std::mutex> guard(lock);
+                               if (queue.isEmpty()) continue;
+                               sum += queue.front();
+                               queue.dequeue();
+                               received++;
+                           }
+                       });
+                   for (std::size_t i = 0; i < n; i++)
+                   {
+                       std::lock_guard<std::mutex> guard(lock);
+                       queue.enqueue(static_cast<int>(i));
+                   }
+                   consumer.join();
+                   bench::keep(sum);
+               });
+    bench::add("SpscRingBuffer/producer_to_consumer", items,
+               [](bench::State& state)
+               {
+                   const std::size_t n = state.size();
+                   auto ring = std::make_unique<Ring>();
+                   long long sum = 0;
+                   std::thread consumer(
+                       [&]
+                       {
+                           int value;
+                           for (std::size_t received = 0; received < n;)
+                           {
+                               if (ring->try_dequeue(value))
+                               {
+                                   sum += value;
+                                   received++;
+                               }
+                               else
+                                   std::this_thread::yield();
+                           }
+                       });
+                   for (std::size_t i = 0; i < n;)
+                   {
+                       if (ring->try_enqueue(static_cast<int>(i)))
+                           i++;
+                       else
+                           std::this_thread::yield();
+                   }
+                   consumer.join();
+                   bench::keep(sum);
+               });
+}
+
+// size() producers and size() consumers share one queue, kHandOffItems values in total
+void registerShared()
+{
+    const std::vector<std::size_t> threads = {1, 2, 4};
+    bench::add("MpmcQueue/producers_and_consumers_threads", threads,
+               [](bench::State& state)
+               {
+                   const std::size_t pairs = state.size();
+                   const std::size_t perThread = kHandOffItems / pairs;
+                   auto queue = std::make_unique<Mpmc>();
+                   std::atomic<long long> sum{0};
+                   std::vector<std::thread> pool;
+                   for (std::size_t c = 0; c < pairs; c++)
+                       pool.emplace_back(
+                           [&]
+                           {
+                               long long local = 0;
+                               int value;
+                               for (std::size_t i = 0; i < perThread; i++)
+                               {
+                                   queue->pop(value);
+                                   local += value;
+                               }
+                               sum += local;
+                           });
+                   for (std::size_t p = 0; p < pairs; p++)
+                       pool.emplace_back(
+                           [&]
+                           {
+                               for (std::size_t i = 0; i < perThread; i++)
+                                   queue->push(static_cast<int>(i));
+                           });
+                   for (std::thread& thread : pool) thread.join();
+                   bench::keep(sum.load());
+                   state.setItems(perThread * pairs);
+               });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    registerSingleThread();
+    registerHandOff();
+    registerShared();
+    return bench::run(argc, argv, "queue");
+}
@@ -0,0 +1,89 @@
+// Solution (11-dsa-sheet/01-arrays): largest, second largest and duplicate removal
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "harness.h"
+#include "../11-dsa-sheet/01-arrays/solution.h"
+
+namespace
+{
+
+const std::vector<std::size_t> kSizes = {1000, 100000, 10000000};
+const std::uint64_t kSeed = 23;
+
+// Distinct values in random order
+std::vector<int> randomInput(std::size_t n) { return bench::distinctKeys(n, kSeed); }
+
+// Sorted, each value repeated about four times (the removeDuplicates input)
+std::vector<int> sortedWithDuplicates(std::size_t n)
+{
+    std::vector<int> values(n);
+    for (std::size_t i = 0; i < n; i++) values[i] = static_cast<int>(i / 4);
+    return values;
+}
+
+/*
+ * Methods that only read the array share one input per size. The others
+ * sort or compact it in place, so each run gets a fresh copy made while
+ * timing is paused.
+ */
+template <typename Method>
+void registerReader(const std::string& name, std::vector<int> (*input)(std::size_t),
+                    Method method)
+{
+    bench::addFixture(name, kSizes,
+                      [input, method](std::size_t n)
+                      {
+                          auto values = std::make_shared<std::vector<int>>(input(n));
+                          return [values, method](bench::State&)
+                          {
+                              Solution solution;
+                              bench::keep(method(solution, *values));
+                          };
+                      });
+}
+
+template <typename Method>
+void registerWriter(const std::string& name, std::vector<int> (*input)(std::size_t),
+                    Method method)
+{
+    bench::addFixture(name, kSizes,
+                      [input, method](std::size_t n)
+                      {
+                          auto original = std::make_shared<std::vector<int>>(input(n));
+                          return [original, method](bench::State& state)
+                          {
+                              state.pauseTiming();
+                              std::vector<int> values = *original;
+                              state.resumeTiming();
+                              Solution solution;
+                              bench::keep(method(solution, values));
+                          };
+                      });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    registerReader("largestElement", randomInput,
+                   [](Solution& s, std::vector<int>& v) { return s.largestElement(v); });
+    registerReader("largestElementSimd", randomInput,
+                   [](Solution& s, std::vector<int>& v) { return s.largestElementSimd(v); });
+    registerWriter("secondLargestElementBrute", randomInput,
+                   [](Solution& s, std::vector<int>& v) { return s.secondLargestElementBrute(v); });
+    registerReader("secondLargestElementBetter", randomInput,
+                   [](Solution& s, std::vector<int>& v)
+                   { return s.secondLargestElementBetter(v); });
+    registerReader("secondLargestElementOptimal", randomInput,
+                   [](Solution& s, std::vector<int>& v)
+                   { return s.secondLargestElementOptimal(v); });
+    registerReader("secondLargestElementSimd", randomInput,
+                   [](Solution& s, std::vector<int>& v) { return s.secondLargestElementSimd(v); });
+    registerWriter("removeDuplicates", sortedWithDuplicates,
+                   [](Solution& s, std::vector<int>& v) { return s.removeDuplicates(v); });
+    registerWriter("removeDuplicatesSimd", sortedWithDuplicates,
+                   [](Solution& s, std::vector<int>& v) { return s.removeDuplicatesSimd(v); });
+    return bench::run(argc, argv, "solution");
+}
@@ -0,0 +1,146 @@
+// Stack and ConcurrentStack (10-data-structures/03-stack)
+
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "harness.h"
+#include "../10-data-structures/03-stack/stacks.h"
+
+namespace
+{
+
+const std::vector<std::size_t> kDepths = {16, 1024, 1000000};
+const std::size_t kPairs = 100000;
+const std::size_t kPairsPerThread = 200000;
+
+/*
+ * Burst: push size() values, then pop them all (an expression evaluator or
+ * a DFS). Steady: the stack holds size() values and every step pushes one
+ * and pops one, so the depth never changes (an undo buffer, a free list).
+ */
+void registerStack()
+{
+    bench::add("Stack/push_then_pop_all", kDepths,
+               [](bench::State& state)
+               {
+                   Stack stack(false);
+                   for (std::size_t i = 0; i < state.size(); i++) stack.push(static_cast<int>(i));
+                   long long sum = 0;
+                   while (!stack.isEmpty())
+                   {
+                       sum += stack.top();
+                       stack.pop();
+                   }
+                   bench::keep(sum);
+                   state.setItems(2 * state.size());
+               });
+    bench::addFixture("Stack/push_pop_at_depth", kDepths,
+                      [](std::size_t depth)
+                      {
+                          auto stack = std::make_shared<Stack>(false);
+                          for (std::size_t i = 0; i < depth; i++) stack->push(static_cast<int>(i));
+                          return [stack](bench::State& state)
+                          {
+                              for (std::size_t i = 0; i < kPairs; i++)
+                              {
+                                  stack->push(static_cast<int>(i));
+                                  stack->pop();
+                              }
+                              state.setItems(2 * kPairs);
+                          };
+                      });
+}
+
+void registerConcurrentStack()
+{
+    bench::add("ConcurrentStack/push_then_pop_all", kDepths,
+               [](bench::State& state)
+               {
+                   ConcurrentStack<int> stack;
+                   for (std::size_t i = 0; i < state.size(); i++) stack.push(static_cast<int>(i));
+                   long long sum = 0;
+                   int value;
+                   while (stack.try_pop(value)) sum += value;
+                   bench::keep(sum);
+                   state.pauseTiming();  // The destructor frees every node
+                   state.setItems(2 * state.size());
+               });
+    bench::addFixture("ConcurrentStack/push_pop_at_depth", kDepths,
+                      [](std::size_t depth)
+                      {
+                          auto stack = std::make_shared<ConcurrentStack<int>>();
+                          for (std::size_t i = 0; i < depth; i++) stack->push(static_cast<int>(i));
+                          return [stack](bench::State& state)
+                          {
+                              int value;
+                              for (std::size_t i = 0; i < kPairs; i++)
+                              {
+                                  stack->push(static_cast<int>(i));
+                                  stack->try_pop(value);
+                              }
+                              state.setItems(2 * kPairs);
+                          };
+                      });
+}
+
+/*
+ * size() threads each pushing and popping kPairsPerThread times on one shared
+ * stack. Stack is guarded by a mutex; ConcurrentStack needs nothing.
+ */
+template <typename Work>
+void runThreads(std::size_t threads, Work work)
+{
+    std::vector<std::thread> pool;
+    for (std::size_t t = 1; t < threads; t++) pool.emplace_back(work);
+    work();
+    for (std::thread& thread : pool) thread.join();
+}
+
+void registerContended()
+{
+    const std::vector<std::size_t> threads = {1, 2, 4};
+    bench::add("Stack+mutex/shared_push_pop_threads", threads,
+               [](bench::State& state)
+               {
+                   Stack stack(false);
+                   std::mutex lock;
+                   runThreads(state.size(),
+                              [&]
+                              {
+                                  for (std::size_t i = 0; i < kPairsPerThread; i++)
+                                  {
+                                      std::lock_guard<std::mutex> guard(lock);
+                                      stack.push(static_cast<int>(i));
+                                      stack.pop();
+                                  }
+                              });
+                   state.setItems(2 * kPairsPerThread * state.size());
+               });
+    bench::add("ConcurrentStack/shared_push_pop_threads", threads,
+               [](bench::State& state)
+               {
+                   ConcurrentStack<int> stack;
+                   runThreads(state.size(),
+                              [&]
+                              {
+                                  int value;
+                                  for (std::size_t i = 0; i < kPairsPerThread; i++)
+                                  {
+                                      stack.push(static_cast<int>(i));
+                                      stack.try_pop(value);
+                                  }
+                              });
+                   state.setItems(2 * kPairsPerThread * state.size());
+               });
+}
+
+}  // namespace
+
+int main(int argc, char** argv)
+{
+    registerStack();
+    registerConcurrentStack();
+    registerContended();
+    return bench::run(argc, argv, "stack");
+}
@@ -0,0 +1,604 @@
+#include "harness.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <thread>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifndef BENCH_BUILD_TYPE
+#define BENCH_BUILD_TYPE "unknown"
+#endif
+
+namespace bench
+{
+
+namespace
+{
+
+std::int64_t nowNanos()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+struct Entry
+{
+    std::string name;
+    std::vector<std::size_t> sizes;
+    Fixture fixture;
+};
+
+std::vector<Entry>& registry()
+{
+    static std::vector<Entry> entries;
+    return entries;
+}
+
+}  // namespace
+
+// ---- Hardware counters ----
+
+constexpr int kCounterCount = 4;
+const char* const kCounterNames[kCounterCount] = {"cycles", "instructions", "llc_misses",
+                                                  "branch_misses"};
+
+/*
+ * One perf_event group (cycles leads, the others follow it) counting this
+ * thread in user space. Each counter that fails to open is reported missing;
+ * if cycles fails, none are available.
+ */
+class Counters
+{
+   private:
+    int fds[kCounterCount] = {-1, -1, -1, -1};
+    int leader = -1;
+    int ids = 0;  // How many counters opened, in group read order
+    int order[kCounterCount] = {};
+
+   public:
+    Counters()
+    {
+#if defined(__linux__)
+        const std::uint64_t configs[kCounterCount] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES,
+            PERF_COUNT_HW_BRANCH_MISSES};
+        for (int c = 0; c < kCounterCount; c++)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = configs[c];
+            attr.disabled = leader == -1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                               PERF_FORMAT_TOTAL_TIME_RUNNING;
+            int fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0));
+            if (fd < 0)
+            {
+                if (leader == -1) return;
+                continue;
+            }
+            if (leader == -1) leader = fd;
+            fds[c] = fd;
+            order[ids++] = c;
+        }
+#endif
+    }
+
+    ~Counters()
+    {
+#if defined(__linux__)
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+#endif
+    }
+
+    Counters(const Counters&) = delete;
+    Counters& operator=(const Counters&) = delete;
+
+    bool available() const { return leader >= 0; }
+    bool has(int counter) const { return fds[counter] >= 0; }
+
+    void reset()
+    {
+#if defined(__linux__)
+        if (available()) ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void start()
+    {
+#if defined(__linux__)
+        if (available()) ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    void stop()
+    {
+#if defined(__linux__)
+        if (available()) ioctl(leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+    }
+
+    // Adds the counts since the last reset to totals, scaled up if the group was multiplexed
+    void accumulate(double* totals) const
+    {
+#if defined(__linux__)
+        if (!available()) return;
+        std::uint64_t buffer[3 + kCounterCount];
+        if (read(leader, buffer, sizeof(buffer)) < static_cast<ssize_t>(3 * sizeof(std::uint64_t)))
+            return;
+        double scale = buffer[2] > 0 ? static_cast<double>(buffer[1]) / buffer[2] : 1.0;
+        for (std::uint64_t i = 0; i < buffer[0] && i < static_cast<std::uint64_t>(ids); i++)
+            totals[order[i]] += buffer[3 + i] * scale;
+#else
+        (void)totals;
+#endif
+    }
+};
+
+void State::pauseTiming()
+{
+    if (paused) return;
+    if (counters) counters->stop();
+    pausedAt = nowNanos();
+    paused = true;
+}
+
+void State::resumeTiming()
+{
+    if (!paused) return;
+    pausedNanos += nowNanos() - pausedAt;
+    paused = false;
+    if (counters) counters->start();
+}
+
+void add(const std::string& name, std::vector<std::size_t> sizes, Function function)
+{
+    registry().push_back({name, std::move(sizes),
+                          [function](std::size_t) { return function; }});
+}
+
+void addFixture(const std::string& name, std::vector<std::size_t> sizes, Fixture fixture)
+{
+    registry().push_back({name, std::move(sizes), std::move(fixture)});
+}
+
+// ---- Runner ----
+
+struct Result
+{
+    std::string name;
+    std::size_t size = 0;
+    std::size_t runs = 0;
+    std::size_t itemsPerRun = 0;
+    double median = 0, min = 0, max = 0, spread = 0;  // ns per item; spread in percent
+    double counters[kCounterCount] = {};               // per item
+    bool hasCounter[kCounterCount] = {};
+};
+
+class Runner
+{
+   private:
+    Counters counters;
+    double minTime = 0.25;
+
+   public:
+    explicit Runner(double minTime) : minTime(minTime) {}
+
+    bool countersAvailable() const { return counters.available(); }
+
+    Result measure(const std::string& name, std::size_t size, const Function& function)
+    {
+        {
+            State warmUp(size, nullptr);
+            function(warmUp);
+        }
+        Result result;
+        result.name = name;
+        result.size = size;
+        std::vector<double> perItem;
+        double totals[kCounterCount] = {};
+        double measured = 0;
+        double totalItems = 0;
+        const double target = minTime * 1e9;
+        // At least minTime seconds, and three runs unless those would take four times as long
+        while (perItem.empty() || measured < target ||
+               (perItem.size() < 3 && measured < 4 * target))
+        {
+            State state(size, &counters);
+            counters.reset();
+            counters.start();
+            std::int64_t start = nowNanos();
+            function(state);
+            std::int64_t stop = nowNanos();
+            counters.stop();
+            if (state.paused) state.pausedNanos += stop - state.pausedAt;
+            counters.accumulate(totals);
+            double nanos = static_cast<double>(stop - start - state.pausedNanos);
+            std::size_t items = std::max<std::size_t>(state.items, 1);
+            perItem.push_back(nanos / items);
+            measured += std::max(nanos, 1.0);
+            totalItems += items;
+            result.itemsPerRun = items;
+        }
+        std::sort(perItem.begin(), perItem.end());
+        result.runs = perItem.size();
+        result.median = perItem[perItem.size() / 2];
+        result.min = perItem.front();
+        result.max = perItem.back();
+        // Median absolute deviation, relative to the median
+        std::vector<double> deviation;
+        for (double x : perItem) deviation.push_back(std::fabs(x - result.median));
+        std::nth_element(deviation.begin(), deviation.begin() + deviation.size() / 2,
+                         deviation.end());
+        result.spread =
+            result.median > 0 ? 100 * deviation[deviation.size() / 2] / result.median : 0;
+        for (int c = 0; c < kCounterCount; c++)
+        {
+            result.hasCounter[c] = counters.has(c);
+            result.counters[c] = totals[c] / totalItems;
+        }
+        return result;
+    }
+};
+
+namespace
+{
+
+std::string jsonEscape(const std::string& text)
+{
+    std::string out;
+    for (char c : text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char code[8];
+            std::snprintf(code, sizeof(code), "\\u%04x", c);
+            out += code;
+        }
+        else
+            out += c;
+    }
+    return out;
+}
+
+std::string compilerName()
+{
+#if defined(__clang__)
+    return std::string("Clang ") + __clang_version__;
+#elif defined(__GNUC__)
+    return std::string("GCC ") + __VERSION__;
+#elif defined(_MSC_VER)
+    return "MSVC " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string cpuName()
+{
+    std::ifstream cpuinfo("/proc/cpuinfo");
+    std::string line;
+    while (std::getline(cpuinfo, line))
+        if (line.compare(0, 10, "model name") == 0)
+        {
+            std::size_t colon = line.find(':');
+            if (colon != std::string::npos)
+                return line.substr(line.find_first_not_of(' ', colon + 1));
+        }
+    return "unknown";
+}
+
+std::string utcNow()
+{
+    std::time_t now = std::time(nullptr);
+    char text[32];
+    std::strftime(text, sizeof(text), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return text;
+}
+
+// Accepts 1000, 10k, 2M
+std::size_t parseSize(const std::string& text)
+{
+    std::size_t used = 0;
+    double value = std::stod(text, &used);
+    std::string suffix = text.substr(used);
+    if (suffix == "k" || suffix == "K")
+        value *= 1e3;
+    else if (suffix == "m" || suffix == "M")
+        value *= 1e6;
+    else if (!suffix.empty())
+        throw std::invalid_argument("bad size: " + text);
+    if (value < 1) throw std::invalid_argument("bad size: " + text);
+    return static_cast<std::size_t>(value);
+}
+
+std::vector<std::size_t> parseSizes(const std::string& list)
+{
+    std::vector<std::size_t> sizes;
+    std::size_t start = 0;
+    while (start <= list.size())
+    {
+        std::size_t comma = std::min(list.find(',', start), list.size());
+        if (comma > start) sizes.push_back(parseSize(list.substr(start, comma - start)));
+        start = comma + 1;
+    }
+    return sizes;
+}
+
+std::string key(const std::string& name, std::size_t size)
+{
+    return name + "@" + std::to_string(size);
+}
+
+// Median ns per item of every benchmark in a file written by writeJson (one result per line)
+std::map<std::string, double> readBaseline(const std::string& path, std::string& suite)
+{
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot read baseline " + path);
+    std::map<std::string, double> medians;
+    std::string line;
+    auto field = [&line](const char* label) -> std::size_t
+    {
+        std::size_t at = line.find(label);
+        return at == std::string::npos ? at : at + std::strlen(label);
+    };
+    while (std::getline(in, line))
+    {
+        std::size_t at = field("\"suite\": \"");
+        if (at != std::string::npos) suite = line.substr(at, line.find('"', at) - at);
+        std::size_t name = field("{\"name\": \"");
+        std::size_t size = field("\"size\": ");
+        std::size_t median = field("\"median_ns_per_item\": ");
+        if (name == std::string::npos || size == std::string::npos || median == std::string::npos)
+            continue;
+        std::string text;
+        for (std::size_t i = name; i < line.size() && line[i] != '"'; i++)
+        {
+            if (line[i] == '\\' && i + 1 < line.size()) i++;
+            text += line[i];
+        }
+        medians[key(text, std::stoull(line.substr(size)))] = std::stod(line.substr(median));
+    }
+    return medians;
+}
+
+void writeJson(const std::string& path, const std::string& suite,
+               const std::vector<Result>& results, bool counters)
+{
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("cannot write " + path);
+    out << "{\n";
+    out << "  \"suite\": \"" << jsonEscape(suite) << "\",\n";
+    out << "  \"context\": {\"date\": \"" << utcNow() << "\", \"compiler\": \""
+        << jsonEscape(compilerName()) << "\", \"build_type\": \"" << BENCH_BUILD_TYPE
+        << "\", \"cpu\": \"" << jsonEscape(cpuName())
+        << "\", \"threads\": " << std::thread::hardware_concurrency()
+        << ", \"hardware_counters\": " << (counters ? "true" : "false") << "},\n";
+    out << "  \"benchmarks\": [\n";
+    for (std::size_t i = 0; i < results.size(); i++)
+    {
+        const Result& r = results[i];
+        char numbers[512];
+        std::snprintf(numbers, sizeof(numbers),
+                      "\"size\": %zu, \"runs\": %zu, \"items_per_run\": %zu, "
+                      "\"median_ns_per_item\": %.6g, \"min_ns_per_item\": %.6g, "
+                      "\"max_ns_per_item\": %.6g, \"spread_percent\": %.3g, "
+                      "\"items_per_second\": %.6g",
+                      r.size, r.runs, r.itemsPerRun, r.median, r.min, r.max, r.spread,
+                      r.median > 0 ? 1e9 / r.median : 0.0);
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\", " << numbers;
+        for (int c = 0; c < kCounterCount; c++)
+            if (counters && r.hasCounter[c])
+                out << ", \"" << kCounterNames[c] << "_per_item\": " << r.counters[c];
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+}  // namespace
+
+int run(int argc, char** argv, const std::string& suite)
+{
+    std::string filter, jsonPath, baselinePath;
+    std::vector<std::size_t> sizes;
+    double minTime = 0.25, threshold = 10;
+    bool list = false;
+    try
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::string arg = argv[i];
+            auto value = [&arg](const char* option) -> const char*
+            {
+                std::size_t length = std::strlen(option);
+                return arg.compare(0, length, option) == 0 ? arg.c_str() + length : nullptr;
+            };
+            if (const char* v = value("--filter="))
+                filter = v;
+            else if (const char* v = value("--sizes="))
+                sizes = parseSizes(v);
+            else if (const char* v = value("--min-time="))
+                minTime = std::stod(v);
+            else if (const char* v = value("--json="))
+                jsonPath = v;
+            else if (const char* v = value("--baseline="))
+                baselinePath = v;
+            else if (const char* v = value("--threshold="))
+                threshold = std::stod(v);
+            else if (arg == "--list")
+                list = true;
+            else
+                throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::fprintf(stderr, "%s: %s\n", suite.c_str(), e.what());
+        std::fprintf(stderr,
+                     "options: --filter=<text> --sizes=<n,...> --min-time=<sec> --json=<file> "
+                     "--baseline=<file> --threshold=<pct> --list\n");
+        return 2;
+    }
+
+    std::map<std::string, double> baseline;
+    if (!baselinePath.empty())
+    {
+        std::string baselineSuite;
+        try
+        {
+            baseline = readBaseline(baselinePath, baselineSuite);
+        }
+        catch (const std::exception& e)
+        {
+            std::fprintf(stderr, "%s: %s\n", suite.c_str(), e.what());
+            return 2;
+        }
+        if (baselineSuite != suite)
+            std::fprintf(stderr, "%s: warning: baseline is from suite \"%s\"\n", suite.c_str(),
+                         baselineSuite.c_str());
+    }
+
+    Runner runner(minTime);
+    std::printf("%s (%s build, %s, hardware counters %s)\n", suite.c_str(), BENCH_BUILD_TYPE,
+                compilerName().c_str(), runner.countersAvailable() ? "on" : "unavailable");
+    std::printf("%-44s %9s %11s %6s %10s %8s %8s %5s %8s %8s%s\n", "benchmark", "size",
+                "ns/item", "+/-%", "Mitems/s", "cycles", "instr", "IPC", "llc-miss", "br-miss",
+                baseline.empty() ? "" : "   change");
+
+    std::vector<Result> results;
+    std::vector<std::string> regressions;
+    for (const Entry& entry : registry())
+    {
+        if (entry.name.find(filter) == std::string::npos) continue;
+        for (std::size_t size : sizes.empty() ? entry.sizes : sizes)
+        {
+            if (list)
+            {
+                std::printf("%s %zu\n", entry.name.c_str(), size);
+                continue;
+            }
+            Result r = runner.measure(entry.name, size, entry.fixture(size));
+            results.push_back(r);
+
+            char counters[96] = "";
+            if (runner.countersAvailable())
+            {
+                auto show = [&r](int c, char* out, const char* format)
+                {
+                    if (r.hasCounter[c])
+                        std::snprintf(out, 16, format, r.counters[c]);
+                    else
+                        std::snprintf(out, 16, "%s", "-");
+                };
+                char cycles[16], instructions[16], llc[16], branches[16], ipc[16] = "-";
+                show(0, cycles, "%.1f");
+                show(1, instructions, "%.1f");
+                show(2, llc, "%.3f");
+                show(3, branches, "%.3f");
+                if (r.hasCounter[1] && r.counters[0] > 0)
+                    std::snprintf(ipc, sizeof(ipc), "%.2f", r.counters[1] / r.counters[0]);
+                std::snprintf(counters, sizeof(counters), "%8s %8s %5s %8s %8s", cycles,
+                              instructions, ipc, llc, branches);
+            }
+            std::string change;
+            auto old = baseline.find(key(r.name, r.size));
+            if (old != baseline.end() && old->second > 0)
+            {
+                double percent = 100 * (r.median - old->second) / old->second;
+                char text[32];
+                std::snprintf(text, sizeof(text), "   %+6.1f%%", percent);
+                change = text;
+                if (percent > threshold) regressions.push_back(key(r.name, r.size));
+            }
+            std::printf("%-44s %9zu %11.3f %6.1f %10.3f %s%s\n", r.name.c_str(), r.size, r.median,
+                        r.spread, r.median > 0 ? 1e3 / r.median : 0.0, counters, change.c_str());
+            std::fflush(stdout);
+        }
+    }
+
+    if (!jsonPath.empty() && !list)
+    {
+        try
+        {
+            writeJson(jsonPath, suite, results, runner.countersAvailable());
+        }
+        catch (const std::exception& e)
+        {
+            std::fprintf(stderr, "%s: %s\n", suite.c_str(), e.what());
+            return 2;
+        }
+    }
+    if (!regressions.empty())
+    {
+        std::printf("%zu regression(s) over %.1f%%:\n", regressions.size(), threshold);
+        for (const std::string& name : regressions) std::printf("  %s\n", name.c_str());
+        return 1;
+    }
+    return 0;
+}
+
+// ---- Workload helpers ----
+
+std::vector<int> distinctKeys(std::size_t n, std::uint64_t seed)
+{
+    // i -> (i + seed) * odd is a bijection modulo 2^31, so the keys are distinct
+    std::vector<int> keys(n);
+    for (std::size_t i = 0; i < n; i++)
+        keys[i] = static_cast<int>(((i + seed) * 2654435761u) & 0x7FFFFFFF);
+    return keys;
+}
+
+std::vector<std::size_t> zipfIndices(std::size_t count, std::size_t n, double s,
+                                     std::uint64_t seed)
+{
+    std::vector<double> cumulative(n);
+    double sum = 0;
+    for (std::size_t i = 0; i < n; i++)
+    {
+        sum += 1 / std::pow(static_cast<double>(i + 1), s);
+        cumulative[i] = sum;
+    }
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> uniform(0, sum);
+    std::vector<std::size_t> indices(count);
+    for (std::size_t& index : indices)
+    {
+        auto at = std::lower_bound(cumulative.begin(), cumulative.end(), uniform(rng));
+        index = std::min<std::size_t>(at - cumulative.begin(), n - 1);
+    }
+    return indices;
+}
+
+std::vector<std::size_t> uniformIndices(std::size_t count, std::size_t n, std::uint64_t seed)
+{
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<std::size_t> uniform(0, n - 1);
+    std::vector<std::size_t> indices(count);
+    for (std::size_t& index : indices) index = uniform(rng);
+    return indices;
+}
+
+}  // namespace bench
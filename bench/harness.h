@@ -0,0 +1,102 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/*
+ * Minimal microbenchmark harness for the bench/ suite (no external
+ * dependencies).
+ *
+ * A benchmark is a function called once per run, with the size it is
+ * measured at in State::size(). The runner repeats it until at least
+ * --min-time seconds have been measured, and reports the median, min and max
+ * time per item over the runs. An item is whatever one run processes n of
+ * (inserts, lookups, bytes...); the default is size(). Setup that must not
+ * be measured goes between pauseTiming() and resumeTiming(), or into a
+ * fixture: a factory that builds the data once per size and returns the
+ * function to time.
+ *
+ * On Linux the runner also counts cycles, instructions, last-level cache
+ * misses and branch mispredictions per item (perf_event_open, counting in
+ * user space only). Where the kernel does not allow it, those fields are
+ * left out.
+ *
+ * Command line of every bench_* program:
+ *   --filter=<text>     only benchmarks whose name contains text
+ *   --sizes=<n,n,...>   replace every benchmark's sizes
+ *   --min-time=<sec>    measured time per benchmark and size (default 0.25)
+ *   --json=<file>       also write the results as JSON
+ *   --baseline=<file>   compare with an earlier --json file of the same suite
+ *   --threshold=<pct>   with --baseline: exit with status 1 when a median is
+ *                       that much slower (default 10)
+ *   --list              print the benchmark names and sizes, run nothing
+ */
+
+namespace bench
+{
+
+class Counters;
+class Runner;
+
+class State
+{
+   private:
+    std::size_t n;
+    std::size_t items;
+    bool paused = false;
+    std::int64_t pausedAt = 0;
+    std::int64_t pausedNanos = 0;
+    Counters* counters;
+
+    friend class Runner;
+    State(std::size_t n, Counters* counters) : n(n), items(n), counters(counters) {}
+
+   public:
+    std::size_t size() const { return n; }
+
+    // Items this run processed, for the per-item figures (default: size())
+    void setItems(std::size_t count) { items = count; }
+
+    // Excludes what runs until resumeTiming() from the time and the counters
+    void pauseTiming();
+    void resumeTiming();
+};
+
+using Function = std::function<void(State&)>;
+using Fixture = std::function<Function(std::size_t size)>;
+
+void add(const std::string& name, std::vector<std::size_t> sizes, Function function);
+void addFixture(const std::string& name, std::vector<std::size_t> sizes, Fixture fixture);
+
+// Parses the command line above, runs every registered benchmark and prints a table
+int run(int argc, char** argv, const std::string& suite);
+
+// Keeps the compiler from dropping a computation whose result is otherwise unused
+template <typename T>
+inline void keep(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// ---- Workload helpers ----
+
+// n distinct non-negative ints in random order
+std::vector<int> distinctKeys(std::size_t n, std::uint64_t seed);
+
+// count indices in [0, n) drawn from a Zipf distribution with exponent s: index 0
+// is the most popular, index i is drawn about (i + 1)^-s times as often
+std::vector<std::size_t> zipfIndices(std::size_t count, std::size_t n, double s,
+                                     std::uint64_t seed);
+
+// count indices in [0, n), uniformly
+std::vector<std::size_t> uniformIndices(std::size_t count, std::size_t n, std::uint64_t seed);
+
+}  // namespace bench
+
+#endif